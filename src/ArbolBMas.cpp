@@ -0,0 +1,234 @@
+#include "ArbolBMas.h"
+#include <algorithm>
+
+const int ArbolBMas::ANCHO;
+
+ArbolBMas::ArbolBMas() : _tam(0) {
+    _raiz = _nuevoNodo(true);
+    _primera = _raiz;
+    _ultima = _raiz;
+}
+
+int ArbolBMas::tam() const {
+    return _tam;
+}
+
+const vector<int> *ArbolBMas::buscar(int clave) const {
+    const Nodo &hoja = _nodos[_hoja(clave)];
+    const int *pos = std::lower_bound(hoja.claves, hoja.claves + hoja.cant, clave);
+    if (pos == hoja.claves + hoja.cant or *pos != clave) {
+        return NULL;
+    }
+    return &_significados[hoja.hijos[pos - hoja.claves]];
+}
+
+vector<int> &ArbolBMas::operator[](int clave) {
+    int separador;
+    int nuevoNodo;
+    int significado = _insertar(_raiz, clave, separador, nuevoNodo);
+    if (nuevoNodo != -1) {
+        // Se partió la raíz: el árbol crece un nivel
+        int raiz = _nuevoNodo(false);
+        Nodo &n = _nodos[raiz];
+        n.cant = 1;
+        n.claves[0] = separador;
+        n.hijos[0] = _raiz;
+        n.hijos[1] = nuevoNodo;
+        _raiz = raiz;
+    }
+    return _significados[significado];
+}
+
+ArbolBMas::const_iterador ArbolBMas::begin() const {
+    if (_tam == 0) {
+        return end();
+    }
+    return const_iterador(this, _primera, 0);
+}
+
+ArbolBMas::const_iterador ArbolBMas::end() const {
+    return const_iterador(this, -1, 0);
+}
+
+ArbolBMas::const_iterador ArbolBMas::lower_bound(int clave) const {
+    int hoja = _hoja(clave);
+    const Nodo &n = _nodos[hoja];
+    int pos = std::lower_bound(n.claves, n.claves + n.cant, clave) - n.claves;
+    if (pos == n.cant) {
+        return n.siguiente == -1 ? end() : const_iterador(this, n.siguiente, 0);
+    }
+    return const_iterador(this, hoja, pos);
+}
+
+ArbolBMas::const_iterador ArbolBMas::upper_bound(int clave) const {
+    int hoja = _hoja(clave);
+    const Nodo &n = _nodos[hoja];
+    int pos = std::upper_bound(n.claves, n.claves + n.cant, clave) - n.claves;
+    if (pos == n.cant) {
+        return n.siguiente == -1 ? end() : const_iterador(this, n.siguiente, 0);
+    }
+    return const_iterador(this, hoja, pos);
+}
+
+int ArbolBMas::_hoja(int clave) const {
+    int nodo = _raiz;
+    while (not _nodos[nodo].hoja) {
+        const Nodo &n = _nodos[nodo];
+        nodo = n.hijos[std::upper_bound(n.claves, n.claves + n.cant, clave) -
+                       n.claves];
+    }
+    return nodo;
+}
+
+int ArbolBMas::_insertar(int nodo, int clave, int &separador,
+                         int &nuevoNodo) {
+    nuevoNodo = -1;
+    // _nodos puede crecer durante la inserción, así que los nodos se acceden
+    // por posición y no se guardan referencias
+    if (_nodos[nodo].hoja) {
+        Nodo &n = _nodos[nodo];
+        int pos = std::lower_bound(n.claves, n.claves + n.cant, clave) - n.claves;
+        if (pos < n.cant and n.claves[pos] == clave) {
+            return n.hijos[pos];
+        }
+        int significado = _significados.size();
+        _significados.push_back(vector<int>());
+        _tam++;
+
+        int claves[ANCHO + 1];
+        int hijos[ANCHO + 1];
+        int cant = n.cant + 1;
+        copy(n.claves, n.claves + pos, claves);
+        copy(n.hijos, n.hijos + pos, hijos);
+        claves[pos] = clave;
+        hijos[pos] = significado;
+        copy(n.claves + pos, n.claves + n.cant, claves + pos + 1);
+        copy(n.hijos + pos, n.hijos + n.cant, hijos + pos + 1);
+        if (cant <= ANCHO) {
+            copy(claves, claves + cant, n.claves);
+            copy(hijos, hijos + cant, n.hijos);
+            n.cant = cant;
+            return significado;
+        }
+
+        // La hoja se parte en dos mitades enlazadas
+        int derecha = _nuevoNodo(true);
+        Nodo &izq = _nodos[nodo];
+        Nodo &der = _nodos[derecha];
+        int mitad = cant / 2;
+        izq.cant = mitad;
+        copy(claves, claves + mitad, izq.claves);
+        copy(hijos, hijos + mitad, izq.hijos);
+        der.cant = cant - mitad;
+        copy(claves + mitad, claves + cant, der.claves);
+        copy(hijos + mitad, hijos + cant, der.hijos);
+        der.siguiente = izq.siguiente;
+        der.anterior = nodo;
+        if (izq.siguiente != -1) {
+            _nodos[izq.siguiente].anterior = derecha;
+        } else {
+            _ultima = derecha;
+        }
+        izq.siguiente = derecha;
+        separador = der.claves[0];
+        nuevoNodo = derecha;
+        return significado;
+    }
+
+    int i;
+    {
+        const Nodo &n = _nodos[nodo];
+        i = std::upper_bound(n.claves, n.claves + n.cant, clave) - n.claves;
+    }
+    int separadorHijo;
+    int nuevoHijo;
+    int significado = _insertar(_nodos[nodo].hijos[i], clave, separadorHijo,
+                                nuevoHijo);
+    if (nuevoHijo == -1) {
+        return significado;
+    }
+
+    Nodo &n = _nodos[nodo];
+    int claves[ANCHO + 1];
+    int hijos[ANCHO + 2];
+    int cant = n.cant + 1;
+    copy(n.claves, n.claves + i, claves);
+    claves[i] = separadorHijo;
+    copy(n.claves + i, n.claves + n.cant, claves + i + 1);
+    copy(n.hijos, n.hijos + i + 1, hijos);
+    hijos[i + 1] = nuevoHijo;
+    copy(n.hijos + i + 1, n.hijos + n.cant + 1, hijos + i + 2);
+    if (cant <= ANCHO) {
+        copy(claves, claves + cant, n.claves);
+        copy(hijos, hijos + cant + 1, n.hijos);
+        n.cant = cant;
+        return significado;
+    }
+
+    // El nodo interno se parte y la clave del medio sube
+    int derecha = _nuevoNodo(false);
+    Nodo &izq = _nodos[nodo];
+    Nodo &der = _nodos[derecha];
+    int mitad = cant / 2;
+    izq.cant = mitad;
+    copy(claves, claves + mitad, izq.claves);
+    copy(hijos, hijos + mitad + 1, izq.hijos);
+    der.cant = cant - mitad - 1;
+    copy(claves + mitad + 1, claves + cant, der.claves);
+    copy(hijos + mitad + 1, hijos + cant + 1, der.hijos);
+    separador = claves[mitad];
+    nuevoNodo = derecha;
+    return significado;
+}
+
+int ArbolBMas::_nuevoNodo(bool hoja) {
+    Nodo n;
+    n.hoja = hoja;
+    n.cant = 0;
+    n.anterior = -1;
+    n.siguiente = -1;
+    _nodos.push_back(n);
+    return _nodos.size() - 1;
+}
+
+ArbolBMas::const_iterador::const_iterador(const ArbolBMas *arbol, int hoja,
+                                          int pos) :
+        arbol(arbol), hoja(hoja), pos(pos) {}
+
+int ArbolBMas::const_iterador::clave() const {
+    return arbol->_nodos[hoja].claves[pos];
+}
+
+const vector<int> &ArbolBMas::const_iterador::significado() const {
+    return arbol->_significados[arbol->_nodos[hoja].hijos[pos]];
+}
+
+ArbolBMas::const_iterador &ArbolBMas::const_iterador::operator++() {
+    pos++;
+    if (pos == arbol->_nodos[hoja].cant) {
+        hoja = arbol->_nodos[hoja].siguiente;
+        pos = 0;
+    }
+    return *this;
+}
+
+ArbolBMas::const_iterador &ArbolBMas::const_iterador::operator--() {
+    if (hoja == -1) {
+        hoja = arbol->_ultima;
+        pos = arbol->_nodos[hoja].cant - 1;
+    } else if (pos == 0) {
+        hoja = arbol->_nodos[hoja].anterior;
+        pos = arbol->_nodos[hoja].cant - 1;
+    } else {
+        pos--;
+    }
+    return *this;
+}
+
+bool ArbolBMas::const_iterador::operator==(const const_iterador &o_it) const {
+    return arbol == o_it.arbol and hoja == o_it.hoja and pos == o_it.pos;
+}
+
+bool ArbolBMas::const_iterador::operator!=(const const_iterador &o_it) const {
+    return not (*this == o_it);
+}
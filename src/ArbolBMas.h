@@ -0,0 +1,237 @@
+#ifndef ARBOLBMAS_H
+#define ARBOLBMAS_H
+
+#include <iterator>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Diccionario ordenado de nat en listas de ids, implementado como un
+ * árbol B+.
+ *
+ * Cada nodo guarda hasta ANCHO claves contiguas, así que buscar una clave
+ * recorre pocos niveles y lee pocas líneas de caché por nivel. Las claves
+ * están solo en las hojas, que están enlazadas en orden en ambos sentidos:
+ * un recorrido por rango baja una sola vez y después avanza de hoja en hoja.
+ *
+ * Los nodos y los significados se guardan en arreglos y se referencian por
+ * posición, así que el árbol se copia como un valor. Las claves no se
+ * borran: un significado puede quedar vacío.
+ *
+ * **se explica con** TAD Diccionario(nat, Secu(nat))
+ */
+class ArbolBMas {
+
+public:
+
+    /** @brief Cantidad máxima de claves por nodo. */
+    static const int ANCHO = 32;
+
+    class const_iterador;
+
+    /**
+     * @brief Inicializa un diccionario vacío.
+     *
+     * \complexity{\O(1)}
+     */
+    ArbolBMas();
+
+    /**
+     * @brief Cantidad de claves definidas.
+     *
+     * \complexity{\O(1)}
+     */
+    int tam() const;
+
+    /**
+     * @brief Significado de la clave, o NULL si no está definida.
+     *
+     * \complexity{\O(log(tam))}
+     */
+    const vector<int> *buscar(int clave) const;
+
+    /**
+     * @brief Significado de la clave. Si no estaba definida, la define con
+     * un significado vacío.
+     *
+     * La referencia vale hasta la próxima clave que se defina.
+     *
+     * \complexity{\O(log(tam))}
+     */
+    vector<int> &operator[](int clave);
+
+    /**
+     * @brief Iterador a la menor clave.
+     *
+     * \complexity{\O(log(tam))}
+     */
+    const_iterador begin() const;
+
+    /**
+     * @brief Iterador a la posición pasando-la-última clave.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador end() const;
+
+    /**
+     * @brief Iterador a la menor clave mayor o igual a \P{clave}, o end().
+     *
+     * \complexity{\O(log(tam))}
+     */
+    const_iterador lower_bound(int clave) const;
+
+    /**
+     * @brief Iterador a la menor clave mayor estricta a \P{clave}, o end().
+     *
+     * \complexity{\O(log(tam))}
+     */
+    const_iterador upper_bound(int clave) const;
+
+private:
+
+    /** @brief Nodo interno u hoja. */
+    struct Nodo {
+        /** @brief Define si el nodo es una hoja. */
+        bool hoja;
+        /** @brief Cantidad de claves del nodo. */
+        int cant;
+        /** @brief Claves, ordenadas de forma estrictamente creciente. */
+        int claves[ANCHO];
+        /**
+         * @brief En un nodo interno, posición de cada hijo en _nodos (cant + 1
+         * hijos); en una hoja, posición del significado de cada clave en
+         * _significados.
+         */
+        int hijos[ANCHO + 1];
+        /** @brief Hojas vecinas en el orden de las claves, o -1. */
+        int anterior;
+        int siguiente;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: arbolbmas \TO bool\n
+     * rep(a) \EQUIV
+     *  * _raiz es una posición válida de _nodos \LAND todas las hojas están a
+     *    la misma profundidad desde _raiz \LAND
+     *  * todo nodo que no es la raíz tiene al menos ANCHO / 2 claves \LAND
+     *    ninguno tiene más de ANCHO \LAND
+     *  * en un nodo interno, las claves del subárbol hijos[i] son menores a
+     *    claves[i] y las de hijos[i + 1] son mayores o iguales \LAND
+     *  * recorrer las hojas desde _primera siguiendo siguiente da todas las
+     *    claves en orden creciente, y anterior es el recorrido inverso \LAND
+     *  * _ultima es la hoja sin siguiente \LAND
+     *  * cada posición de _significados es hijo de exactamente una clave de
+     *    una hoja \LAND _tam = long(_significados)
+     *
+     * abs: arbolbmas \TO Diccionario(nat, Secu(nat))\n
+     * abs(a) \EQUIV d \| \FORALL (k : nat) def?(k, d) \IFF k es clave de una
+     *  hoja n \LAND (def?(k, d) \IMPLIES obtener(k, d) =
+     *  _significados[n.hijos[i]], con n.claves[i] = k)
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    vector<Nodo> _nodos;
+    vector<vector<int> > _significados;
+    int _raiz;
+    int _primera;
+    int _ultima;
+    int _tam;
+    /** @} */
+
+    /**
+     * @brief Hoja donde está o debería estar la clave.
+     *
+     * \complexity{\O(log(tam))}
+     */
+    int _hoja(int clave) const;
+
+    /**
+     * @brief Define la clave en el subárbol de \P{nodo} si no estaba y
+     * devuelve la posición de su significado. Si el nodo se parte, deja en
+     * \P{nuevoNodo} la mitad derecha y en \P{separador} su menor clave; si
+     * no, deja -1 en \P{nuevoNodo}.
+     *
+     * \complexity{\O(log(tam))}
+     */
+    int _insertar(int nodo, int clave, int &separador, int &nuevoNodo);
+
+    /**
+     * @brief Agrega un nodo vacío y devuelve su posición.
+     *
+     * \complexity{\O(1) amortizado}
+     */
+    int _nuevoNodo(bool hoja);
+};
+
+/**
+ * @brief Iterador bidireccional de las claves del árbol, en orden.
+ */
+class ArbolBMas::const_iterador {
+
+public:
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = int;
+    using difference_type = ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    /**
+     * @brief Clave apuntada.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    int clave() const;
+
+    /**
+     * @brief Significado de la clave apuntada.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    const vector<int> &significado() const;
+
+    /**
+     * @brief Avanza a la clave siguiente.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador &operator++();
+
+    /**
+     * @brief Retrocede a la clave anterior.
+     *
+     * \pre El iterador no debe apuntar a la menor clave.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador &operator--();
+
+    bool operator==(const const_iterador &o_it) const;
+
+    bool operator!=(const const_iterador &o_it) const;
+
+private:
+    friend class ArbolBMas;
+
+    const_iterador(const ArbolBMas *arbol, int hoja, int pos);
+
+    /** @brief Árbol recorrido. */
+    const ArbolBMas *arbol;
+
+    /** @brief Hoja apuntada, o -1 en pasando-el-último. */
+    int hoja;
+
+    /** @brief Posición de la clave apuntada dentro de la hoja. */
+    int pos;
+};
+
+#endif // ARBOLBMAS_H
@@ -0,0 +1,101 @@
+#include "ArenaRegistros.h"
+
+const int ArenaRegistros::TAM_GRUPO;
+
+ArenaRegistros::Grupo::Grupo(int primerId) :
+        primerId(primerId), siguiente(nullptr) {
+    registros.reserve(TAM_GRUPO);
+    borrados.reserve(TAM_GRUPO);
+}
+
+ArenaRegistros::ArenaRegistros() : _tam(0), _vivos(0) {}
+
+ArenaRegistros::ArenaRegistros(const ArenaRegistros &otro) : _tam(0), _vivos(0) {
+    *this = otro;
+}
+
+ArenaRegistros::ArenaRegistros(ArenaRegistros &&otro) :
+        _grupos(move(otro._grupos)), _tam(otro._tam), _vivos(otro._vivos) {
+    otro._grupos.clear();
+    otro._tam = 0;
+    otro._vivos = 0;
+}
+
+ArenaRegistros &ArenaRegistros::operator=(ArenaRegistros &&otro) {
+    if (this != &otro) {
+        _grupos = move(otro._grupos);
+        _tam = otro._tam;
+        _vivos = otro._vivos;
+        otro._grupos.clear();
+        otro._tam = 0;
+        otro._vivos = 0;
+    }
+    return *this;
+}
+
+ArenaRegistros &ArenaRegistros::operator=(const ArenaRegistros &otro) {
+    if (this == &otro) {
+        return *this;
+    }
+    _grupos.clear();
+    _tam = 0;
+    _vivos = 0;
+    // Los borrados también se copian, para conservar los ids
+    for (const Grupo *g = otro.primerGrupo(); g != nullptr; g = g->siguiente) {
+        for (size_t i = 0; i < g->registros.size(); ++i) {
+            int id = agregar(g->registros[i]);
+            if (g->borrados[i]) {
+                borrar(id);
+            }
+        }
+    }
+    return *this;
+}
+
+int ArenaRegistros::agregar(const Registro &r) {
+    if (_grupos.empty() or _grupos.back()->registros.size() == TAM_GRUPO) {
+        // Los grupos nunca se realocan: se encadena uno nuevo
+        unique_ptr<Grupo> nuevo(new Grupo(_tam));
+        if (not _grupos.empty()) {
+            _grupos.back()->siguiente = nuevo.get();
+        }
+        _grupos.push_back(move(nuevo));
+    }
+    _grupos.back()->registros.push_back(r);
+    _grupos.back()->borrados.push_back(false);
+    _vivos++;
+    return _tam++;
+}
+
+const Registro &ArenaRegistros::operator[](int id) const {
+    return _grupos[id / TAM_GRUPO]->registros[id % TAM_GRUPO];
+}
+
+void ArenaRegistros::reemplazar(int id, const Registro &r) {
+    _grupos[id / TAM_GRUPO]->registros[id % TAM_GRUPO] = r;
+}
+
+void ArenaRegistros::borrar(int id) {
+    _grupos[id / TAM_GRUPO]->borrados[id % TAM_GRUPO] = true;
+    _vivos--;
+}
+
+bool ArenaRegistros::borrado(int id) const {
+    return _grupos[id / TAM_GRUPO]->borrados[id % TAM_GRUPO];
+}
+
+int ArenaRegistros::vivos() const {
+    return _vivos;
+}
+
+const ArenaRegistros::Grupo *ArenaRegistros::grupo(int id) const {
+    return _grupos[id / TAM_GRUPO].get();
+}
+
+int ArenaRegistros::tam() const {
+    return _tam;
+}
+
+const ArenaRegistros::Grupo *ArenaRegistros::primerGrupo() const {
+    return _grupos.empty() ? nullptr : _grupos.front().get();
+}
@@ -0,0 +1,205 @@
+#ifndef ARENAREGISTROS_H
+#define ARENAREGISTROS_H
+
+#include <memory>
+#include <vector>
+#include "Registro.h"
+
+using namespace std;
+
+/**
+ * @brief Almacenamiento de los registros de una tabla en grupos contiguos.
+ *
+ * Los registros se guardan en orden de inserción en grupos de TAM_GRUPO
+ * registros contiguos en memoria. Los grupos solo crecen (no se realocan), por
+ * lo que la dirección de un registro no cambia mientras viva el arena, y
+ * recorrer los registros es recorrer cada grupo secuencialmente.
+ *
+ * Cada registro tiene un id: su posición en el orden de inserción. Borrar un
+ * registro solo lo marca como borrado, para que los ids y las direcciones de
+ * los demás no cambien.
+ *
+ * **se explica con** Secu(Registro)
+ */
+class ArenaRegistros {
+
+public:
+
+    /** @brief Cantidad de registros de cada grupo. */
+    static const int TAM_GRUPO = 1024;
+
+    /** @brief Grupo de hasta TAM_GRUPO registros contiguos. */
+    struct Grupo {
+        /**
+         * @brief Inicializa un grupo vacío, con lugar para TAM_GRUPO registros.
+         *
+         * \complexity{\O(1)}
+         */
+        Grupo(int primerId);
+
+        /** @brief Registros del grupo. Nunca supera TAM_GRUPO elementos. */
+        vector<Registro> registros;
+        /** @brief Indica, por posición, si el registro está borrado. */
+        vector<bool> borrados;
+        /** @brief Id del primer registro del grupo. */
+        int primerId;
+        /** @brief Grupo siguiente, o NULL si es el último. */
+        Grupo *siguiente;
+    };
+
+    /**
+     * @brief Inicializa un arena sin registros.
+     *
+     * \complexity{\O(1)}
+     */
+    ArenaRegistros();
+
+    /**
+     * @brief Constructor por copia. Copia todos los registros en grupos nuevos.
+     *
+     * \complexity{\O(n * copy(registro))}
+     */
+    ArenaRegistros(const ArenaRegistros &otro);
+
+    /**
+     * @brief Constructor por movimiento. Los grupos pasan a \P{this} sin
+     * cambiar de dirección y \P{otro} queda vacío.
+     *
+     * \complexity{\O(1)}
+     */
+    ArenaRegistros(ArenaRegistros &&otro);
+
+    /**
+     * @brief Asignación. Copia todos los registros en grupos nuevos.
+     *
+     * \complexity{\O(n * copy(registro))}
+     */
+    ArenaRegistros &operator=(const ArenaRegistros &otro);
+
+    /**
+     * @brief Asignación por movimiento. Los grupos pasan a \P{this} sin
+     * cambiar de dirección y \P{otro} queda vacío.
+     *
+     * \complexity{\O(n)}
+     */
+    ArenaRegistros &operator=(ArenaRegistros &&otro);
+
+    /**
+     * @brief Agrega un registro al final del arena.
+     *
+     * \pre a = \P{this}
+     * \post \P{this} = a \CDOT r \LAND \P{res} es el id del registro agregado
+     *
+     * \complexity{\O(copy(registro))}
+     */
+    int agregar(const Registro &r);
+
+    /**
+     * @brief Registro con el id parámetro.
+     *
+     * Se devuelve por referencia no modificable.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this})
+     * \post \P{res} = \P{this}[id]
+     *
+     * \complexity{\O(1)}
+     */
+    const Registro &operator[](int id) const;
+
+    /**
+     * @brief Reemplaza el registro con el id parámetro, sin moverlo.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this}) \LAND \LNOT borrado(id)
+     * \post \P{this}[id] = r
+     *
+     * \complexity{\O(copy(registro))}
+     */
+    void reemplazar(int id, const Registro &r);
+
+    /**
+     * @brief Marca como borrado el registro con el id parámetro.
+     *
+     * El registro sigue en su lugar hasta que se compacte la tabla.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this}) \LAND \LNOT borrado(id)
+     * \post borrado(id)
+     *
+     * \complexity{\O(1)}
+     */
+    void borrar(int id);
+
+    /**
+     * @brief Indica si el registro con el id parámetro está borrado.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this})
+     *
+     * \complexity{\O(1)}
+     */
+    bool borrado(int id) const;
+
+    /**
+     * @brief Cantidad de registros no borrados.
+     *
+     * \complexity{\O(1)}
+     */
+    int vivos() const;
+
+    /**
+     * @brief Cantidad de registros del arena, contando los borrados.
+     *
+     * \complexity{\O(1)}
+     */
+    int tam() const;
+
+    /**
+     * @brief Grupo que contiene al registro con el id parámetro.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this})
+     *
+     * \complexity{\O(1)}
+     */
+    const Grupo *grupo(int id) const;
+
+    /**
+     * @brief Primer grupo, o NULL si el arena está vacío.
+     *
+     * Los grupos se recorren con Grupo::siguiente.
+     *
+     * \complexity{\O(1)}
+     */
+    const Grupo *primerGrupo() const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: arenaregistros \TO bool\n
+     * rep(a) \EQUIV
+     *  * \FORALL (i : nat) 0 \LEQ i \LT long(_grupos) \IMPLIES (
+     *    * _grupos[i]->primerId = i * TAM_GRUPO \LAND
+     *    * (i \LT long(_grupos) - 1 \IMPLIES
+     *        long(_grupos[i]->registros) = TAM_GRUPO \LAND
+     *        _grupos[i]->siguiente = _grupos[i + 1]) \LAND
+     *    * (i = long(_grupos) - 1 \IMPLIES
+     *        0 \LT long(_grupos[i]->registros) \LEQ TAM_GRUPO \LAND
+     *        _grupos[i]->siguiente = NULL) \LAND
+     *    * long(_grupos[i]->borrados) = long(_grupos[i]->registros)
+     *  * ) \LAND
+     *  * _tam = suma de long(_grupos[i]->registros) \LAND
+     *  * _vivos = cantidad de posiciones no borradas de los grupos
+     *
+     * abs: arenaregistros \TO Secu(Registro)\n
+     * abs(a) \EQUIV la concatenación de _grupos[i]->registros
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    /** @brief Grupos de registros, en orden. */
+    vector<unique_ptr<Grupo> > _grupos;
+    /** @brief Cantidad total de registros. */
+    int _tam;
+    /** @brief Cantidad de registros no borrados. */
+    int _vivos;
+    /** @} */
+};
+
+#endif // ARENAREGISTROS_H
@@ -2,22 +2,329 @@
 #include <list>
 #include <tuple>
 #include <algorithm>
+#include <limits>
+#include <map>
+
+const int BaseDeDatos::MAX_DISTINTOS_BITMAP;
+const int BaseDeDatos::MIN_BORRADOS_COMPACTAR;
+constexpr double BaseDeDatos::SELECTIVIDAD_MAXIMA;
 
 BaseDeDatos::BaseDeDatos(){};
 
+BaseDeDatos::~BaseDeDatos() {
+    for (Construccion &c : _construcciones) {
+        c.hilo.join();
+    }
+    for (Compactacion &c : _compactaciones) {
+        c.hilo.join();
+    }
+}
+
 void BaseDeDatos::crearTabla(const string &nombre, 
                              const linear_set<string> &claves,
                              const vector<string> &campos,
-                             const vector<Dato> &tipos) {
-    _nombresYtablas.insert(make_pair(nombre, Tabla(claves, campos, tipos)));
+                             const vector<Dato> &tipos,
+                             Tabla::Almacenamiento almacenamiento,
+                             const Particionado &particionado) {
+    _nombresYtablas.insert(make_pair(nombre, Tabla(claves, campos, tipos,
+                                                   almacenamiento,
+                                                   particionado)));
     _indices.insert(make_pair(nombre, string_map<Indice>()));
 }
 
 void BaseDeDatos::agregarRegistro(const Registro &r, const string &nombre) {
     Tabla &t = _nombresYtablas.at(nombre);
-    const_it_reg rIt = t.agregarRegistro(r);
+    _instalarCompactacion(nombre, false);
+    _instalarIndices(nombre, false);
+    int id;
+    {
+        vector<unique_lock<mutex> > cerrojos = _bloquearConstrucciones(nombre);
+        id = t.agregarRegistro(r).id();
+    }
+    for (auto it = _indices.at(nombre).begin(); it != _indices.at(nombre).end(); ++it) {
+        it->second.agregarRegistro(id);
+    }
+    _anotarCambios(nombre, vector<int>(1, id), true);
+}
+
+bool BaseDeDatos::agregarRegistros(const vector<Registro> &regs,
+                                   const string &nombre) {
+    Tabla &t = _nombresYtablas.at(nombre);
+    const linear_set<string> campos = t.campos();
+    for (const Registro &r : regs) {
+        if (not (r.campos() == campos and _mismos_tipos(r, t))) {
+            return false;
+        }
+    }
+    if (not t.clavesLibres(regs)) {
+        return false;
+    }
+    _instalarCompactacion(nombre, false);
+    _instalarIndices(nombre, false);
+    int desde = t.cant_registros() + t.cant_borrados();
+    {
+        vector<unique_lock<mutex> > cerrojos = _bloquearConstrucciones(nombre);
+        t.agregarRegistros(regs);
+    }
+    int hasta = t.cant_registros() + t.cant_borrados();
+    for (auto it = _indices.at(nombre).begin(); it != _indices.at(nombre).end(); ++it) {
+        it->second.agregarRegistros(desde, hasta);
+    }
+    if (not _construcciones.empty() or not _compactaciones.empty()) {
+        vector<int> agregados;
+        for (int id = desde; id < hasta; ++id) {
+            agregados.push_back(id);
+        }
+        _anotarCambios(nombre, agregados, true);
+    }
+    return true;
+}
+
+int BaseDeDatos::borrarRegistros(const Criterio &c, const string &nombre) {
+    Tabla &t = _nombresYtablas.at(nombre);
+    _instalarCompactacion(nombre, false);
+    _instalarIndices(nombre, false);
+    vector<int> ids = _idsQueCumplen(c, nombre);
     for (auto it = _indices.at(nombre).begin(); it != _indices.at(nombre).end(); ++it) {
-        it->second.agregarRegistro(rIt);
+        for (int id : ids) {
+            it->second.borrarRegistro(id);
+        }
+    }
+    _anotarCambios(nombre, ids, false);
+    {
+        vector<unique_lock<mutex> > cerrojos = _bloquearConstrucciones(nombre);
+        t.borrarRegistros(ids);
+    }
+    _compactarSiConviene(nombre);
+    return ids.size();
+}
+
+void BaseDeDatos::compactar(const string &nombre) {
+    _instalarCompactacion(nombre, true);
+    Tabla &t = _nombresYtablas.at(nombre);
+    if (t.cant_borrados() == 0) {
+        return;
+    }
+    // Compactar cambia los ids, así que los índices se rearman. Los que se
+    // construyen en segundo plano usan los ids viejos: se terminan antes
+    _instalarIndices(nombre, true);
+    t.compactar();
+    _reconstruirIndices(nombre);
+}
+
+bool BaseDeDatos::actualizarRegistros(const Criterio &c,
+                                      const Registro &cambios,
+                                      const string &nombre) {
+    Tabla &t = _nombresYtablas.at(nombre);
+    for (const string &campo : cambios.campos()) {
+        if (t.schema()->ordinal(campo) == -1 or
+            t.tipoCampo(campo).esNat() != cambios.dato(campo).esNat()) {
+            return false;
+        }
+    }
+    _instalarCompactacion(nombre, false);
+    _instalarIndices(nombre, false);
+    vector<int> ids = _idsQueCumplen(c, nombre);
+    if (not t.puedeActualizar(ids, cambios)) {
+        return false;
+    }
+    // Solo cambian los índices de los campos modificados
+    vector<Indice *> afectados;
+    for (auto it = _indices.at(nombre).begin(); it != _indices.at(nombre).end(); ++it) {
+        vector<string> guardados = it->second.campos();
+        guardados.insert(guardados.end(), it->second.incluidos().begin(),
+                         it->second.incluidos().end());
+        for (const string &campo : guardados) {
+            if (cambios.schema()->ordinal(campo) != -1) {
+                afectados.push_back(&it->second);
+                break;
+            }
+        }
+    }
+    for (Indice *ind : afectados) {
+        for (int id : ids) {
+            ind->borrarRegistro(id);
+        }
+    }
+    _anotarCambios(nombre, ids, false);
+    {
+        vector<unique_lock<mutex> > cerrojos = _bloquearConstrucciones(nombre);
+        t.actualizarRegistros(ids, cambios);
+    }
+    for (Indice *ind : afectados) {
+        for (int id : ids) {
+            ind->agregarRegistro(id);
+        }
+    }
+    _anotarCambios(nombre, ids, true);
+    return true;
+}
+
+void BaseDeDatos::_reconstruirIndices(const string &nombre) {
+    const Tabla &t = dameTabla(nombre);
+    for (auto it = _indices.at(nombre).begin(); it != _indices.at(nombre).end(); ++it) {
+        it->second = Indice(t, it->second.campos(), it->second.tipo(),
+                            it->second.incluidos());
+    }
+}
+
+void BaseDeDatos::_instalarIndices(const string &nombre, bool esperar) const {
+    auto it = _construcciones.begin();
+    while (it != _construcciones.end()) {
+        if (it->tabla != nombre or not (esperar or it->lista)) {
+            ++it;
+            continue;
+        }
+        it->hilo.join();
+        // Los cambios se aplican en el orden en que ocurrieron; agregar un
+        // registro que el hilo ya leyó o sacar uno que no estaba no hace nada
+        Indice &ind = it->indice;
+        for (const tuple<int, Dato, bool> &cambio : it->bitacora) {
+            if (get<2>(cambio)) {
+                ind.agregarRegistro(get<0>(cambio), get<1>(cambio));
+            } else {
+                ind.borrarRegistro(get<0>(cambio), get<1>(cambio));
+            }
+        }
+        _indices.at(nombre)[Indice::nombre(ind.campos())] = ind;
+        it = _construcciones.erase(it);
+    }
+}
+
+vector<unique_lock<mutex> >
+BaseDeDatos::_bloquearConstrucciones(const string &nombre) {
+    vector<unique_lock<mutex> > res;
+    for (Construccion &c : _construcciones) {
+        if (c.tabla == nombre) {
+            res.push_back(unique_lock<mutex>(c.cerrojo));
+        }
+    }
+    for (Compactacion &c : _compactaciones) {
+        if (c.tabla == nombre) {
+            res.push_back(unique_lock<mutex>(c.cerrojo));
+        }
+    }
+    return res;
+}
+
+void BaseDeDatos::_compactarSiConviene(const string &nombre) {
+    const Tabla &t = dameTabla(nombre);
+    if (t.cant_borrados() < MIN_BORRADOS_COMPACTAR or
+        t.cant_borrados() <= t.cant_registros()) {
+        return;
+    }
+    for (const Compactacion &c : _compactaciones) {
+        if (c.tabla == nombre) {
+            return;
+        }
+    }
+    // Los ids vigentes son la foto de la tabla: lo que cambie después queda
+    // en la bitácora
+    _compactaciones.emplace_back(nombre, t.vacia());
+    Compactacion &c = _compactaciones.back();
+    c.foto = t.ids();
+    const string_map<Indice> &indices = _indices.at(nombre);
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        const Indice &ind = it->second;
+        c.indices[it->first] = Indice(c.compacta, ind.campos(), ind.tipo(),
+                                      ind.incluidos(), false);
+    }
+    c.hilo = thread([&c, &t]() {
+        c.nuevos = c.compacta.copiarPorTramos(t, c.foto, c.cerrojo);
+        // La copia ya no cambia hasta que se instala: sus índices se arman
+        // sin cerrojo
+        for (auto it = c.indices.begin(); it != c.indices.end(); ++it) {
+            Indice &ind = it->second;
+            ind = Indice(c.compacta, ind.campos(), ind.tipo(), ind.incluidos());
+        }
+        c.lista = true;
+    });
+}
+
+void BaseDeDatos::_instalarCompactacion(const string &nombre, bool esperar) {
+    auto it = _compactaciones.begin();
+    while (it != _compactaciones.end() and it->tabla != nombre) {
+        ++it;
+    }
+    if (it == _compactaciones.end() or not (esperar or it->lista)) {
+        return;
+    }
+    it->hilo.join();
+    // Los índices en construcción usan los ids viejos: se terminan antes
+    _instalarIndices(nombre, true);
+    Compactacion &c = *it;
+    Tabla &t = _nombresYtablas.at(nombre);
+
+    // El último cambio de cada id dice si sigue vigente. Los que estaban en
+    // la foto se sacan de la copia, y los vigentes se vuelven a copiar de la
+    // tabla
+    map<int, bool> cambiados;
+    for (const pair<int, bool> &cambio : c.bitacora) {
+        cambiados[cambio.first] = cambio.second;
+    }
+    vector<int> sacados;
+    for (const pair<const int, bool> &cambio : cambiados) {
+        auto pos = lower_bound(c.foto.begin(), c.foto.end(), cambio.first);
+        if (pos != c.foto.end() and *pos == cambio.first and
+            c.nuevos[pos - c.foto.begin()] != -1) {
+            sacados.push_back(c.nuevos[pos - c.foto.begin()]);
+        }
+    }
+    for (auto ind = c.indices.begin(); ind != c.indices.end(); ++ind) {
+        for (int id : sacados) {
+            ind->second.borrarRegistro(id);
+        }
+    }
+    c.compacta.borrarRegistros(sacados);
+    vector<int> agregados;
+    for (const pair<const int, bool> &cambio : cambiados) {
+        if (cambio.second) {
+            agregados.push_back(
+                c.compacta.agregarRegistro(t.registro(cambio.first)).id());
+        }
+    }
+    for (auto ind = c.indices.begin(); ind != c.indices.end(); ++ind) {
+        for (int id : agregados) {
+            ind->second.agregarRegistro(id);
+        }
+    }
+    t.instalarCompacta(c.compacta);
+
+    // Los índices armados sobre la copia pasan a la tabla; los creados
+    // después de la foto se rearman
+    string_map<Indice> &indices = _indices.at(nombre);
+    for (auto ind = indices.begin(); ind != indices.end(); ++ind) {
+        Indice &actual = ind->second;
+        if (c.indices.count(ind->first) and
+            c.indices.at(ind->first).tipo() == actual.tipo() and
+            c.indices.at(ind->first).incluidos() == actual.incluidos()) {
+            actual = move(c.indices.at(ind->first));
+            actual.reubicar(t);
+        } else {
+            actual = Indice(t, actual.campos(), actual.tipo(),
+                            actual.incluidos());
+        }
+    }
+    _compactaciones.erase(it);
+}
+
+void BaseDeDatos::_anotarCambios(const string &nombre, const vector<int> &ids,
+                                 bool agregados) {
+    for (Construccion &c : _construcciones) {
+        if (c.tabla != nombre) {
+            continue;
+        }
+        for (int id : ids) {
+            c.bitacora.push_back(make_tuple(id, c.indice.clave(id), agregados));
+        }
+    }
+    for (Compactacion &c : _compactaciones) {
+        if (c.tabla != nombre) {
+            continue;
+        }
+        for (int id : ids) {
+            c.bitacora.push_back(make_pair(id, agregados));
+        }
     }
 }
 
@@ -45,8 +352,10 @@ bool BaseDeDatos::registroValido(const Registro &r, const string &nombre) const
 }
 
 bool BaseDeDatos::_mismos_tipos(const Registro &r, const Tabla &t) const {
-  for (auto c : t.campos()) {
-    if (r.dato(c).esNat() != t.tipoCampo(c).esNat()) {
+  const Schema &schema = *t.schema();
+  for (int i = 0; i < schema.cantCampos(); ++i) {
+    FieldId campo(schema, i);
+    if (r.dato(campo).esNat() != t.tipoCampo(campo).esNat()) {
       return false;
     }
   }
@@ -54,43 +363,7 @@ bool BaseDeDatos::_mismos_tipos(const Registro &r, const Tabla &t) const {
 }
 
 bool BaseDeDatos::_no_repite(const Registro &r, const Tabla &t) const {
-  list<Registro> filtrados(t.registros().begin(), t.registros().end());
-  for (auto clave : t.claves()) {
-    _filtrar_registros(clave, r.dato(clave), filtrados);
-  }
-  return filtrados.empty();
-}
-
-list<Registro> &
-BaseDeDatos::_filtrar_registros(const string &campo, const Dato &valor,
-                                list<Registro> &registros) const {
-  return _filtrar_registros(campo, valor, registros, true);
-}
-
-list<Registro> &BaseDeDatos::_filtrar_registros(const string &campo,
-                                                const Dato &valor,
-                                                list<Registro> &registros,
-                                                bool igualdad) const {
-  auto iter = registros.begin();
-  while ( iter != registros.end()) {
-    auto now = iter;
-    iter++;
-    if ((not igualdad) xor now->dato(campo) != valor) {
-      registros.erase(now);
-    }
-  }
-
-  return registros;
-}
-
-pair<vector<string>, vector<Dato> > BaseDeDatos::_tipos_tabla(const Tabla &t) {
-  vector<string> res_campos;
-  vector<Dato> res_tipos;
-  for (auto c : t.campos()) {
-    res_campos.push_back(c);
-    res_tipos.push_back(t.tipoCampo(c));
-  }
-  return make_pair(res_campos, res_tipos);
+  return not t.existeClave(r);
 }
 
 bool BaseDeDatos::criterioValido(const Criterio &c,
@@ -104,32 +377,342 @@ bool BaseDeDatos::criterioValido(const Criterio &c,
         restriccion.dato().esNat()) {
       return false;
     }
+    if (restriccion.hasta().esNat() != restriccion.dato().esNat()) {
+      return false;
+    }
+    if (restriccion.operador() == Restriccion::PREFIJO and
+        restriccion.dato().esNat()) {
+      return false;
+    }
   }
   return true;
 }
 
-Tabla BaseDeDatos::busqueda(const BaseDeDatos::Criterio &c,
-                            const string &nombre) {
+Seleccion BaseDeDatos::busqueda(const BaseDeDatos::Criterio &c,
+                                const string &nombre) {
+  _contarUso(c, nombre);
+  _instalarCompactacion(nombre, false);
+  _instalarIndices(nombre, false);
+  const Tabla &ref = dameTabla(nombre);
+  return Seleccion(ref, _idsQueCumplen(c, nombre));
+}
+
+vector<Registro> BaseDeDatos::proyeccion(const Criterio &c,
+                                         const string &nombre,
+                                         const vector<string> &campos) {
+  _contarUso(c, nombre);
+  _instalarCompactacion(nombre, false);
+  _instalarIndices(nombre, false);
+  const Tabla &t = dameTabla(nombre);
+  shared_ptr<const Schema> schema = make_shared<const Schema>(campos);
+  vector<Registro> res;
+
+  // Un índice que guarda todos los campos del criterio y de la proyección
+  // responde solo, si sus campos indexados acotan el criterio
+  const string_map<Indice> &indices = _indices.at(nombre);
+  for (auto it = indices.begin(); it != indices.end(); ++it) {
+    const Indice &ind = (*it).second;
+    vector<int> cubiertos;
+    for (const string &campo : campos) {
+      cubiertos.push_back(ind.cubierto(campo));
+    }
+    bool cubre = find(cubiertos.begin(), cubiertos.end(), -1) == cubiertos.end();
+    for (const Restriccion &restriccion : c) {
+      cubre = cubre and ind.cubierto(restriccion.campo()) != -1;
+    }
+    if (not cubre) {
+      continue;
+    }
+    vector<const Restriccion *> resueltas;
+    vector<Dato> prefijo = _prefijoFijado(ind, c, resueltas);
+    vector<int> ids;
+    if (not prefijo.empty() and (ind.tipo() == Indice::ORDENADO or
+                                 prefijo.size() == ind.campos().size())) {
+      ids = ind.idsConPrefijo(prefijo);
+    } else if (ind.campos().size() == 1 and ind.tipo() != Indice::HASH) {
+      for (const Restriccion &restriccion : c) {
+        if (restriccion.campo() == ind.campos()[0] and restriccion.esRango()) {
+          ids = ind.tipo() == Indice::ORDENADO
+                    ? ind.idsQueCumplen(restriccion)
+                    : ind.mapaQueCumple(restriccion).ids();
+          resueltas.push_back(&restriccion);
+          break;
+        }
+      }
+      if (resueltas.empty()) {
+        continue;
+      }
+    } else {
+      continue;
+    }
+    for (const Restriccion &restriccion : c) {
+      if (find(resueltas.begin(), resueltas.end(), &restriccion) ==
+          resueltas.end()) {
+        ind.filtrar(ids, ind.cubierto(restriccion.campo()), restriccion);
+      }
+    }
+    _marcarUso(nombre, ind);
+    res.reserve(ids.size());
+    for (int id : ids) {
+      vector<Dato> datos;
+      for (int cubierto : cubiertos) {
+        datos.push_back(ind.valor(id, cubierto));
+      }
+      res.push_back(Registro(*schema, datos));
+    }
+    return res;
+  }
+
+  vector<FieldId> camposId;
+  for (const string &campo : campos) {
+    camposId.push_back(t.campoId(campo));
+  }
+  vector<int> ids = _idsQueCumplen(c, nombre);
+  res.reserve(ids.size());
+  for (int id : ids) {
+    vector<Dato> datos;
+    for (const FieldId &campo : camposId) {
+      datos.push_back(t.dato(id, campo));
+    }
+    res.push_back(Registro(*schema, datos));
+  }
+  return res;
+}
+
+void BaseDeDatos::_contarUso(const Criterio &c, const string &nombre) {
   if (_criteriosYusos.count(c)) {
     _criteriosYusos.at(c)++;
   } else {
     _criteriosYusos.fast_insert(make_pair(c, 1));
   }
+  linear_map<Criterio, int> &usos = _usosPorTabla[nombre];
+  if (usos.count(c)) {
+    usos.at(c)++;
+  } else {
+    usos.fast_insert(make_pair(c, 1));
+  }
+}
 
-  const Tabla &ref = dameTabla(nombre);
-  auto campos_datos = _tipos_tabla(ref);
-  Tabla res(ref.claves(), campos_datos.first, campos_datos.second);
-  list<Registro> regs(ref.registros().begin(), ref.registros().end());
+vector<Dato> BaseDeDatos::_prefijoFijado(const Indice &ind, const Criterio &c,
+                                         vector<const Restriccion *> &fijan) {
+  vector<Dato> prefijo;
+  for (const string &campo : ind.campos()) {
+    const Restriccion *igualdad = NULL;
+    for (const Restriccion &restriccion : c) {
+      if (restriccion.igual() and restriccion.campo() == campo) {
+        igualdad = &restriccion;
+        break;
+      }
+    }
+    if (igualdad == NULL) {
+      break;
+    }
+    prefijo.push_back(igualdad->dato());
+    fijan.push_back(igualdad);
+  }
+  return prefijo;
+}
+
+const Indice *BaseDeDatos::_indiceQueCubre(const string &nombre,
+                                           const string &campo) const {
+  const string_map<Indice> &indices = _indices.at(nombre);
+  for (auto it = indices.begin(); it != indices.end(); ++it) {
+    if ((*it).second.cubierto(campo) != -1) {
+      return &(*it).second;
+    }
+  }
+  return NULL;
+}
+
+vector<int> BaseDeDatos::_idsQueCumplen(const Criterio &c,
+                                        const string &nombre) const {
+  const Tabla &t = dameTabla(nombre);
+
+  // Una igualdad sobre un campo indexado da directamente sus registros; si
+  // hay varias, se intersecan sus listas de ids
+  const string_map<Indice> &indices = _indices.at(nombre);
+  vector<const vector<int> *> listas;
+  vector<const Restriccion *> conIndice;
+  vector<const Indice *> indicesListas;
+  for (const Restriccion &restriccion : c) {
+    if (restriccion.igual() and indices.count(restriccion.campo())) {
+      const Indice &ind = indices.at(restriccion.campo());
+      const vector<int> *ids = ind.buscar(restriccion.dato());
+      if (ids == NULL) {
+        _marcarUso(nombre, ind);
+        return vector<int>();
+      }
+      listas.push_back(ids);
+      conIndice.push_back(&restriccion);
+      indicesListas.push_back(&ind);
+    }
+  }
+
+  // Un índice compuesto cuyos primeros campos están fijados por igualdades
+  // del criterio resuelve todas esas igualdades con una sola búsqueda. Se
+  // usa si deja menos registros que la igualdad indexada con menos. Solo
+  // cuentan como usados para el asesor los índices que dan el resultado
+  vector<int> ids;
+  vector<const Restriccion *> resueltas;
+  vector<const Indice *> usados;
+  size_t mejor = numeric_limits<size_t>::max();
+  for (const vector<int> *lista : listas) {
+    mejor = min(mejor, lista->size());
+  }
+  for (auto it = indices.begin(); it != indices.end(); ++it) {
+    const Indice &ind = (*it).second;
+    if (ind.campos().size() == 1) {
+      continue;
+    }
+    vector<const Restriccion *> fijan;
+    vector<Dato> prefijo = _prefijoFijado(ind, c, fijan);
+    if (prefijo.empty() or (ind.tipo() != Indice::ORDENADO and
+                            prefijo.size() < ind.campos().size())) {
+      continue;
+    }
+    vector<int> candidatos = ind.idsConPrefijo(prefijo);
+    if (candidatos.size() < mejor) {
+      mejor = candidatos.size();
+      ids.swap(candidatos);
+      resueltas = fijan;
+      usados = vector<const Indice *>(1, &ind);
+    }
+  }
+
+  // Las restricciones sobre campos con índice BITMAP se resuelven operando
+  // sus mapas: AND entre las igualdades y rangos, AND-NOT por cada
+  // desigualdad. Las desigualdades van al final para restar de un mapa chico
+  MapaBits mapa;
+  vector<const Restriccion *> conMapa;
+  vector<const Indice *> indicesMapa;
+  for (int distintas = 0; distintas < 2; ++distintas) {
+    for (const Restriccion &restriccion : c) {
+      if (not indices.count(restriccion.campo()) or
+          indices.at(restriccion.campo()).tipo() != Indice::BITMAP or
+          (restriccion.operador() == Restriccion::DISTINTO) != distintas) {
+        continue;
+      }
+      const Indice &ind = indices.at(restriccion.campo());
+      if (conMapa.empty()) {
+        mapa = ind.mapaQueCumple(restriccion);
+      } else if (distintas) {
+        mapa = MapaBits::restar(mapa, ind.mapaQueCumple(Restriccion(
+            restriccion.campo(), restriccion.dato(), true)));
+      } else {
+        mapa = MapaBits::intersecar(mapa, ind.mapaQueCumple(restriccion));
+      }
+      conMapa.push_back(&restriccion);
+      indicesMapa.push_back(&ind);
+    }
+  }
+  if (not conMapa.empty() and (size_t) mapa.cardinal() < mejor) {
+    ids = mapa.ids();
+    resueltas = conMapa;
+    usados = indicesMapa;
+  }
+
+  if (resueltas.empty() and not listas.empty()) {
+    ids = Indice::intersecar(listas);
+    resueltas = conIndice;
+    usados = indicesListas;
+  } else if (resueltas.empty()) {
+    // Sin igualdades indexadas, un rango sobre un campo con índice ordenado
+    // recorre solo las claves del rango
+    for (const Restriccion &restriccion : c) {
+      if (restriccion.esRango() and indices.count(restriccion.campo()) and
+          indices.at(restriccion.campo()).tipo() == Indice::ORDENADO) {
+        ids = indices.at(restriccion.campo()).idsQueCumplen(restriccion);
+        resueltas.push_back(&restriccion);
+        usados.push_back(&indices.at(restriccion.campo()));
+        break;
+      }
+    }
+  }
+  for (const Indice *ind : usados) {
+    _marcarUso(nombre, *ind);
+  }
+  if (not resueltas.empty()) {
+    // Las restricciones que quedan se filtran con los valores de un índice
+    // que guarde su campo, si lo hay, y si no con la tabla
+    for (const Restriccion &restriccion : c) {
+      if (find(resueltas.begin(), resueltas.end(), &restriccion) !=
+          resueltas.end()) {
+        continue;
+      }
+      const Indice *cubre = _indiceQueCubre(nombre, restriccion.campo());
+      if (cubre != NULL) {
+        cubre->filtrar(ids, cubre->cubierto(restriccion.campo()), restriccion);
+        _marcarUso(nombre, *cubre);
+      } else {
+        t.filtrar(ids, t.campoId(restriccion.campo()), restriccion);
+      }
+    }
+    return ids;
+  }
+
+  // Una igualdad sobre el campo de particionado deja una sola partición
+  const Particionado &particionado = t.particionado();
+  int particion = -1;
+  if (particionado.tipo() != Particionado::NINGUNO) {
+    for (auto restriccion : c) {
+      if (restriccion.igual() and restriccion.campo() == particionado.campo()) {
+        int p = particionado.particion(restriccion.dato());
+        if (particion != -1 and p != particion) {
+          return vector<int>();
+        }
+        particion = p;
+      }
+    }
+  }
+  ids = particion == -1 ? t.ids() : t.ids(particion);
   for (auto restriccion : c) {
-    _filtrar_registros(restriccion.campo(), restriccion.dato(),
-                       regs, restriccion.igual());
+    t.filtrar(ids, t.campoId(restriccion.campo()), restriccion);
   }
-  for (auto r : regs) {
-    res.agregarRegistro(r);
+  return ids;
+}
+
+double BaseDeDatos::selectividad(const Criterio &c,
+                                 const string &nombre) const {
+  const Tabla &t = dameTabla(nombre);
+  double res = 1;
+  for (auto restriccion : c) {
+    const EstadisticasCampo &e = t.estadisticas(restriccion.campo());
+    if (not restriccion.esRango()) {
+      double igual = e.selectividadIgual(restriccion.dato());
+      res *= restriccion.igual() ? igual : 1 - igual;
+    } else if (restriccion.dato().esNat()) {
+      // Los rangos sobre nats se estiman con el histograma
+      int valor = restriccion.dato().valorNat();
+      if (restriccion.operador() == Restriccion::MENOR) {
+        res *= e.fraccionMenores(valor);
+      } else if (restriccion.operador() == Restriccion::MAYOR) {
+        res *= 1 - e.fraccionMenores(valor) -
+               e.selectividadIgual(restriccion.dato());
+      } else {
+        res *= e.fraccionMenores(restriccion.hasta().valorNat()) -
+               e.fraccionMenores(valor) +
+               e.selectividadIgual(restriccion.hasta());
+      }
+    } else {
+      // Sin histograma de strings se supone que un rango deja un tercio
+      res *= 1.0 / 3;
+    }
   }
+  res = max(0.0, min(1.0, res));
   return res;
 }
 
+double BaseDeDatos::estimarJoin(const string &tabla1, const string &tabla2,
+                                const string &campo) const {
+  const EstadisticasCampo &e1 = dameTabla(tabla1).estadisticas(campo);
+  const EstadisticasCampo &e2 = dameTabla(tabla2).estadisticas(campo);
+  double distintos = max(e1.distintos(), e2.distintos());
+  if (distintos == 0) {
+    return 0;
+  }
+  return (double) e1.cantidad() * e2.cantidad() / distintos;
+}
+
 linear_set<BaseDeDatos::Criterio> BaseDeDatos::top_criterios() const {
   linear_set<Criterio> ret;
   int max = 0;
@@ -145,26 +728,284 @@ linear_set<BaseDeDatos::Criterio> BaseDeDatos::top_criterios() const {
   return ret;
 }
 
-void BaseDeDatos::crearIndice(const string &nombre, const string &campo) {
+vector<BaseDeDatos::RecomendacionIndice>
+BaseDeDatos::recomendarIndices(size_t presupuesto) const {
+    vector<RecomendacionIndice> candidatos;
+    for (const auto &tabla_usos : _usosPorTabla) {
+        for (const auto &crit_count : tabla_usos.second) {
+            _candidatosDe(crit_count.first, crit_count.second, tabla_usos.first,
+                          candidatos);
+        }
+    }
+    sort(candidatos.begin(), candidatos.end(),
+         [](const RecomendacionIndice &a, const RecomendacionIndice &b) {
+             return a.beneficio * b.bytes > b.beneficio * a.bytes;
+         });
+    vector<RecomendacionIndice> res;
+    for (const RecomendacionIndice &candidato : candidatos) {
+        if (candidato.beneficio > 0 and candidato.bytes <= presupuesto) {
+            presupuesto -= candidato.bytes;
+            res.push_back(candidato);
+        }
+    }
+    return res;
+}
+
+void BaseDeDatos::_candidatosDe(const Criterio &c, int usos,
+                                const string &nombre,
+                                vector<RecomendacionIndice> &candidatos) const {
+    const Tabla &t = dameTabla(nombre);
+    double registros = t.cant_registros();
+    if (registros == 0) {
+        return;
+    }
+    const string_map<Indice> &indices = _indices.at(nombre);
+    auto selectividadDe = [&](const vector<Restriccion> &restricciones) {
+        Criterio sub;
+        for (const Restriccion &restriccion : restricciones) {
+            sub.fast_insert(restriccion);
+        }
+        return selectividad(sub, nombre);
+    };
+    auto existe = [&](const vector<string> &campos) {
+        string nombreIndice = Indice::nombre(campos);
+        if (indices.count(nombreIndice)) {
+            return true;
+        }
+        for (const Construccion &construccion : _construcciones) {
+            if (construccion.tabla == nombre and
+                Indice::nombre(construccion.indice.campos()) == nombreIndice) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Fracción de la tabla que se lee hoy: la de la restricción más
+    // selectiva que resuelve un índice existente
+    double actual = 1;
+    for (const Restriccion &restriccion : c) {
+        bool conIndice = false;
+        for (auto it = indices.begin(); it != indices.end(); ++it) {
+            const Indice &ind = (*it).second;
+            if (ind.campos()[0] != restriccion.campo()) {
+                continue;
+            }
+            conIndice = conIndice or ind.tipo() == Indice::BITMAP or
+                        restriccion.igual() or
+                        (ind.tipo() == Indice::ORDENADO and
+                         ind.campos().size() == 1 and restriccion.esRango());
+        }
+        if (conIndice) {
+            actual = min(actual, selectividadDe({restriccion}));
+        }
+    }
+
+    auto agregar = [&](const vector<string> &campos, Indice::Tipo tipo,
+                       double fraccion, double distintos) {
+        if (fraccion > SELECTIVIDAD_MAXIMA or existe(campos)) {
+            return;
+        }
+        double beneficio = usos * registros * max(0.0, actual - fraccion);
+        for (RecomendacionIndice &candidato : candidatos) {
+            if (candidato.tabla == nombre and candidato.campos == campos) {
+                candidato.beneficio += beneficio;
+                if (tipo == Indice::ORDENADO) {
+                    candidato.tipo = tipo;
+                }
+                return;
+            }
+        }
+        RecomendacionIndice candidato;
+        candidato.tabla = nombre;
+        candidato.campos = campos;
+        candidato.tipo = tipo;
+        candidato.beneficio = beneficio;
+        candidato.bytes = Indice::estimarBytes(registros, distintos, tipo);
+        candidatos.push_back(candidato);
+    };
+
+    // Un índice por cada campo restringido
+    vector<pair<double, string> > igualdades;
+    for (const string &campo : t.campos()) {
+        vector<Restriccion> sobreCampo;
+        bool rango = false;
+        bool igualdad = false;
+        for (const Restriccion &restriccion : c) {
+            if (restriccion.campo() == campo) {
+                sobreCampo.push_back(restriccion);
+                rango = rango or restriccion.esRango();
+                igualdad = igualdad or restriccion.igual();
+            }
+        }
+        if (sobreCampo.empty()) {
+            continue;
+        }
+        double distintos = t.estadisticas(campo).distintos();
+        double fraccion = selectividadDe(sobreCampo);
+        if (distintos <= MAX_DISTINTOS_BITMAP) {
+            agregar({campo}, Indice::BITMAP, fraccion, distintos);
+        } else if (rango) {
+            agregar({campo}, Indice::ORDENADO, fraccion, distintos);
+        } else if (igualdad) {
+            agregar({campo}, Indice::HASH, fraccion, distintos);
+        }
+        if (igualdad) {
+            igualdades.push_back(make_pair(fraccion, campo));
+        }
+    }
+
+    // Y uno compuesto sobre los campos con igualdades, del más selectivo al
+    // menos, que las resuelve con una sola búsqueda
+    if (igualdades.size() > 1) {
+        sort(igualdades.begin(), igualdades.end());
+        vector<string> campos;
+        double fraccion = 1;
+        double distintos = 1;
+        for (const pair<double, string> &igualdad : igualdades) {
+            campos.push_back(igualdad.second);
+            fraccion *= igualdad.first;
+            distintos = min(registros,
+                            distintos * t.estadisticas(igualdad.second).distintos());
+        }
+        agregar(campos, Indice::ORDENADO, fraccion, distintos);
+    }
+}
+
+void BaseDeDatos::ajustarIndices(size_t presupuesto, bool enSegundoPlano) {
+    // Se sacan los índices propios que nadie usó desde el ajuste anterior;
+    // los que siguen en construcción todavía no pudieron usarse
+    size_t ocupado = 0;
+    for (const string &nombre : tablas()) {
+        if (not _indicesAutomaticos.count(nombre)) {
+            continue;
+        }
+        _instalarCompactacion(nombre, false);
+        _instalarIndices(nombre, false);
+        string_map<size_t> &automaticos = _indicesAutomaticos.at(nombre);
+        vector<string> sinUso;
+        for (auto it = automaticos.begin(); it != automaticos.end(); ++it) {
+            const string &nombreIndice = (*it).first;
+            if (not _indices.at(nombre).count(nombreIndice)) {
+                ocupado += (*it).second;
+            } else if (_usosIndices.count(nombre) and
+                       _usosIndices.at(nombre).count(nombreIndice) and
+                       _usosIndices.at(nombre).at(nombreIndice) > 0) {
+                ocupado += _indices.at(nombre).at(nombreIndice).bytes();
+            } else {
+                sinUso.push_back(nombreIndice);
+            }
+        }
+        for (const string &nombreIndice : sinUso) {
+            _indices.at(nombre).erase(nombreIndice);
+            automaticos.erase(nombreIndice);
+        }
+    }
+
+    vector<RecomendacionIndice> recomendados =
+        recomendarIndices(presupuesto > ocupado ? presupuesto - ocupado : 0);
+    for (const RecomendacionIndice &recomendado : recomendados) {
+        crearIndice(recomendado.tabla, recomendado.campos, recomendado.tipo,
+                    vector<string>(), enSegundoPlano);
+        _indicesAutomaticos[recomendado.tabla][Indice::nombre(
+            recomendado.campos)] = recomendado.bytes;
+    }
+    _usosPorTabla = string_map<linear_map<Criterio, int> >();
+    _usosIndices = string_map<string_map<int> >();
+}
+
+int BaseDeDatos::usoIndice(const string &tabla,
+                           const vector<string> &campos) const {
+    string nombreIndice = Indice::nombre(campos);
+    if (not _usosIndices.count(tabla) or
+        not _usosIndices.at(tabla).count(nombreIndice)) {
+        return 0;
+    }
+    return _usosIndices.at(tabla).at(nombreIndice);
+}
+
+void BaseDeDatos::_marcarUso(const string &nombre, const Indice &ind) const {
+    _usosIndices[nombre][Indice::nombre(ind.campos())]++;
+}
+
+void BaseDeDatos::crearIndice(const string &nombre, const string &campo,
+                              Indice::Tipo tipo, bool enSegundoPlano) {
+    if (enSegundoPlano) {
+        crearIndice(nombre, vector<string>(1, campo), tipo, vector<string>(),
+                    true);
+        return;
+    }
+    if (_indicesAutomaticos.count(nombre)) {
+        _indicesAutomaticos.at(nombre).erase(campo);
+    }
     const Tabla &t = dameTabla(nombre);
     const Dato &d = t.tipoCampo(campo);
     bool b = d.esString();
-    Indice ind = Indice(t, campo, b);
+    Indice ind = Indice(t, campo, b, tipo);
     _indices[nombre][campo] = ind;
 }
 
+void BaseDeDatos::crearIndice(const string &nombre,
+                              const vector<string> &campos,
+                              Indice::Tipo tipo,
+                              const vector<string> &incluidos,
+                              bool enSegundoPlano) {
+    _instalarCompactacion(nombre, false);
+    if (_indicesAutomaticos.count(nombre)) {
+        _indicesAutomaticos.at(nombre).erase(Indice::nombre(campos));
+    }
+    if (not enSegundoPlano) {
+        _indices[nombre][Indice::nombre(campos)] =
+            Indice(dameTabla(nombre), campos, tipo, incluidos);
+        return;
+    }
+    // Los ids vivos son la foto de la tabla: lo que cambie después queda en
+    // la bitácora
+    const Tabla &t = dameTabla(nombre);
+    _construcciones.emplace_back();
+    Construccion &c = _construcciones.back();
+    c.tabla = nombre;
+    c.indice = Indice(t, campos, tipo, incluidos, false);
+    c.lista = false;
+    c.hilo = thread([&c](vector<int> ids) {
+        c.indice.indexarPorTramos(ids, c.cerrojo);
+        c.lista = true;
+    }, t.ids());
+}
+
+bool BaseDeDatos::indiceListo(const string &tabla,
+                              const vector<string> &campos) const {
+    _instalarIndices(tabla, false);
+    return _indices.at(tabla).count(Indice::nombre(campos)) > 0;
+}
+
+void BaseDeDatos::esperarIndices(const string &nombre) {
+    _instalarIndices(nombre, true);
+}
+
 const Indice* BaseDeDatos::dameIndice(const string &tabla, const string &campo) const {
+    _instalarIndices(tabla, false);
     return &(_indices.at(tabla).at(campo));
 }
+
+const Indice *BaseDeDatos::dameIndice(const string &tabla,
+                                      const vector<string> &campos) const {
+    _instalarIndices(tabla, false);
+    return &(_indices.at(tabla).at(Indice::nombre(campos)));
+}
 BaseDeDatos::join_iterator::join_iterator(const_it_reg &endT,
                                           const_it_regInd &endI,
-                                          bool t): itTabla(endT), endTabla(endT), itIndice(endI), endIndice(endI){
+                                          bool t): itTabla(endT), itIndice(endI), endTabla(endT), endIndice(endI), regIndice(endT){
     finaliza = t;
+    indice = nullptr;
+    tablaRecorrida = nullptr;
+    posRecorrido = 0;
 }
 
 void BaseDeDatos::join_iterator::setearItIndices(const Dato &d) {
-    itIndice = indice->dameRegistros_begin(d);
-    endIndice = indice->dameRegistros_end(d);
+    pair<const_it_regInd, const_it_regInd> rango = indice->dameRegistros(d);
+    itIndice = rango.first;
+    endIndice = rango.second;
 }
 
 BaseDeDatos::join_iterator::join_iterator(const BaseDeDatos &bd,
@@ -173,31 +1014,73 @@ BaseDeDatos::join_iterator::join_iterator(const BaseDeDatos &bd,
                                           const string &campoIndice,
                                           bool tabla1TieneI,
                                           const_it_reg &endT,
-                                          const_it_regInd &endI) :  itTabla(endT), endTabla(endT), itIndice(endI), endIndice(endI){
+                                          const_it_regInd &endI) :  itTabla(endT), itIndice(endI), endTabla(endT), endIndice(endI), regIndice(endT){
     tabla1TieneIndice = tabla1TieneI;
     campo = campoIndice;
     indice = bd.dameIndice(tablaConIndice, campo);
-    itTabla = bd.dameTabla(tablaSinIndice).registros_begin();
-    endTabla = bd.dameTabla(tablaSinIndice).registros_end();
-    if (itTabla != endTabla){
-        Dato d = itTabla->dato(campo);
-        // busco que haya registros en indice que coincidan con el valor que estoy iterando en itTabla
-        while(itTabla != endTabla and indice->noTieneRegistros(d)){
-            d = itTabla->dato(campo);
-            ++itTabla;
-        }
-        // hay 2 posibilidades acá, que haya llegado al endTabla o que haya encontrado registros que coinciden con
-        // el valor que estoy iterando en itTabla (me importa este ultimo)
-        if (itTabla != endTabla)
-            setearItIndices(itTabla->dato(campo));
+    tablaRecorrida = &bd.dameTabla(tablaSinIndice);
+    campoTabla = tablaRecorrida->campoId(campo);
+    endTabla = tablaRecorrida->registros_end();
+    posRecorrido = 0;
+
+    const Tabla &conIndice = bd.dameTabla(tablaConIndice);
+    const Particionado &p1 = tablaRecorrida->particionado();
+    const Particionado &p2 = conIndice.particionado();
+    if (p1.tipo() != Particionado::NINGUNO and p1.campo() == campo and
+        p2.tipo() != Particionado::NINGUNO and p2.campo() == campo and
+        p1.mismoEsquema(p2)) {
+        // Los registros de la partición i solo pueden coincidir con los de
+        // la partición i de la otra tabla
+        shared_ptr<vector<int> > ids = make_shared<vector<int> >();
+        for (int i = 0; i < p1.cantParticiones(); ++i) {
+            if (conIndice.hayRegistros(i)) {
+                vector<int> particion = tablaRecorrida->ids(i);
+                ids->insert(ids->end(), particion.begin(), particion.end());
+            }
+        }
+        idsRecorridos = ids;
+        itTabla = ids->empty() ? endTabla : tablaRecorrida->iterador(ids->front());
+    } else {
+        itTabla = tablaRecorrida->registros_begin();
     }
+    buscarCoincidencia();
+}
+
+void BaseDeDatos::join_iterator::buscarCoincidencia() {
+    // busco que haya registros en indice que coincidan con el valor que estoy iterando en itTabla,
+    // con una sola búsqueda en el índice por registro
+    while (itTabla != endTabla) {
+        setearItIndices(itTabla->dato(campoTabla));
+        if (itIndice != endIndice)
+            break;
+        avanzarTabla();
+    }
+    // hay 2 posibilidades acá, que haya llegado al endTabla o que haya encontrado registros que coinciden con
+    // el valor que estoy iterando en itTabla (me importa este ultimo)
     finaliza = (itTabla == endTabla);
 }
 
-BaseDeDatos::join_iterator::join_iterator(const BaseDeDatos::join_iterator& otro): itTabla(otro.itTabla), endTabla(otro.endTabla), itIndice(otro.itIndice), endIndice(otro.endIndice){
+void BaseDeDatos::join_iterator::avanzarTabla() {
+    if (not idsRecorridos) {
+        ++itTabla;
+        return;
+    }
+    ++posRecorrido;
+    if (posRecorrido < (int) idsRecorridos->size()) {
+        itTabla = tablaRecorrida->iterador((*idsRecorridos)[posRecorrido]);
+    } else {
+        itTabla = endTabla;
+    }
+}
+
+BaseDeDatos::join_iterator::join_iterator(const BaseDeDatos::join_iterator& otro): itTabla(otro.itTabla), itIndice(otro.itIndice), endTabla(otro.endTabla), endIndice(otro.endIndice), regIndice(otro.regIndice){
     indice = otro.indice;
+    tablaRecorrida = otro.tablaRecorrida;
+    idsRecorridos = otro.idsRecorridos;
+    posRecorrido = otro.posRecorrido;
     finaliza = otro.finaliza;
     campo = otro.campo;
+    campoTabla = otro.campoTabla;
     tabla1TieneIndice = otro.tabla1TieneIndice;
 }
 
@@ -214,69 +1097,42 @@ BaseDeDatos::join_iterator BaseDeDatos::join_iterator::operator++(){
     // avanzo al siguiente registro que coindice el valor de itTabla en el indice
     ++itIndice;
     if (itIndice == endIndice){
-        // llegue al final de los registros en indice que coinciden con el valor de itTabla
-        ++itTabla;
-        if (itTabla == endTabla){
-            // llegue al final de los registros en tabla por lo tanto terminé de recorrer el join
-            finaliza = true;
-        }else{
-            Dato d = itTabla->dato(campo);
-            //me fijo el valor de itTabla y busco registros que coincidan con ese valor
-            while(itTabla != endTabla and indice->noTieneRegistros(d)){
-                d = itTabla->dato(campo);
-                ++itTabla;
-            }
-            // hay 2 casos: o llegué al final de los registros en tabla o encontre el siguiente registro de la tabla
-            // que tiene registros que coinciden el valor en el indice
-            if (itTabla == endTabla)
-                finaliza = true;
-            else
-                setearItIndices(itTabla->dato(campo));
-        }
+        // llegue al final de los registros en indice que coinciden con el valor de itTabla,
+        // busco el siguiente registro de la tabla que tenga registros que coincidan en el indice
+        avanzarTabla();
+        buscarCoincidencia();
     }
     return *this;
 }
 
-BaseDeDatos::join_iterator BaseDeDatos::join_iterator::operator++(int a){
+BaseDeDatos::join_iterator BaseDeDatos::join_iterator::operator++(int){
     BaseDeDatos::join_iterator njoin(*this);
     ++(*this);
     return njoin;
 }
 
-// Armo un nuevo registro a partir de los campos y datos de dos registros,
-// teniendo el primer registro prioridad ante campos repetidos frente al r2
-Registro combinarRegistros(const Registro &r1, const Registro &r2){
-    vector<string> campos;
-    vector<Dato> datos;
-    for (const string &campo: r2.campos()) {
-        campos.push_back(campo);
-        datos.push_back(r2.dato(campo));
-    }
-    for (const string &campo: r1.campos()) {
-        campos.push_back(campo);
-        datos.push_back(r1.dato(campo));
-    }
-    Registro registroCombinado = Registro(campos, datos);
-    return registroCombinado;
-}
-
-Registro BaseDeDatos::join_iterator::operator*(){
+RegistroCombinado BaseDeDatos::join_iterator::operator*(){
     // pregunto si la primera tabla que mande como parametro al join es la que tiene indice ya que esta tiene prioridad
     // frente a campos repetidos en registros
+    regIndice = *itIndice;
     if (tabla1TieneIndice)
-        return combinarRegistros(**itIndice, *itTabla);
+        return RegistroCombinado(*regIndice, *itTabla);
     else
-        return combinarRegistros(*itTabla, **itIndice);
+        return RegistroCombinado(*itTabla, *regIndice);
 }
 
 BaseDeDatos::join_iterator BaseDeDatos::join(const string &tabla1, const string &tabla2, const string &campo) const {
+    _instalarIndices(tabla1, false);
+    _instalarIndices(tabla2, false);
     bool tabla1TieneIndice = _indices.end() != _indices.find(tabla1);
     if (tabla1TieneIndice)
         tabla1TieneIndice = _indices.at(tabla1).end() != _indices.at(tabla1).find(campo);
     // armo 2 iteradores para pasar al constructor y no tener que llamar a los
     // constructores por defecto a la hora de usar el constructor del join
     const_it_reg endIt = this->dameTabla(tabla1).registros_end();
-    const_it_regInd endI = linear_set<const_it_reg>().end();
+    const_it_regInd endI = const_it_regInd();
+    _marcarUso(tabla1TieneIndice ? tabla1 : tabla2,
+               _indices.at(tabla1TieneIndice ? tabla1 : tabla2).at(campo));
     if (tabla1TieneIndice)
         return BaseDeDatos::join_iterator(*this, tabla2, tabla1, campo, tabla1TieneIndice, endIt, endI);
     else
@@ -290,6 +1146,6 @@ BaseDeDatos::join_iterator BaseDeDatos::join_end() const {
                     vector<string>(),
                     vector<Dato>());
     const_it_reg endT = t.registros_end();
-    const_it_regInd endI = linear_set<const_it_reg>().begin();
+    const_it_regInd endI = const_it_regInd();
     return join_iterator(endT, endI, true);
 }
\ No newline at end of file
@@ -2,11 +2,17 @@
 #define _BASEDEDATOS_H
 
 #include "Registro.h"
+#include "RegistroCombinado.h"
 #include "Restriccion.h"
 #include "Tabla.h"
+#include "Seleccion.h"
 #include <utility>
+#include <atomic>
 #include <list>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <tuple>
 #include "linear_map.h"
 #include "linear_set.h"
 #include "utils.h"
@@ -23,12 +29,20 @@ using namespace std;
  * Permite realizar filtros del contenido de tablas mediante criterios de
  * búsqueda. Además mantiene estadísticas del uso de los criterios.
  *
+ * Una base de datos se usa desde un solo hilo a la vez, incluso para las
+ * operaciones const: las búsquedas instalan los índices terminados, cuentan
+ * usos y arman caches de los índices (como las listas de ids de los BITMAP)
+ * sin sincronizarse. Los hilos que construyen índices en segundo plano
+ * trabajan sobre su propio índice, todavía no visible para las búsquedas, y
+ * solo leen la tabla bajo el cerrojo de su construcción. Lo mismo las
+ * compactaciones en segundo plano, que arman una copia de la tabla.
+ *
+ * No se puede copiar: sus construcciones en segundo plano tienen hilos que
+ * apuntan a sus tablas.
+ *
  * **se explica con** TAD BaseDeDatos
  */
 
-typedef Tabla::const_iterador_registros const_it_reg;
-typedef linear_set<const_it_reg>::const_iterator const_it_regInd;
-
 class BaseDeDatos {
 
 public:
@@ -40,6 +54,41 @@ public:
     /** @brief Criterio de búsqueda para una base de datos */
     typedef linear_set<Restriccion> Criterio;
 
+    /**
+     * @brief Cantidad máxima de datos distintos de un campo para que el
+     * asesor le recomiende un índice BITMAP.
+     */
+    static const int MAX_DISTINTOS_BITMAP = 64;
+
+    /**
+     * @brief Fracción máxima de la tabla que puede dejar una restricción
+     * para que al asesor le convenga indexarla.
+     */
+    static constexpr double SELECTIVIDAD_MAXIMA = 0.5;
+
+    /**
+     * @brief Cantidad mínima de registros borrados para que una tabla se
+     * compacte sola; por debajo no vale la pena lanzar el hilo.
+     */
+    static const int MIN_BORRADOS_COMPACTAR = 1024;
+
+    /** @brief Índice que el asesor recomienda crear. */
+    struct RecomendacionIndice {
+        /** @brief Tabla donde crearlo. */
+        string tabla;
+        /** @brief Campos del índice, en el orden de la tupla. */
+        vector<string> campos;
+        /** @brief Estructura del índice. */
+        Indice::Tipo tipo;
+        /**
+         * @brief Registros que las búsquedas desde el último ajuste habrían
+         * dejado de leer con el índice, estimados con las estadísticas.
+         */
+        double beneficio;
+        /** @brief Memoria estimada del índice, en bytes. */
+        size_t bytes;
+    };
+
     /**
      * @brief Inicializa una base de datos sin tablas.
      *
@@ -50,6 +99,20 @@ public:
      */
     BaseDeDatos();
 
+    /**
+     * @brief Destruye la base de datos, esperando a que terminen los índices
+     * que se están construyendo en segundo plano.
+     *
+     * \complexity{\O(costo de terminar las construcciones pendientes)}
+     */
+    ~BaseDeDatos();
+
+    /** @brief No se puede copiar una base de datos. */
+    BaseDeDatos(const BaseDeDatos &) = delete;
+
+    /** @brief No se puede asignar una base de datos. */
+    BaseDeDatos &operator=(const BaseDeDatos &) = delete;
+
     /**
      * @brief Crea una nueva tabla en la base de datos.
      *
@@ -57,18 +120,25 @@ public:
      * @param claves Claves de la tabla a crear
      * @param campos Campos de la tabla a crear
      * @param tipos  Tipos para los campos de la tabla a crear
+     * @param almacenamiento Forma en que la tabla guarda sus registros
+     * @param particionado Forma en que la tabla reparte sus registros en
+     * particiones
      *
      * \pre db = \P{this} \LAND
      *      \LNOT (nombre \IN tablas(\P{this})) \LAND
      *      \LAND \LNOT \EMPTYSET?(claves) \LAND
      *      \FORALL (c: campo) c \IN claves \IMPLICA c \IN campos \LAND
-     *      long(campos) = long(tipos) \LAND sinRepetidos(campos)
+     *      long(campos) = long(tipos) \LAND sinRepetidos(campos) \LAND
+     *      (tipo(particionado) != NINGUNO \IMPLIES
+     *       esta?(campo(particionado), campos))
      * \post \P{this} = agregarTabla(nuevaTabla(claves, nuevoRegistro(campos, tipos)), db)
      *
      * \complexity{\O(C)}
      */
     void crearTabla(const string &nombre, const linear_set<string> &claves,
-                    const vector<string> &campos, const vector<Dato> &tipos);
+                    const vector<string> &campos, const vector<Dato> &tipos,
+                    Tabla::Almacenamiento almacenamiento = Tabla::POR_FILAS,
+                    const Particionado &particionado = Particionado());
 
     /**
      * @brief Agrega un registro a la tabla parámetro
@@ -85,6 +155,99 @@ public:
      */
     void agregarRegistro(const Registro &r, const string &nombre);
 
+    /**
+     * @brief Agrega un lote de registros a la tabla parámetro
+     *
+     * El lote se valida completo antes de modificar la tabla: si algún
+     * registro no puede insertarse (por sus campos, sus tipos, o porque repite
+     * claves de la tabla o de otro registro del lote) no se agrega ninguno.
+     * Cada índice de la tabla se actualiza una sola vez con todo el lote.
+     *
+     * @param regs Registros a agregar
+     * @param nombre Nombre de la tabla donde se agregan los registros
+     *
+     * \pre db = \P{this} \LAND nombre \IN tablas(\P{this})
+     * \post \P{res} \IFF los registros de regs pueden insertarse juntos \LAND
+     *  (\P{res} \IMPLIES \P{this} = insertar cada registro de regs en db)
+     *  \LAND (\LNOT \P{res} \IMPLIES \P{this} = db)
+     *
+     * \complexity{\O(long(regs) * (C + copy(Registro))) esperado si la tabla
+     * no tiene índices, \O(long(regs) * ([L + log(m)] + C + copy(Registro)))
+     * sino.}
+     */
+    bool agregarRegistros(const vector<Registro> &regs, const string &nombre);
+
+    /**
+     * @brief Borra de la tabla parámetro los registros que cumplen el criterio
+     *
+     * Los registros se marcan como borrados y se sacan de los índices de la
+     * tabla. Los ids de los demás registros no cambian en el momento. Cuando
+     * hay más registros borrados que vigentes (y al menos
+     * MIN_BORRADOS_COMPACTAR), la tabla se compacta en segundo plano: un hilo
+     * arma una copia sin los borrados y sus índices, y la copia reemplaza a
+     * la tabla en una operación posterior de la base de datos, con los
+     * cambios del medio aplicados. Desde ahí cambian los ids (ver
+     * Seleccion::idsVigentes()).
+     *
+     * @param c Criterio que cumplen los registros a borrar.
+     * @param nombre Nombre de la tabla.
+     *
+     * \pre db = \P{this} \LAND nombre \IN tablas(\P{this}) \LAND
+     *      criterioValido(c, nombre, \P{this})
+     * \post \P{this} = db sin los registros de buscar(c, nombre, db) \LAND
+     *       \P{res} = #(buscar(c, nombre, db))
+     *
+     * \complexity{\O(cr * n + k * (c * L + I * [L + log(m) + S])), con k la
+     * cantidad de registros borrados e I la cantidad de índices de la tabla}
+     */
+    int borrarRegistros(const Criterio &c, const string &nombre);
+
+    /**
+     * @brief Libera el lugar de los registros borrados de la tabla parámetro
+     * y rearma sus índices.
+     *
+     * Si la tabla se está compactando en segundo plano, espera a que
+     * termine e instala la copia; si quedan borrados, compacta en el
+     * momento. Espera también a los índices que se construyen en segundo
+     * plano. Renumera los registros, así que invalida las selecciones de la
+     * tabla hechas antes (ver Seleccion::idsVigentes()) y los iteradores de
+     * sus índices.
+     *
+     * \pre nombre \IN tablas(\P{this})
+     * \post registros(dameTabla(nombre, \P{this})) no cambia \LAND
+     *       cant_borrados(dameTabla(nombre, \P{this})) = 0
+     *
+     * \complexity{\O(n * copy(registro) + I * m * [L + log(m)])}
+     */
+    void compactar(const string &nombre);
+
+    /**
+     * @brief Modifica los registros de la tabla parámetro que cumplen el
+     * criterio
+     *
+     * Cada registro toma los datos de \P{cambios} en los campos de
+     * \P{cambios} y conserva el resto. Los registros se modifican en su lugar
+     * y solo se actualizan los índices de los campos cambiados. Si los
+     * cambios no son válidos para la tabla, o dejarían dos registros con las
+     * mismas claves, no se modifica ningún registro.
+     *
+     * @param c Criterio que cumplen los registros a modificar.
+     * @param cambios Datos nuevos, en los campos a modificar.
+     * @param nombre Nombre de la tabla.
+     *
+     * \pre db = \P{this} \LAND nombre \IN tablas(\P{this}) \LAND
+     *      criterioValido(c, nombre, \P{this})
+     * \post \P{res} \IFF los cambios pueden aplicarse \LAND
+     *  (\P{res} \IMPLIES \P{this} = db con los registros de
+     *  buscar(c, nombre, db) modificados) \LAND
+     *  (\LNOT \P{res} \IMPLIES \P{this} = db)
+     *
+     * \complexity{\O(cr * n + k * (copy(Registro) + I * [L + log(m) + S]))
+     * esperado, con k la cantidad de registros modificados}
+     */
+    bool actualizarRegistros(const Criterio &c, const Registro &cambios,
+                             const string &nombre);
+
     /**
      * @brief Devuelve el conjunto de tablas existentes en la base.
      *
@@ -139,6 +302,10 @@ public:
     /**
      * @brief Evalúa si un criterio puede aplicarse en la tabla parámetro.
      *
+     * Cada restricción debe ser sobre un campo de la tabla y comparar con
+     * datos de su tipo. Las restricciones de prefijo solo valen sobre campos
+     * string.
+     *
      * @param c Criterio a utilizar.
      * @param nombre Nombre de la tabla.
      *
@@ -152,15 +319,86 @@ public:
     /**
      * @brief Devuelve el resultado de buscar en una tabla con un criterio.
      *
+     * Las restricciones se evalúan sobre los ids de los registros, leyendo
+     * solo los campos restringidos. Si la tabla está particionada y el
+     * criterio tiene una igualdad sobre el campo de particionado, solo se
+     * recorre la partición de ese valor. Las restricciones de igualdad
+     * saltean los grupos de registros cuya sinopsis descarta el valor
+     * buscado. Las restricciones de rango y de prefijo sobre un campo con
+     * índice ordenado recorren solo las claves del rango en el índice. El
+     * resultado no copia los registros: es una selección de ids
+     * sobre la tabla buscada, que se invalida si la tabla se modifica, y se
+     * convierte en una tabla propia con Seleccion::materializar().
+     *
      * @param c Criterio de búsqueda utilizado.
      * @param nombre Nombre de la tabla.
      *
      * \pre nombre \IN tablas(\P{this}) \LAND criterioValido(c, nombre, \P{this})
      * \post \P{res} = buscar(c, nombre, \P{this})
      *
-     * \complexity{\O(T + cs * cmp(Criterio) + cr * n * (C + L + copy(reg)))}
+     * \complexity{\O(cs * cmp(Criterio) + cr * n * (C + L))}
      */
-    Tabla busqueda(const Criterio &c, const string &nombre);
+    Seleccion busqueda(const Criterio &c, const string &nombre);
+
+    /**
+     * @brief Devuelve los valores de los campos pedidos en los registros de
+     * la tabla que cumplen el criterio, en orden de id.
+     *
+     * Si un índice con campos incluidos guarda todos los campos del criterio
+     * y de la proyección, y sus campos indexados acotan el criterio (con
+     * igualdades sobre un prefijo, o con un rango si es ORDENADO o BITMAP),
+     * la respuesta sale solo de los valores del índice, sin leer la tabla.
+     * Si no, busca como busqueda y lee los campos de la tabla. Cuenta como
+     * un uso del criterio.
+     *
+     * @param c Criterio de búsqueda utilizado.
+     * @param nombre Nombre de la tabla.
+     * @param campos Campos de los registros resultado.
+     *
+     * \pre nombre \IN tablas(\P{this}) \LAND criterioValido(c, nombre, \P{this})
+     *      \LAND cada campo \IN campos(nombre)
+     * \post \P{res} son las proyecciones a campos de buscar(c, nombre,
+     *       \P{this}), en orden de id
+     *
+     * \complexity{\O(cs * cmp(Criterio) + cr * n * (C + L) + n * p * copy(dato))}
+     */
+    vector<Registro> proyeccion(const Criterio &c, const string &nombre,
+                                const vector<string> &campos);
+
+    /**
+     * @brief Estima la fracción de registros de la tabla que cumplen el
+     * criterio, sin recorrerla.
+     *
+     * Usa las estadísticas de los campos de la tabla y supone que las
+     * restricciones son independientes. Los rangos sobre nats se estiman con
+     * el histograma del campo; los rangos y prefijos sobre strings, con una
+     * fracción fija.
+     *
+     * @param c Criterio a estimar.
+     * @param nombre Nombre de la tabla.
+     *
+     * \pre nombre \IN tablas(\P{this}) \LAND criterioValido(c, nombre, \P{this})
+     * \post 0 \LEQ \P{res} \LEQ 1
+     *
+     * \complexity{\O(cr * (C * L + L + cmp(dato)))}
+     */
+    double selectividad(const Criterio &c, const string &nombre) const;
+
+    /**
+     * @brief Estima la cantidad de registros del join entre dos tablas por un
+     * campo, sin recorrerlas.
+     *
+     * Supone que los valores de la tabla con menos valores distintos aparecen
+     * en la otra.
+     *
+     * \pre tabla1 \IN tablas(\P{this}) \LAND tabla2 \IN tablas(\P{this}) \LAND
+     *      campo \IN campos(tabla1) \LAND campo \IN campos(tabla2)
+     * \post \P{res} \GEQ 0
+     *
+     * \complexity{\O(C * L)}
+     */
+    double estimarJoin(const string &tabla1, const string &tabla2,
+                       const string &campo) const;
 
     /**
      * @brief Devuelve los criterios de máximo uso.
@@ -173,18 +411,149 @@ public:
      */
     linear_set<Criterio> top_criterios() const;
 
+    /**
+     * @brief Índices que conviene crear según los usos de los criterios
+     * desde el último ajustarIndices, de mayor a menor beneficio por byte,
+     * sin pasarse de \P{presupuesto} bytes entre todos.
+     *
+     * Para cada criterio usado, en la tabla donde se usó, se estima con las
+     * estadísticas de los campos qué fracción de la tabla se lee hoy (la
+     * de la restricción más selectiva con índice, o toda) y cuál se leería
+     * con un índice sobre cada campo restringido, o uno compuesto sobre
+     * todos los campos con igualdades. El beneficio de un índice es la suma,
+     * sobre los criterios, de usos * registros * diferencia entre ambas.
+     * Los campos con a lo sumo MAX_DISTINTOS_BITMAP datos distintos llevan
+     * índice BITMAP; si no, ORDENADO si algún criterio los usa con rangos o
+     * prefijos, y HASH si no. No se recomiendan índices que ya existen ni
+     * restricciones que dejan más de SELECTIVIDAD_MAXIMA de la tabla.
+     *
+     * \pre true
+     * \post ningún índice de \P{res} existe \LAND la suma de los bytes de
+     *       \P{res} es a lo sumo presupuesto
+     *
+     * \complexity{\O(cs * [cr^2 * C + I])}, con cs la cantidad de pares de
+     * criterio y tabla usados
+     */
+    vector<RecomendacionIndice> recomendarIndices(size_t presupuesto) const;
+
+    /**
+     * @brief Asesor de índices: saca los índices que creó antes y no se
+     * usaron desde el ajuste anterior, y crea los recomendados que entran en
+     * \P{presupuesto} junto con los suyos que quedan.
+     *
+     * Solo saca índices que creó él: los creados con crearIndice no se
+     * tocan, y crear con crearIndice uno que había creado el asesor lo hace
+     * propio del usuario. Al terminar, los usos de los criterios y de los
+     * índices se vuelven a contar desde cero para el próximo ajuste (uso_criterio
+     * no cambia).
+     *
+     * @param presupuesto Memoria máxima de los índices del asesor, en bytes.
+     * @param enSegundoPlano Si es verdadero, los índices se construyen en
+     * otro hilo, como en crearIndice.
+     *
+     * \pre true
+     *
+     * \complexity{\O(costo de recomendarIndices + costo de crear los índices)}
+     */
+    void ajustarIndices(size_t presupuesto, bool enSegundoPlano = true);
+
+    /**
+     * @brief Cantidad de búsquedas, proyecciones y joins que usaron el índice
+     * de la tabla sobre los campos desde el último ajustarIndices.
+     *
+     * \pre tabla \IN tablas(\P{this})
+     *
+     * \complexity{\O(c * L)}
+     */
+    int usoIndice(const string &tabla, const vector<string> &campos) const;
+
     /**
    * @brief Crea un índice en el campo de la tabla pasados como parámetros.
    *
+   * Si el campo ya tenía un índice, lo reemplaza. Las búsquedas con una
+   * igualdad sobre un campo indexado parten de los registros que el índice
+   * tiene para ese dato.
+   *
    * @param nombre Nombre de la tabla donde quiero crear el índice.
    * @param campo Campo de la tabla donde quiero crear el índice.
+   * @param tipo Estructura del índice: HASH si solo se va a usar para
+   * igualdades y joins, BITMAP si el campo tiene pocos valores distintos.
+   * @param enSegundoPlano Si es verdadero, el índice se construye en otro
+   * hilo, como en la versión compuesta.
    *
    * \pre tabla \IN tablas(\P{this}) \LAND campo \IN campos(tabla)
    * \post
    *
-   * \complexity{\O(m * [L + log(m)])}
+   * \complexity{\O(m * [L + log(m)]) si tipo es ORDENADO, \O(m * L)
+   * esperado si es HASH, \O(m * [L + MAX_ARREGLO]) esperado si es BITMAP;
+   * \O(m) en segundo plano}
+   */
+    void crearIndice(const string &nombre, const string &campo,
+                     Indice::Tipo tipo = Indice::ORDENADO,
+                     bool enSegundoPlano = false);
+
+    /**
+   * @brief Crea un índice compuesto sobre la tupla de campos de la tabla,
+   * en ese orden.
+   *
+   * Si los campos ya tenían un índice, lo reemplaza. Las búsquedas cuyo
+   * criterio fija con igualdades los primeros campos del índice parten de
+   * los registros que el índice tiene para ese prefijo; si el índice es
+   * HASH, el criterio tiene que fijar todos los campos.
+   *
+   * Los valores de los campos \P{incluidos} (y de los indexados) se guardan
+   * en el índice junto a cada id, sin indexarlos: las búsquedas filtran las
+   * restricciones sobre esos campos con los valores del índice, y
+   * proyeccion responde sin leer la tabla si el índice cubre el criterio y
+   * los campos pedidos.
+   *
+   * Si \P{enSegundoPlano} es verdadero, solo toma los ids de los registros
+   * vivos y vuelve: otro hilo arma el índice a partir de ellos, leyendo la
+   * tabla de a tramos, mientras se siguen agregando, borrando y actualizando
+   * registros. Esos cambios se anotan en una bitácora del índice y se
+   * aplican al terminar. Hasta entonces las búsquedas y los joins no lo
+   * usan; indiceListo indica si ya se instaló.
+   *
+   * @param nombre Nombre de la tabla donde quiero crear el índice.
+   * @param campos Campos de la tabla, en el orden de la tupla.
+   * @param tipo Estructura del índice.
+   * @param incluidos Campos cuyos valores se guardan en el índice.
+   * @param enSegundoPlano Si es verdadero, el índice se construye en otro
+   * hilo.
+   *
+   * \pre tabla \IN tablas(\P{this}) \LAND \LNOT vacía?(campos) \LAND
+   *      cada campo de campos e incluidos \IN campos(tabla)
+   * \post
+   *
+   * \complexity{\O(m * [(c + i) * L + log(m)]) si tipo es ORDENADO,
+   * \O(m * (c + i) * L) esperado si es HASH; \O(m) en segundo plano}
+   */
+    void crearIndice(const string &nombre, const vector<string> &campos,
+                     Indice::Tipo tipo = Indice::ORDENADO,
+                     const vector<string> &incluidos = vector<string>(),
+                     bool enSegundoPlano = false);
+
+    /**
+   * @brief Indica si la tabla tiene un índice sobre los campos listo para
+   * usarse. Un índice en segundo plano que terminó de construirse se
+   * instala en ese momento.
+   *
+   * \pre tabla \IN tablas(\P{this})
+   *
+   * \complexity{\O(c * L) más el costo de instalar los índices terminados}
    */
-    void crearIndice(const string &nombre, const string &campo);
+    bool indiceListo(const string &tabla, const vector<string> &campos) const;
+
+    /**
+   * @brief Espera a que terminen los índices de la tabla que se están
+   * construyendo en segundo plano y los instala.
+   *
+   * \pre nombre \IN tablas(\P{this})
+   * \post ningún índice de la tabla está en construcción
+   *
+   * \complexity{\O(costo de terminar las construcciones pendientes)}
+   */
+    void esperarIndices(const string &nombre);
 
     /**
    * @brief Devuelve el índice de la tabla en el campo pasados como parámetros.
@@ -199,9 +568,24 @@ public:
    */
     const Indice *dameIndice(const string &tabla, const string &campo) const;
 
+    /**
+   * @brief Devuelve el índice compuesto de la tabla sobre los campos.
+   *
+   * \pre tabla \IN tablas(\P{this}) \LAND se creó un índice sobre campos
+   * \post
+   *
+   * \complexity{\O(c * L)}
+   */
+    const Indice *dameIndice(const string &tabla,
+                             const vector<string> &campos) const;
+
     /**
    * @brief Join entre dos tablas de la base de datos por un campo.
    *
+   * Si ambas tablas están particionadas igual por el campo del join, cada
+   * partición de la tabla sin índice se empareja con la misma partición de
+   * la otra, y se saltean las particiones cuya pareja está vacía.
+   *
    * \pre tabla1 \IN tablas(\P{this}) \LAND tabla2 \IN tablas(\P{this}) \LAND campo \IN campos(tabla1)
    * \LAND \LAND campo \IN campos(tabla2) \LAND (tieneIndice?(tabla1, campo, \P{this}) \LOR tieneIndice?(tabla2, campo, \P{this}))
    * \post
@@ -236,6 +620,19 @@ private:
      *    * (
      *      * \FORALL (c : Campo) def?(c, obtener(t, _indices)) \IMPLIES
      *        * (c \IN campos(t) ) )
+     *  * \FORALL (c : Construccion) c \IN _construcciones \IMPLIES
+     *    def?(c.tabla, _nombresYtablas) \LAND (c.lista \IMPLIES el hilo de c
+     *    terminó)
+     *  * \FORALL (c : Compactacion) c \IN _compactaciones \IMPLIES
+     *    def?(c.tabla, _nombresYtablas) \LAND (c.lista \IMPLIES el hilo de c
+     *    terminó) \LAND no hay otra compactación de c.tabla en
+     *    _compactaciones
+     *  * \FORALL (t : string) def?(t, _usosPorTabla) \IMPLIES
+     *    def?(t, _nombresYtablas) \LAND cada criterio de
+     *    obtener(t, _usosPorTabla) es válido en t \LAND
+     *  * \FORALL (t : string) def?(t, _indicesAutomaticos) \IMPLIES cada
+     *    clave de obtener(t, _indicesAutomaticos) es un índice de
+     *    obtener(t, _indices) o de una construcción de t en _construcciones
      *
      * abs: basededatos \TO BaseDeDatos\n
      * abs(bd) \EQUIV bd' \|
@@ -262,8 +659,93 @@ private:
     /** @brief Diccionario con los criterios de búsqueda y sus cantidades de usos. */
     linear_map<Criterio, int> _criteriosYusos;
 
-    /** @brief Diccionario con las tablas y los campos donde tienen índice. */
-    string_map<string_map<Indice> > _indices;
+    /**
+     * @brief Índice que se construye en segundo plano.
+     *
+     * El hilo solo toca la tabla con cerrojo tomado, y solo escribe indice y
+     * lista. bitacora la escribe el hilo de la base de datos, con las claves
+     * que tenía cada registro al cambiar, y se aplica recién después de
+     * esperar al hilo.
+     */
+    struct Construccion {
+        /** @brief Tabla indexada. */
+        string tabla;
+        /** @brief Índice en construcción; sin indexar hasta que termina el hilo. */
+        Indice indice;
+        /** @brief Hilo que construye el índice. */
+        thread hilo;
+        /** @brief Se toma para leer la tabla desde el hilo o para modificarla. */
+        mutex cerrojo;
+        /** @brief Define si el hilo terminó. */
+        atomic<bool> lista;
+        /** @brief Cambios de la tabla desde que se tomaron los ids: id, clave y si se agregó. */
+        vector<tuple<int, Dato, bool> > bitacora;
+    };
+
+    /**
+     * @brief Diccionario con las tablas y los campos donde tienen índice.
+     * Los índices compuestos se guardan con Indice::nombre(campos).
+     *
+     * Es mutable porque los índices construidos en segundo plano se
+     * instalan al consultarlos, también desde operaciones constantes.
+     */
+    mutable string_map<string_map<Indice> > _indices;
+
+    /** @brief Índices en construcción en segundo plano, de todas las tablas. */
+    mutable list<Construccion> _construcciones;
+
+    /**
+     * @brief Compactación de una tabla en segundo plano.
+     *
+     * El hilo copia los registros vigentes de foto a compacta, leyendo la
+     * tabla solo con cerrojo tomado, y después arma los índices de
+     * compacta. bitacora la escribe el hilo de la base de datos con los ids
+     * que cambiaron desde la foto, y se aplica recién después de esperar al
+     * hilo.
+     */
+    struct Compactacion {
+        Compactacion(const string &tabla, const Tabla &compacta) :
+            tabla(tabla), compacta(compacta), lista(false) {}
+        /** @brief Tabla compactada. */
+        string tabla;
+        /** @brief Copia de la tabla sin borrados; sin registros hasta que termina el hilo. */
+        Tabla compacta;
+        /** @brief Ids vigentes de la tabla al empezar. */
+        vector<int> foto;
+        /** @brief Id en compacta de cada id de foto, o -1 si se borró antes de copiarlo. */
+        vector<int> nuevos;
+        /** @brief Índices de compacta, por nombre; vacíos hasta que termina el hilo. */
+        string_map<Indice> indices;
+        /** @brief Hilo que arma la copia. */
+        thread hilo;
+        /** @brief Se toma para leer la tabla desde el hilo o para modificarla. */
+        mutex cerrojo;
+        /** @brief Define si el hilo terminó. */
+        atomic<bool> lista;
+        /** @brief Cambios de la tabla desde la foto: id y si quedó vigente. */
+        vector<pair<int, bool> > bitacora;
+    };
+
+    /** @brief Compactaciones en segundo plano, a lo sumo una por tabla. */
+    list<Compactacion> _compactaciones;
+
+    /**
+     * @brief Usos de cada criterio desde el último ajustarIndices, por tabla
+     * donde se usó.
+     */
+    string_map<linear_map<Criterio, int> > _usosPorTabla;
+
+    /**
+     * @brief Usos de cada índice desde el último ajustarIndices, por tabla y
+     * nombre del índice.
+     */
+    mutable string_map<string_map<int> > _usosIndices;
+
+    /**
+     * @brief Índices creados por ajustarIndices, por tabla y nombre, con su
+     * memoria estimada al crearlos.
+     */
+    string_map<string_map<size_t> > _indicesAutomaticos;
     /** @} */
 
     /** @{ */
@@ -285,47 +767,149 @@ private:
      * \post \P{res} = \FORALL (r' : Registro) r \IN registros(t) \IMPLIES
      *  \EXISTS (c : campo) c \IN claves(t) \LAND valor(c, r') != valor(c, r)
      *
-     * \complexity{O(c * C + c * n * (C + L))}
+     * Usa el índice por hash de las claves de la tabla.
+     *
+     * \complexity{\O(c * cmp(dato)) esperado}
      */
     bool _no_repite(const Registro &r, const Tabla &t) const;
 
     /**
-     * @brief Filtra la lista de registros parametro según el criterio.
+     * @brief Ids de los registros de la tabla que cumplen el criterio.
      *
-     * El resultado tiene aliasing con el parámetro registros.
+     * Si el criterio tiene igualdades sobre campos indexados, interseca las
+     * listas de ids de sus datos, de la más chica a la más grande, y filtra
+     * solo esos. Un índice compuesto cuyos primeros campos fija el criterio con
+     * igualdades se usa en su lugar si deja menos registros, y lo mismo las
+     * restricciones sobre campos con índice BITMAP, combinadas con
+     * operaciones entre los mapas de bits de sus datos. Si no hay
+     * igualdades indexadas, y tiene un rango o prefijo sobre un campo con índice
+     * ordenado, parte de los registros de las claves del rango. Si no,
+     * recorre la tabla (o la partición que fija el criterio).
      *
-     * \pre \FORALL (r : Registro) r \IN registros \IMPLIES campo \IN
-     *      campos(r) \LAND tipo?(valor(campo, r)) = tipo?(valor)
-     * \post \P{res} = filtrarRegistrosSegunRestriccion(
-     *       nueva(campo, valor, igualdad), registros)
+     * \pre nombre \IN tablas(\P{this}) \LAND criterioValido(c, nombre, \P{this})
+     * \post \P{res} son los ids de buscar(c, nombre, \P{this}), en orden
+     *
+     * \complexity{\O(n + cr * n * cmp(dato))}
      */
-    list<Registro> &_filtrar_registros(const string &campo, const Dato &valor,
-                                       list<Registro> &registros,
-                                       bool igualdad) const;
+    vector<int> _idsQueCumplen(const Criterio &c, const string &nombre) const;
 
     /**
-     * @brief Filtra la lista de registros parametro según el criterio.
+     * @brief Datos que las igualdades del criterio fijan en los primeros
+     * campos del índice, hasta el primer campo sin igualdad. Deja en
+     * \P{fijan} las igualdades usadas.
      *
-     * El resultado tiene aliasing con el parámetro registros.
+     * \complexity{\O(c * long(c))}
+     */
+    static vector<Dato> _prefijoFijado(const Indice &ind, const Criterio &c,
+                                       vector<const Restriccion *> &fijan);
+
+    /**
+     * @brief Índice de la tabla que guarda los valores del campo, o NULL.
      *
-     * \pre \FORALL (r : Registro) r \IN registros \IMPLIES campo \IN
-     *      campos(r) \LAND tipo?(valor(campo, r)) = tipo?(valor)
-     * \post \P{res} = filtrarRegistrosSegunRestriccion(
-     *       nueva(campo, valor, true), registros)
+     * \pre nombre \IN tablas(\P{this})
+     *
+     * \complexity{\O(I * (c + i) * L)}
      */
-    list<Registro> &_filtrar_registros(const string &campo, const Dato &valor,
-                                       list<Registro> &registros) const;
+    const Indice *_indiceQueCubre(const string &nombre,
+                                  const string &campo) const;
 
     /**
-     * @brief Obtiene los campos y tipos de una tabla.
+     * @brief Cuenta un uso del índice de la tabla para el asesor.
      *
-     * \pre true
-     * \post (\FORALL (c : Campo) está?(c, \P1(\P{res})) \IFF c \IN campos(t))
-     *       \LAND #(campos(t)) = long(\P1(\P{res}))
-     *       \LAND \FORALL (i : Nat) 0 \LEQ i < #(campos(t)) \IMPLIES
-     *       tipo?(\P2(\P{res})[i]) = tipoCampo(\P1(\P{res})[i], t)
+     * \complexity{\O(c * L)}
+     */
+    void _marcarUso(const string &nombre, const Indice &ind) const;
+
+    /**
+     * @brief Agrega a \P{candidatos} los índices de la tabla que le
+     * servirían al criterio, con el beneficio de sus \P{usos}. Si un
+     * candidato ya estaba, le suma el beneficio.
+     *
+     * \pre nombre \IN tablas(\P{this}) \LAND criterioValido(c, nombre, \P{this})
+     *
+     * \complexity{\O(cr^2 * C + I)}
+     */
+    void _candidatosDe(const Criterio &c, int usos, const string &nombre,
+                       vector<RecomendacionIndice> &candidatos) const;
+
+    /**
+     * @brief Incrementa la cantidad de usos del criterio, en total y en la
+     * tabla parámetro.
+     *
+     * \complexity{\O(cs * cmp(Criterio) + L)}
+     */
+    void _contarUso(const Criterio &c, const string &nombre);
+
+    /**
+     * @brief Vuelve a armar los índices de la tabla desde sus registros.
+     *
+     * Se usa cuando cambian los ids de la tabla, al compactarla.
+     *
+     * \pre nombre \IN tablas(\P{this})
+     *
+     * \complexity{\O(I * m * [L + log(m)])}
+     */
+    void _reconstruirIndices(const string &nombre);
+
+    /**
+     * @brief Instala los índices de la tabla cuya construcción en segundo
+     * plano terminó, aplicándoles su bitácora. Si \P{esperar} es verdadero,
+     * antes espera a que terminen todos.
+     *
+     * \pre nombre \IN tablas(\P{this})
+     *
+     * \complexity{\O(suma de los largos de las bitácoras * [L + log(m) + S])}
+     */
+    void _instalarIndices(const string &nombre, bool esperar) const;
+
+    /**
+     * @brief Toma los cerrojos de las construcciones y la compactación
+     * pendientes de la tabla, para modificarla sin que sus hilos la lean a
+     * la vez. Se sueltan al destruir el resultado.
+     *
+     * \complexity{\O(P), con P la cantidad de construcciones pendientes}
+     */
+    vector<unique_lock<mutex> > _bloquearConstrucciones(const string &nombre);
+
+    /**
+     * @brief Lanza la compactación de la tabla en segundo plano si tiene
+     * más registros borrados que vigentes, al menos MIN_BORRADOS_COMPACTAR,
+     * y no se está compactando ya.
+     *
+     * \pre nombre \IN tablas(\P{this})
+     *
+     * \complexity{\O(n + I * (c + i) * L)}
+     */
+    void _compactarSiConviene(const string &nombre);
+
+    /**
+     * @brief Instala la compactación de la tabla si terminó: aplica su
+     * bitácora a la copia y a sus índices y reemplaza con ellos a la tabla
+     * y a sus índices. Si \P{esperar} es verdadero, antes espera a que
+     * termine.
+     *
+     * Los índices creados después de la foto se rearman sobre la tabla
+     * instalada, y antes se espera a los que se construyen en segundo plano,
+     * que usan los ids viejos.
+     *
+     * \pre nombre \IN tablas(\P{this})
+     *
+     * \complexity{\O(B * (copy(registro) + I * [L + log(m) + S])), con B el
+     * largo de la bitácora, más lo de rearmar los índices nuevos}
+     */
+    void _instalarCompactacion(const string &nombre, bool esperar);
+
+    /**
+     * @brief Anota en la bitácora de las construcciones pendientes de la
+     * tabla que los registros \P{ids} se agregaron o se sacaron con la
+     * clave que tienen ahora, y en la de su compactación pendiente que
+     * cambiaron.
+     *
+     * \complexity{\O(P * long(ids) * c * L)}
      */
-    pair<vector<string>, vector<Dato> > _tipos_tabla(const Tabla &t);
+    void _anotarCambios(const string &nombre, const vector<int> &ids,
+                        bool agregados);
+
     /** @} */
 
 
@@ -373,6 +957,13 @@ public:
          */
         join_iterator(const BaseDeDatos::join_iterator &otro);
 
+        /**
+         * @brief Asignación por copia del iterador.
+         *
+         * \complexity{\O(1)}
+         */
+        join_iterator &operator=(const BaseDeDatos::join_iterator &otro) = default;
+
         /**
          * @brief Comparación entre iteradores
          *
@@ -418,31 +1009,55 @@ public:
          *
          * \complexity{\O(n * [L + log(m)])}
          */
-        join_iterator operator++(int a);
+        join_iterator operator++(int);
 
         /**
         * @brief Desreferencia el join combinando los registros actuales
         * (o sea los registros de los iteradores internos del join) de la tabla indexada y de la tabla no indexada.
         *
+        * No se copia ningún dato: el resultado es una vista que referencia a ambos registros, con prioridad
+        * para el registro de la primera tabla del join ante campos repetidos. Para obtener un Registro hay
+        * que materializarla.
+        *
         * El valor devuelto tiene aliasing dentro de la colección.
         *
         * \pre El iterador no debe estar en la posición pasando-el-último.
-        * \post El valor resultado es una referencia constante al valor apuntado.
+        * \post El valor resultado es una vista constante al valor apuntado.
         *
-        * \complexity{\O(copy(Registro))}
+        * \complexity{\O(1)}
         */
-        Registro operator*();
+        RegistroCombinado operator*();
 
 
         /**
         * @brief Setea el begin y end de los iteradores de indice en el join con un dato como parametro
         *
-        * \complexity{\O(1)}
+        * Si el dato no tiene registros en el índice, ambos quedan iguales.
+        *
+        * \complexity{\O(L + log(m)) si el índice es ORDENADO, \O(L) esperado si es HASH}
         */
         void setearItIndices(const Dato &d);
 
     private:
 
+        /**
+         * @brief Avanza itTabla hasta el primer registro (inclusive) cuyo valor
+         * en el campo tiene registros en el índice y setea los iteradores del
+         * índice. Si no hay ninguno, el join finaliza.
+         *
+         * \complexity{\O(n * [L + log(m)])}
+         */
+        void buscarCoincidencia();
+
+        /**
+         * @brief Avanza itTabla al siguiente registro a recorrer de la tabla
+         * sin índice. Si las particiones están emparejadas, solo recorre las
+         * particiones cuya pareja en la tabla con índice tiene registros.
+         *
+         * \complexity{\O(1)}
+         */
+        void avanzarTabla();
+
 
         /** @{ */
         /** @brief Indica si la tabla1 pasada como parametro en el join tiene indice. */
@@ -463,11 +1078,34 @@ public:
         /** @brief Iterador al final del conjunto de los registros de la tabla con índice. */
         const_it_regInd endIndice;
 
+        /**
+         * @brief Iterador de la tabla con índice al registro apuntado por
+         * itIndice; mantiene vivo el registro combinado mientras el join no
+         * avance.
+         */
+        const_it_reg regIndice;
+
         /** @brief Campo donde se va a producir el Join. */
         string campo;
 
+        /** @brief Campo del Join resuelto contra el schema de la tabla sin índice. */
+        FieldId campoTabla;
+
         /** @brief Puntero al índice de la tabla con índice. */
         const Indice *indice;
+
+        /** @brief Tabla sin índice. */
+        const Tabla *tablaRecorrida;
+
+        /**
+         * @brief Ids a recorrer de la tabla sin índice, si ambas tablas están
+         * particionadas igual por el campo del Join; NULL si se recorre
+         * toda la tabla.
+         */
+        shared_ptr<const vector<int> > idsRecorridos;
+
+        /** @brief Posición de itTabla en idsRecorridos. */
+        int posRecorrido;
         /** @} */
     };
 
@@ -0,0 +1,138 @@
+#include "BloqueEnteros.h"
+#include <algorithm>
+
+BloqueEnteros::BloqueEnteros() :
+        _codificacion(BITS), _tam(0), _minimo(0), _maximo(0), _bits(0) {}
+
+BloqueEnteros::BloqueEnteros(const vector<int> &valores) :
+        _codificacion(BITS), _tam(valores.size()), _minimo(0), _maximo(0),
+        _bits(0) {
+    if (valores.empty()) {
+        return;
+    }
+    _minimo = *min_element(valores.begin(), valores.end());
+    _maximo = *max_element(valores.begin(), valores.end());
+    uint64_t rango = (int64_t) _maximo - _minimo;
+    while (_bits < 32 and (rango >> _bits) != 0) {
+        _bits++;
+    }
+    int tramos = 1;
+    for (int i = 1; i < _tam; ++i) {
+        if (valores[i] != valores[i - 1]) {
+            tramos++;
+        }
+    }
+
+    // Cada tramo ocupa 8 bytes (valor y fin)
+    size_t bytesBits = ((size_t) _tam * _bits + 63) / 64 * 8;
+    if ((size_t) tramos * 8 < bytesBits) {
+        _codificacion = RUNS;
+        _tramos.reserve(tramos);
+        _fines.reserve(tramos);
+        for (int i = 0; i < _tam; ++i) {
+            if (i == 0 or valores[i] != valores[i - 1]) {
+                _tramos.push_back(valores[i]);
+                _fines.push_back(i + 1);
+            } else {
+                _fines.back() = i + 1;
+            }
+        }
+        return;
+    }
+
+    _palabras.assign(((size_t) _tam * _bits + 63) / 64, 0);
+    for (int i = 0; i < _tam and _bits > 0; ++i) {
+        uint64_t v = (uint64_t) ((int64_t) valores[i] - _minimo);
+        size_t pos = (size_t) i * _bits;
+        int desplazamiento = pos % 64;
+        _palabras[pos / 64] |= v << desplazamiento;
+        if (desplazamiento + _bits > 64) {
+            _palabras[pos / 64 + 1] |= v >> (64 - desplazamiento);
+        }
+    }
+}
+
+int BloqueEnteros::tam() const {
+    return _tam;
+}
+
+BloqueEnteros::Codificacion BloqueEnteros::codificacion() const {
+    return _codificacion;
+}
+
+size_t BloqueEnteros::bytes() const {
+    return _palabras.size() * sizeof(uint64_t) +
+           (_tramos.size() + _fines.size()) * sizeof(int);
+}
+
+int BloqueEnteros::valor(int i) const {
+    if (_codificacion == RUNS) {
+        return _tramos[upper_bound(_fines.begin(), _fines.end(), i) -
+                       _fines.begin()];
+    }
+    return (int) ((int64_t) _minimo + (int64_t) _empaquetado(i));
+}
+
+vector<int> BloqueEnteros::valores() const {
+    vector<int> res;
+    res.reserve(_tam);
+    if (_codificacion == RUNS) {
+        for (size_t j = 0; j < _tramos.size(); ++j) {
+            res.resize(_fines[j], _tramos[j]);
+        }
+        return res;
+    }
+    for (int i = 0; i < _tam; ++i) {
+        res.push_back(valor(i));
+    }
+    return res;
+}
+
+int BloqueEnteros::filtrar(const int *ids, int cant, int base, int buscado,
+                           bool igualdad, int *salida) const {
+    int quedan = 0;
+    if (buscado < _minimo or buscado > _maximo or _minimo == _maximo) {
+        // Todas las posiciones tienen el mismo resultado
+        bool cumplen = (_minimo == _maximo and buscado == _minimo) == igualdad;
+        if (cumplen) {
+            for (int i = 0; i < cant; ++i) {
+                salida[quedan++] = ids[i];
+            }
+        }
+        return quedan;
+    }
+    if (_codificacion == RUNS) {
+        int tramo = 0;
+        for (int i = 0; i < cant; ++i) {
+            int pos = ids[i] - base;
+            while (_fines[tramo] <= pos) {
+                tramo++;
+            }
+            if ((_tramos[tramo] == buscado) == igualdad) {
+                salida[quedan++] = ids[i];
+            }
+        }
+        return quedan;
+    }
+    // Se compara la diferencia con el mínimo, sin reconstruir el valor
+    uint64_t empaquetado = (uint64_t) ((int64_t) buscado - _minimo);
+    for (int i = 0; i < cant; ++i) {
+        if ((_empaquetado(ids[i] - base) == empaquetado) == igualdad) {
+            salida[quedan++] = ids[i];
+        }
+    }
+    return quedan;
+}
+
+uint64_t BloqueEnteros::_empaquetado(int i) const {
+    if (_bits == 0) {
+        return 0;
+    }
+    size_t pos = (size_t) i * _bits;
+    int desplazamiento = pos % 64;
+    uint64_t v = _palabras[pos / 64] >> desplazamiento;
+    if (desplazamiento + _bits > 64) {
+        v |= _palabras[pos / 64 + 1] << (64 - desplazamiento);
+    }
+    return v & ((uint64_t(1) << _bits) - 1);
+}
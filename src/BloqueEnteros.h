@@ -0,0 +1,151 @@
+#ifndef BLOQUEENTEROS_H
+#define BLOQUEENTEROS_H
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Secuencia de enteros comprimida, de tamaño fijo.
+ *
+ * Se elige la codificación que ocupa menos:
+ *  * BITS (frame-of-reference y bit-packing): cada valor se guarda como su
+ *    diferencia con el mínimo del bloque, usando solo los bits necesarios
+ *    para la mayor diferencia;
+ *  * RUNS (run-length encoding): cada tramo de valores iguales consecutivos
+ *    se guarda una sola vez, con la posición donde termina.
+ *
+ * Las comparaciones por igualdad se hacen sobre la forma comprimida, sin
+ * reconstruir los valores. Un bloque no se modifica: para cambiar un valor se
+ * arma otro bloque.
+ *
+ * **se explica con** Secu(int)
+ */
+class BloqueEnteros {
+
+public:
+
+    /** @brief Forma en que el bloque guarda sus valores. */
+    enum Codificacion { BITS, RUNS };
+
+    /**
+     * @brief Inicializa un bloque sin valores.
+     *
+     * \complexity{\O(1)}
+     */
+    BloqueEnteros();
+
+    /**
+     * @brief Comprime la secuencia de valores.
+     *
+     * \pre true
+     * \post valores(\P{res}) = valores
+     *
+     * \complexity{\O(long(valores))}
+     */
+    BloqueEnteros(const vector<int> &valores);
+
+    /**
+     * @brief Cantidad de valores del bloque.
+     *
+     * \complexity{\O(1)}
+     */
+    int tam() const;
+
+    /**
+     * @brief Codificación elegida para el bloque.
+     *
+     * \complexity{\O(1)}
+     */
+    Codificacion codificacion() const;
+
+    /**
+     * @brief Bytes que ocupan los valores comprimidos.
+     *
+     * \complexity{\O(1)}
+     */
+    size_t bytes() const;
+
+    /**
+     * @brief Valor en la posición \P{i}.
+     *
+     * \pre 0 \LEQ i \LT tam(\P{this})
+     *
+     * \complexity{\O(1) en BITS, \O(log(cantidad de tramos)) en RUNS}
+     */
+    int valor(int i) const;
+
+    /**
+     * @brief Descomprime todos los valores.
+     *
+     * \complexity{\O(tam(\P{this}))}
+     */
+    vector<int> valores() const;
+
+    /**
+     * @brief Filtra posiciones según su valor.
+     *
+     * Copia a \P{salida}, en el mismo orden, los ids de \P{ids} cuyo valor
+     * en la posición id - \P{base} es igual (o distinto, según
+     * \P{igualdad}) a \P{buscado}. Si \P{buscado} está fuera del rango del
+     * bloque, no se lee ningún valor. \P{salida} puede ser \P{ids}.
+     *
+     * \pre ids ordenados de forma creciente \LAND
+     *      \FORALL (id \IN ids) 0 \LEQ id - base \LT tam(\P{this})
+     * \post \P{res} es la cantidad de ids copiados
+     *
+     * \complexity{\O(cant) en BITS, \O(cant + cantidad de tramos) en RUNS}
+     */
+    int filtrar(const int *ids, int cant, int base, int buscado,
+                bool igualdad, int *salida) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: bloqueenteros \TO bool\n
+     * rep(b) \EQUIV
+     *  * _codificacion = BITS \IMPLIES
+     *    0 \LEQ _bits \LEQ 32 \LAND long(_palabras) = techo(_tam * _bits / 64)
+     *    \LAND vacía?(_tramos) \LAND vacía?(_fines) \LAND
+     *  * _codificacion = RUNS \IMPLIES vacía?(_palabras) \LAND
+     *    long(_tramos) = long(_fines) \LAND _fines estrictamente creciente
+     *    \LAND (_tam \GT 0 \IMPLIES ult(_fines) = _tam) \LAND dos tramos
+     *    consecutivos tienen valores distintos \LAND
+     *  * _minimo y _maximo son el mínimo y el máximo de abs(b), si _tam \GT 0
+     *
+     * abs: bloqueenteros \TO Secu(int)\n
+     * abs(b) \EQUIV s \| long(s) = _tam \LAND \FORALL (i : nat) i \LT _tam \IMPLIES
+     *  * _codificacion = BITS \IMPLIES s[i] = _minimo + (bits i * _bits a
+     *    (i + 1) * _bits - 1 de _palabras) \LAND
+     *  * _codificacion = RUNS \IMPLIES s[i] = _tramos[j], con j el menor
+     *    tal que i \LT _fines[j]
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    Codificacion _codificacion;
+    /** @brief Cantidad de valores. */
+    int _tam;
+    /** @brief Mínimo y máximo de los valores. */
+    int _minimo;
+    int _maximo;
+    /** @brief Bits por valor en BITS. */
+    int _bits;
+    /** @brief Valores empaquetados, en BITS. */
+    vector<uint64_t> _palabras;
+    /** @brief Valor de cada tramo, en RUNS. */
+    vector<int> _tramos;
+    /** @brief Posición donde termina cada tramo, en RUNS. */
+    vector<int> _fines;
+    /** @} */
+
+    /**
+     * @brief Diferencia con el mínimo del valor en la posición \P{i} (BITS).
+     *
+     * \complexity{\O(1)}
+     */
+    uint64_t _empaquetado(int i) const;
+};
+
+#endif // BLOQUEENTEROS_H
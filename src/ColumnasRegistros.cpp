@@ -0,0 +1,170 @@
+#include "ColumnasRegistros.h"
+
+const int ColumnasRegistros::TAM_BLOQUE;
+
+ColumnasRegistros::ColumnasRegistros() : _tam(0), _vivos(0) {}
+
+ColumnasRegistros::ColumnasRegistros(const vector<Dato> &tipos) :
+        _columnas(tipos.size()), _tam(0), _vivos(0) {
+    for (size_t i = 0; i < tipos.size(); ++i) {
+        _columnas[i].esNat = tipos[i].esNat();
+    }
+}
+
+int ColumnasRegistros::agregar(const vector<Dato> &datos) {
+    for (size_t i = 0; i < _columnas.size(); ++i) {
+        Columna &col = _columnas[i];
+        col.abiertos.push_back(col.esNat ? datos[i].valorNat()
+                                         : _codigo(col, datos[i]));
+        if (col.abiertos.size() == TAM_BLOQUE) {
+            col.bloques.push_back(BloqueEnteros(col.abiertos));
+            col.abiertos.clear();
+        }
+    }
+    _borrados.push_back(false);
+    _vivos++;
+    return _tam++;
+}
+
+void ColumnasRegistros::reemplazar(int id, const vector<Dato> &datos) {
+    for (size_t i = 0; i < _columnas.size(); ++i) {
+        Columna &col = _columnas[i];
+        _asignar(col, id, col.esNat ? datos[i].valorNat()
+                                    : _codigo(col, datos[i]));
+    }
+}
+
+void ColumnasRegistros::reemplazar(const vector<int> &ids,
+                                   const vector<vector<Dato> > &datos) {
+    for (size_t i = 0; i < _columnas.size(); ++i) {
+        Columna &col = _columnas[i];
+        size_t j = 0;
+        while (j < ids.size()) {
+            int bloque = ids[j] / TAM_BLOQUE;
+            // Valores del bloque, que se descomprimen recién ante el primer
+            // cambio
+            vector<int> valores;
+            for (; j < ids.size() and ids[j] / TAM_BLOQUE == bloque; ++j) {
+                int valor = col.esNat ? datos[j][i].valorNat()
+                                      : _codigo(col, datos[j][i]);
+                int pos = ids[j] % TAM_BLOQUE;
+                if (bloque >= (int) col.bloques.size()) {
+                    col.abiertos[pos] = valor;
+                } else if (not valores.empty()) {
+                    valores[pos] = valor;
+                } else if (col.bloques[bloque].valor(pos) != valor) {
+                    valores = col.bloques[bloque].valores();
+                    valores[pos] = valor;
+                }
+            }
+            if (not valores.empty()) {
+                col.bloques[bloque] = BloqueEnteros(valores);
+            }
+        }
+    }
+}
+
+void ColumnasRegistros::borrar(int id) {
+    _borrados[id] = true;
+    _vivos--;
+}
+
+bool ColumnasRegistros::borrado(int id) const {
+    return _borrados[id];
+}
+
+int ColumnasRegistros::vivos() const {
+    return _vivos;
+}
+
+int ColumnasRegistros::_codigo(Columna &col, const Dato &valor) {
+    auto it = col.codigoDe.find(valor);
+    if (it == col.codigoDe.end()) {
+        it = col.codigoDe.insert(
+                make_pair(valor, col.diccionario.size())).first;
+        col.diccionario.push_back(valor);
+    }
+    return it->second;
+}
+
+int ColumnasRegistros::_valor(const Columna &col, int id) {
+    int bloque = id / TAM_BLOQUE;
+    if (bloque < (int) col.bloques.size()) {
+        return col.bloques[bloque].valor(id % TAM_BLOQUE);
+    }
+    return col.abiertos[id % TAM_BLOQUE];
+}
+
+void ColumnasRegistros::_asignar(Columna &col, int id, int valor) {
+    int bloque = id / TAM_BLOQUE;
+    if (bloque >= (int) col.bloques.size()) {
+        col.abiertos[id % TAM_BLOQUE] = valor;
+    } else if (col.bloques[bloque].valor(id % TAM_BLOQUE) != valor) {
+        vector<int> valores = col.bloques[bloque].valores();
+        valores[id % TAM_BLOQUE] = valor;
+        col.bloques[bloque] = BloqueEnteros(valores);
+    }
+}
+
+int ColumnasRegistros::tam() const {
+    return _tam;
+}
+
+Dato ColumnasRegistros::dato(int id, int ordinal) const {
+    const Columna &col = _columnas[ordinal];
+    if (col.esNat) {
+        return Dato(_valor(col, id));
+    }
+    return col.diccionario[_valor(col, id)];
+}
+
+vector<Dato> ColumnasRegistros::datos(int id) const {
+    vector<Dato> res;
+    res.reserve(_columnas.size());
+    for (size_t i = 0; i < _columnas.size(); ++i) {
+        res.push_back(dato(id, i));
+    }
+    return res;
+}
+
+void ColumnasRegistros::filtrar(vector<int> &ids, int ordinal,
+                                const Dato &valor, bool igualdad) const {
+    const Columna &col = _columnas[ordinal];
+    int buscado;
+    if (col.esNat) {
+        buscado = valor.valorNat();
+    } else {
+        auto it = col.codigoDe.find(valor);
+        if (it == col.codigoDe.end()) {
+            // Ningún registro tiene el valor
+            if (igualdad) {
+                ids.clear();
+            }
+            return;
+        }
+        buscado = it->second;
+    }
+    // Los ids están ordenados: se filtran de a un bloque por vez
+    int quedan = 0;
+    size_t i = 0;
+    while (i < ids.size()) {
+        int bloque = ids[i] / TAM_BLOQUE;
+        size_t fin = i;
+        while (fin < ids.size() and ids[fin] / TAM_BLOQUE == bloque) {
+            fin++;
+        }
+        if (bloque < (int) col.bloques.size()) {
+            quedan += col.bloques[bloque].filtrar(&ids[i], fin - i,
+                                                  bloque * TAM_BLOQUE, buscado,
+                                                  igualdad, &ids[quedan]);
+        } else {
+            for (size_t j = i; j < fin; ++j) {
+                if ((col.abiertos[ids[j] % TAM_BLOQUE] == buscado) == igualdad) {
+                    ids[quedan++] = ids[j];
+                }
+            }
+        }
+        i = fin;
+    }
+    ids.resize(quedan);
+}
@@ -0,0 +1,250 @@
+#ifndef COLUMNASREGISTROS_H
+#define COLUMNASREGISTROS_H
+
+#include <map>
+#include <vector>
+#include "Dato.h"
+#include "BloqueEnteros.h"
+
+using namespace std;
+
+/**
+ * @brief Almacenamiento de los registros de una tabla por columnas.
+ *
+ * Cada campo se guarda en su propia columna: los campos nat como sus valores
+ * y los campos string como códigos de un diccionario de valores distintos.
+ * Cada TAM_BLOQUE registros, los valores de cada columna se comprimen en un
+ * BloqueEnteros; solo el último bloque, incompleto, queda sin comprimir. Los
+ * registros se identifican por su id (posición en el orden de inserción) y
+ * se reconstruyen solo cuando se los pide, por lo que un filtro sobre un
+ * campo lee únicamente la columna de ese campo, en su forma comprimida.
+ * Borrar un registro solo lo marca como borrado, para que los ids de los
+ * demás no cambien.
+ *
+ * **se explica con** Secu(Secu(Dato))
+ */
+class ColumnasRegistros {
+
+public:
+
+    /** @brief Cantidad de registros por bloque comprimido. */
+    static const int TAM_BLOQUE = 1024;
+
+    /**
+     * @brief Inicializa un almacenamiento sin columnas ni registros.
+     *
+     * \complexity{\O(1)}
+     */
+    ColumnasRegistros();
+
+    /**
+     * @brief Inicializa un almacenamiento sin registros, con una columna por
+     * tipo.
+     *
+     * \pre true
+     * \post \P{res} no tiene registros \LAND la columna i guarda datos del tipo
+     * de tipos[i]
+     *
+     * \complexity{\O(long(tipos))}
+     */
+    ColumnasRegistros(const vector<Dato> &tipos);
+
+    /**
+     * @brief Agrega un registro dado por sus datos, indexados por ordinal.
+     *
+     * \pre long(datos) = cantidad de columnas \LAND cada dato tiene el tipo de
+     * su columna
+     * \post se agrega el registro al final \LAND \P{res} es su id
+     *
+     * \complexity{\O(C * (L + log(k)))}, con k la cantidad de valores
+     * distintos de un campo string
+     */
+    int agregar(const vector<Dato> &datos);
+
+    /**
+     * @brief Reemplaza los datos del registro \P{id}, indexados por ordinal.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this}) \LAND \LNOT borrado(id) \LAND
+     * long(datos) = cantidad de columnas \LAND cada dato tiene el tipo de su
+     * columna
+     * \post datos(id) = datos
+     *
+     * Si el registro está en un bloque comprimido y algún dato cambia, el
+     * bloque de esa columna se vuelve a comprimir.
+     *
+     * \complexity{\O(C * (L + log(k) + TAM_BLOQUE))}
+     */
+    void reemplazar(int id, const vector<Dato> &datos);
+
+    /**
+     * @brief Reemplaza los datos de varios registros: los del registro
+     * ids[i] por datos[i], indexados por ordinal.
+     *
+     * Los cambios se agrupan por bloque, así que cada bloque comprimido con
+     * algún dato distinto se descomprime y se vuelve a comprimir una sola vez
+     * por columna, en lugar de una vez por registro. Conviene que los ids
+     * estén ordenados, para que los de un mismo bloque queden juntos.
+     *
+     * \pre long(ids) = long(datos) \LAND los ids no se repiten \LAND
+     * \FORALL (i : nat) i \LT long(ids) \IMPLIES reemplazar(ids[i], datos[i])
+     * cumple su precondición
+     * \post \FORALL (i : nat) i \LT long(ids) \IMPLIES datos(ids[i]) = datos[i]
+     *
+     * \complexity{\O(C * (long(ids) * (L + log(k)) + b * TAM_BLOQUE))}, con
+     * b la cantidad de bloques comprimidos que cambian
+     */
+    void reemplazar(const vector<int> &ids, const vector<vector<Dato> > &datos);
+
+    /**
+     * @brief Marca como borrado el registro \P{id}.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this}) \LAND \LNOT borrado(id)
+     * \post borrado(id)
+     *
+     * \complexity{\O(1)}
+     */
+    void borrar(int id);
+
+    /**
+     * @brief Indica si el registro \P{id} está borrado.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this})
+     *
+     * \complexity{\O(1)}
+     */
+    bool borrado(int id) const;
+
+    /**
+     * @brief Cantidad de registros, contando los borrados.
+     *
+     * \complexity{\O(1)}
+     */
+    int tam() const;
+
+    /**
+     * @brief Cantidad de registros no borrados.
+     *
+     * \complexity{\O(1)}
+     */
+    int vivos() const;
+
+    /**
+     * @brief Dato del registro \P{id} en la columna \P{ordinal}.
+     *
+     * Se devuelve por copia.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this}) \LAND ordinal es una columna válida
+     *
+     * \complexity{\O(log(TAM_BLOQUE) + copy(dato))}
+     */
+    Dato dato(int id, int ordinal) const;
+
+    /**
+     * @brief Reconstruye los datos del registro \P{id}, indexados por ordinal.
+     *
+     * \pre 0 \LEQ id \LT tam(\P{this})
+     *
+     * \complexity{\O(C * (log(TAM_BLOQUE) + copy(dato)))}
+     */
+    vector<Dato> datos(int id) const;
+
+    /**
+     * @brief Deja en \P{ids} solo los registros cuyo dato en la columna
+     * \P{ordinal} es igual (o distinto, según \P{igualdad}) a \P{valor}.
+     *
+     * Solo lee la columna del campo, sin descomprimirla. En las columnas
+     * string el valor se traduce a su código una sola vez y se comparan
+     * códigos; los bloques cuyo rango no incluye el valor buscado se
+     * resuelven sin leer sus valores.
+     *
+     * \pre los ids son válidos \LAND valor tiene el tipo de la columna
+     * \post \P{ids} = ids' filtrados, en el mismo orden
+     *
+     * \complexity{\O(long(ids) + tramos + L * log(k))}, con tramos la
+     * cantidad de tramos de los bloques RUNS que se leen
+     */
+    void filtrar(vector<int> &ids, int ordinal, const Dato &valor,
+                 bool igualdad) const;
+
+private:
+
+    /** @brief Columna de un campo. */
+    struct Columna {
+        /** @brief Define si el campo es nat. */
+        bool esNat;
+        /**
+         * @brief Bloques comprimidos con los valores (o códigos, si el campo
+         * es string) de los primeros registros, TAM_BLOQUE por bloque.
+         */
+        vector<BloqueEnteros> bloques;
+        /** @brief Valores (o códigos) de los registros del último bloque. */
+        vector<int> abiertos;
+        /** @brief Valores distintos del campo si es string, por código. */
+        vector<Dato> diccionario;
+        /** @brief Código de cada valor del diccionario. */
+        map<Dato, int> codigoDe;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: columnasregistros \TO bool\n
+     * rep(c) \EQUIV \FORALL (col : Columna) col \IN _columnas \IMPLIES (
+     *  * long(col.bloques) = _tam / TAM_BLOQUE \LAND
+     *    long(col.abiertos) = _tam mod TAM_BLOQUE \LAND
+     *  * \FORALL (b \IN col.bloques) tam(b) = TAM_BLOQUE \LAND
+     *  * col.esNat \IMPLIES vacía?(col.diccionario) \LAND
+     *  * \LNOT col.esNat \IMPLIES \FORALL (i : nat) i \LT _tam \IMPLIES
+     *    0 \LEQ valor(col, i) \LT long(col.diccionario) \LAND
+     *  * col.diccionario no tiene repetidos \LAND
+     *  * \FORALL (j : nat) j \LT long(col.diccionario) \IMPLIES
+     *    obtener(col.diccionario[j], col.codigoDe) = j
+     * * ) \LAND
+     * long(_borrados) = _tam \LAND _vivos = cantidad de falsos en _borrados
+     *
+     * abs: columnasregistros \TO Secu(Secu(Dato))\n
+     * abs(c) \EQUIV s \| long(s) = _tam \LAND \FORALL (i : nat) i \LT _tam \IMPLIES
+     *  s[i][o] = (_columnas[o].esNat ? datoNat(valor(_columnas[o], i)) :
+     *             _columnas[o].diccionario[valor(_columnas[o], i)])
+     *
+     * con valor(col, i) = (i \LT long(col.bloques) * TAM_BLOQUE ?
+     *   col.bloques[i / TAM_BLOQUE][i mod TAM_BLOQUE] :
+     *   col.abiertos[i mod TAM_BLOQUE])
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    /** @brief Columnas, indexadas por ordinal. */
+    vector<Columna> _columnas;
+    /** @brief Cantidad de registros. */
+    int _tam;
+    /** @brief Indica, por id, si el registro está borrado. */
+    vector<bool> _borrados;
+    /** @brief Cantidad de registros no borrados. */
+    int _vivos;
+    /** @} */
+
+    /**
+     * @brief Código del valor en el diccionario de la columna. Si el valor
+     * no estaba, lo agrega.
+     *
+     * \complexity{\O(L + log(k))}
+     */
+    static int _codigo(Columna &col, const Dato &valor);
+
+    /**
+     * @brief Valor (o código) del registro \P{id} en la columna.
+     *
+     * \complexity{\O(log(TAM_BLOQUE))}
+     */
+    static int _valor(const Columna &col, int id);
+
+    /**
+     * @brief Cambia el valor (o código) del registro \P{id} en la columna,
+     * volviendo a comprimir su bloque si hace falta.
+     *
+     * \complexity{\O(TAM_BLOQUE)}
+     */
+    static void _asignar(Columna &col, int id, int valor);
+};
+
+#endif // COLUMNASREGISTROS_H
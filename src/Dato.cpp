@@ -1,14 +1,30 @@
 #include "Dato.h"
 #include <iostream>
-#include <tuple>
+#include <cstring>
 
 using namespace std;
 
 Dato::Dato(int valorNat) :
-        _valorNat(valorNat), _valorStr(""), _esNat(true) {};
+        _valorNat(valorNat), _esNat(true), _caracteresSueltos(false),
+        _longitud(0), _prefijo{0, 0, 0, 0}, _caracteres(nullptr) {};
 
 Dato::Dato(const string & valorStr) :
-        _valorNat(0), _valorStr(valorStr), _esNat(false) {};
+        _valorNat(0), _esNat(false), _caracteresSueltos(valorStr.size() > 4),
+        _longitud(valorStr.size()), _prefijo{0, 0, 0, 0}, _caracteres(nullptr) {
+    memcpy(_prefijo, valorStr.data(), min<size_t>(_longitud, 4));
+    if (_caracteresSueltos) {
+        char* caracteres = new char[_longitud];
+        memcpy(caracteres, valorStr.data(), _longitud);
+        _caracteres = shared_ptr<const char>(caracteres, default_delete<char[]>());
+    }
+};
+
+Dato::Dato(unsigned int longitud, const char* prefijo,
+           const shared_ptr<const char>& caracteres) :
+        _valorNat(0), _esNat(false), _caracteresSueltos(false),
+        _longitud(longitud),
+        _prefijo{prefijo[0], prefijo[1], prefijo[2], prefijo[3]},
+        _caracteres(caracteres) {};
 
 bool Dato::esNat() const {
     return _esNat;
@@ -19,13 +35,17 @@ bool Dato::esString() const {
 }
 
 string Dato::valorStr() const {
-    return _valorStr;
+    return string(_datosStr(), _longitud);
 };
 
 int Dato::valorNat() const {
     return _valorNat;
 };
 
+const char* Dato::_datosStr() const {
+    return _longitud > 4 ? _caracteres.get() : _prefijo;
+}
+
 Dato datoNat(int valorNat) {
     return Dato(valorNat);
 }
@@ -38,23 +58,63 @@ Dato tipoNat = datoNat(0);
 Dato tipoStr = datoStr("");
 
 bool operator==(const Dato& d1, const Dato& d2) {
-    if (d1.esNat() == d2.esNat()) {
-        if (d1.esNat()) {
-            return d1.valorNat() == d2.valorNat();
-        } else {
-            return d1.valorStr() == d2.valorStr();
-        }
+    if (d1._esNat != d2._esNat) {
+        return false;
+    }
+    if (d1._esNat) {
+        return d1._valorNat == d2._valorNat;
+    }
+    // La longitud y el prefijo resuelven casi todas las desigualdades sin
+    // seguir el puntero a los caracteres
+    if (d1._longitud != d2._longitud or
+        memcmp(d1._prefijo, d2._prefijo, 4) != 0) {
+        return false;
+    }
+    if (d1._longitud <= 4 or d1._caracteres == d2._caracteres) {
+        return true;
     }
-    return false;
+    return memcmp(d1._caracteres.get() + 4, d2._caracteres.get() + 4,
+                  d1._longitud - 4) == 0;
 }
 
 bool operator!=(const Dato& d1, const Dato& d2) {
     return !(d1 == d2);
 }
 
+size_t hashDato(const Dato& d) {
+    if (d._esNat) {
+        return hash<int>()(d._valorNat);
+    }
+    // FNV-1a sobre los caracteres del string
+    size_t h = 14695981039346656037ULL;
+    const char* c = d._datosStr();
+    for (unsigned int i = 0; i < d._longitud; ++i) {
+        h = (h ^ (unsigned char) c[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+// Mismo orden que (esNat, valorNat, valorStr): los strings van antes que los
+// nats y entre strings el orden es lexicográfico
 bool operator<(const Dato& d1, const Dato& d2) {
-    return (make_tuple(d1.esNat(), d1._valorNat, d1._valorStr) <
-            make_tuple(d2.esNat(), d2._valorNat, d2._valorStr));
+    if (d1._esNat != d2._esNat) {
+        return d2._esNat;
+    }
+    if (d1._esNat) {
+        return d1._valorNat < d2._valorNat;
+    }
+    int cmp = memcmp(d1._prefijo, d2._prefijo, 4);
+    if (cmp != 0) {
+        return cmp < 0;
+    }
+    if (d1._longitud > 4 and d2._longitud > 4) {
+        cmp = memcmp(d1._caracteres.get() + 4, d2._caracteres.get() + 4,
+                     min(d1._longitud, d2._longitud) - 4);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+    }
+    return d1._longitud < d2._longitud;
 }
 
 ostream & operator<<(ostream &os, const Dato& d) {
@@ -2,9 +2,12 @@
 #define DATO_H
 
 #include <string>
+#include <memory>
 
 using namespace std;
 
+class HeapStrings;
+
 /**
  *  @brief Representa un Dato de una Base de Datos.
  *
@@ -28,11 +31,13 @@ public:
     /**
      * @brief Constructor de dato con valor string
      *
+     * Los strings de más de 4 caracteres se copian fuera del dato.
+     *
      * @param valorStr valor string del dato
      *
      * \pre true
      * \post \P{res} \IGOBS datoStr(valorStr)
-     * \complexity{\O(1)}
+     * \complexity{\O(long(valorStr))}
      */
     Dato(const string& valorStr);
 
@@ -61,7 +66,7 @@ public:
      *
      * \pre String?(\P{this})
      * \post \P{res} \IGOBS valorStr(\P{this})
-     * \complexity{\O(1)}
+     * \complexity{\O(long(valorStr(\P{this})))}
      */
     string valorStr() const;
 
@@ -81,29 +86,82 @@ private:
     /** \name Representación
      * rep: dato \TO bool\n
      * rep(d) \EQUIV 
-     *  * _esNat \IMPLIES _valorStr = "" \LOR \LNOT _esNat \IMPLIES _valorNat = 0
+     *  * _esNat \IMPLIES (_longitud = 0 \LAND _caracteres = NULL) \LAND
+     *  * \LNOT _esNat \IMPLIES _valorNat = 0 \LAND
+     *  * \LNOT _esNat \IMPLIES (
+     *    * _prefijo contiene los primeros min(_longitud, 4) caracteres del
+     *      string, completando con '\0' \LAND
+     *    * _longitud \LEQ 4 \IMPLIES _caracteres = NULL \LAND
+     *    * _longitud \GT 4 \IMPLIES _caracteres apunta a los _longitud
+     *      caracteres del string completo
+     *  * ) \LAND
+     *  * _caracteresSueltos \IMPLIES _caracteres apunta al comienzo de un
+     *    arreglo de exactamente _longitud caracteres
      *
      * abs: dato \TO Dato\n
      * abs(d) \EQUIV d' \|
      *  * Nat?(d') = d._esNat \LAND 
      *  * Nat?(d') \IMPLIES valorNat(d) = d._valorNat \LAND
-     *  * \NEG Nat?(d') \IMPLIES valorStr(d) = d._valorStr 
+     *  * \NEG Nat?(d') \IMPLIES valorStr(d) = los primeros d._longitud
+     *    caracteres de (d._longitud \LEQ 4 ? d._prefijo : d._caracteres)
      */
     //////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /** @{ */
     /** @brief Valor cuando el dato es nat. */
     int _valorNat;
-    
-    /** @brief Valor cuando el dato es nat. */
-    string _valorStr;
-    
+
     /** @brief Define si el dato es nat. */
     bool _esNat;
+
+    /**
+     * @brief Define si _caracteres es un arreglo del tamaño justo, pedido
+     * para este string, y no una parte de un bloque de un HeapStrings.
+     * Compartir un arreglo suelto no retiene memoria de más.
+     */
+    bool _caracteresSueltos;
+
+    /** @brief Longitud del string cuando el dato es string. */
+    unsigned int _longitud;
+
+    /**
+     * @brief Primeros 4 caracteres del string, guardados en el dato.
+     *
+     * La mayoría de las comparaciones entre strings distintos se resuelven
+     * mirando solo la longitud y el prefijo, sin seguir el puntero.
+     */
+    char _prefijo[4];
+
+    /**
+     * @brief Caracteres del string completo cuando no entra en el prefijo.
+     *
+     * Pueden ser un arreglo suelto, pedido al construir el dato, o vivir en
+     * un bloque del HeapStrings de una tabla; en ambos casos el shared_ptr
+     * mantiene viva la memoria apuntada.
+     */
+    shared_ptr<const char> _caracteres;
     /** @} */
-    
+
+    /**
+     * @brief Constructor de dato string a partir de su representación.
+     *
+     * \complexity{\O(1)}
+     */
+    Dato(unsigned int longitud, const char* prefijo,
+         const shared_ptr<const char>& caracteres);
+
+    /** @brief Caracteres del string (prefijo o _caracteres según la longitud). */
+    const char* _datosStr() const;
+
+    friend class HeapStrings;
+
     /** @brief Comparador de datos */
     friend bool operator<(const Dato&, const Dato&);
+
+    /** @brief Igualdad de datos */
+    friend bool operator==(const Dato&, const Dato&);
+
+    friend size_t hashDato(const Dato&);
 };
 
 Dato datoNat(int valorNat);
@@ -118,6 +176,16 @@ bool operator==(const Dato&, const Dato&);
 
 bool operator!=(const Dato&, const Dato&);
 
+/**
+ * @brief Hash de un dato, compatible con la igualdad de datos.
+ *
+ * \pre true
+ * \post d1 = d2 \IMPLIES hashDato(d1) = hashDato(d2)
+ *
+ * \complexity{\O(1) si Nat?(d), \O(long(valorStr(d))) sino}
+ */
+size_t hashDato(const Dato& d);
+
 ostream &operator<<(ostream &, const Dato&);
 
 
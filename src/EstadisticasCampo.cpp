@@ -0,0 +1,210 @@
+#include "EstadisticasCampo.h"
+#include <algorithm>
+#include <cmath>
+
+const int EstadisticasCampo::CANT_FRECUENTES;
+const int EstadisticasCampo::CANT_BALDES;
+const int EstadisticasCampo::TAM_MUESTRA;
+const int EstadisticasCampo::PROPORCION_QUITADOS;
+const int EstadisticasCampo::BITS_REGISTROS;
+
+EstadisticasCampo::EstadisticasCampo(const Dato &tipo) :
+        _esNat(tipo.esNat()), _cantidad(0), _quitados(0),
+        _pendientesMuestra(0), _pendientesFuera(0),
+        _registros(1 << BITS_REGISTROS, 0), _semilla(0x9E3779B97F4A7C15ULL),
+        _histogramaValido(false) {}
+
+void EstadisticasCampo::agregar(const Dato &valor) {
+    _cantidad++;
+
+    // HyperLogLog: los primeros bits eligen el registro y el resto aporta la
+    // posición del primer 1
+    uint64_t h = _mezclar(hashDato(valor));
+    int registro = h >> (64 - BITS_REGISTROS);
+    uint64_t resto = h << BITS_REGISTROS;
+    uint8_t rango = 1;
+    while (rango <= 64 - BITS_REGISTROS and not (resto >> 63)) {
+        resto <<= 1;
+        rango++;
+    }
+    _registros[registro] = max(_registros[registro], rango);
+
+    // Space-Saving: si no hay lugar, el valor reemplaza al menos frecuente y
+    // hereda su frecuencia
+    int menor = 0;
+    bool encontrado = false;
+    for (size_t i = 0; i < _frecuentes.size() and not encontrado; ++i) {
+        if (_frecuentes[i].first == valor) {
+            _frecuentes[i].second++;
+            encontrado = true;
+        } else if (_frecuentes[i].second < _frecuentes[menor].second) {
+            menor = i;
+        }
+    }
+    if (not encontrado) {
+        if (_frecuentes.size() < CANT_FRECUENTES) {
+            _frecuentes.push_back(make_pair(valor, 1));
+        } else {
+            _frecuentes[menor] = make_pair(valor, _frecuentes[menor].second + 1);
+        }
+    }
+
+    // Muestreo de reservorio para el histograma. Mientras haya quitados sin
+    // compensar (Random Pairing), el valor ocupa el lugar de uno de ellos con
+    // la probabilidad de que ese quitado estuviera en la muestra
+    if (_esNat) {
+        int pendientes = _pendientesMuestra + _pendientesFuera;
+        if (pendientes > 0) {
+            _semilla = _mezclar(_semilla + 1);
+            if ((int) (_semilla % pendientes) < _pendientesMuestra) {
+                _pendientesMuestra--;
+                _muestra.push_back(valor.valorNat());
+                _histogramaValido = false;
+            } else {
+                _pendientesFuera--;
+            }
+        } else if (_muestra.size() < TAM_MUESTRA) {
+            _muestra.push_back(valor.valorNat());
+            _histogramaValido = false;
+        } else {
+            _semilla = _mezclar(_semilla + 1);
+            uint64_t j = _semilla % _cantidad;
+            if (j < TAM_MUESTRA) {
+                _muestra[j] = valor.valorNat();
+                _histogramaValido = false;
+            }
+        }
+    }
+}
+
+void EstadisticasCampo::quitar(const Dato &valor) {
+    _cantidad--;
+    _quitados++;
+
+    for (size_t i = 0; i < _frecuentes.size(); ++i) {
+        if (_frecuentes[i].first == valor) {
+            if (--_frecuentes[i].second == 0) {
+                _frecuentes.erase(_frecuentes.begin() + i);
+            }
+            break;
+        }
+    }
+
+    // Sacar un elemento de la muestra la deja uniforme sobre los que quedan;
+    // se anota si estaba para que los próximos agregados la vuelvan a llenar
+    // a la misma tasa
+    if (_esNat) {
+        auto it = find(_muestra.begin(), _muestra.end(), valor.valorNat());
+        if (it != _muestra.end()) {
+            *it = _muestra.back();
+            _muestra.pop_back();
+            _pendientesMuestra++;
+            _histogramaValido = false;
+        } else {
+            _pendientesFuera++;
+        }
+    }
+}
+
+bool EstadisticasCampo::desactualizadas() const {
+    return (long) _quitados * PROPORCION_QUITADOS > _cantidad;
+}
+
+int EstadisticasCampo::cantidad() const {
+    return _cantidad;
+}
+
+double EstadisticasCampo::distintos() const {
+    if (_cantidad == 0) {
+        return 0;
+    }
+    double m = _registros.size();
+    double suma = 0;
+    int ceros = 0;
+    for (uint8_t r : _registros) {
+        suma += ldexp(1.0, -r);
+        if (r == 0) {
+            ceros++;
+        }
+    }
+    double alfa = 0.7213 / (1 + 1.079 / m);
+    double estimacion = alfa * m * m / suma;
+    if (estimacion <= 2.5 * m and ceros > 0) {
+        // Corrección para pocos valores: conteo lineal
+        estimacion = m * log(m / ceros);
+    }
+    return min(estimacion, (double) _cantidad);
+}
+
+vector<pair<Dato, int> > EstadisticasCampo::frecuentes() const {
+    vector<pair<Dato, int> > res = _frecuentes;
+    stable_sort(res.begin(), res.end(),
+                [](const pair<Dato, int> &a, const pair<Dato, int> &b) {
+                    return a.second > b.second;
+                });
+    return res;
+}
+
+const vector<int> &EstadisticasCampo::histograma() const {
+    if (not _histogramaValido) {
+        _limites.clear();
+        if (not _muestra.empty()) {
+            vector<int> ordenada = _muestra;
+            sort(ordenada.begin(), ordenada.end());
+            for (int i = 0; i <= CANT_BALDES; ++i) {
+                _limites.push_back(
+                        ordenada[(long) i * (ordenada.size() - 1) / CANT_BALDES]);
+            }
+        }
+        _histogramaValido = true;
+    }
+    return _limites;
+}
+
+double EstadisticasCampo::selectividadIgual(const Dato &valor) const {
+    if (_cantidad == 0) {
+        return 0;
+    }
+    int enFrecuentes = 0;
+    for (const pair<Dato, int> &f : _frecuentes) {
+        if (f.first == valor) {
+            return min(1.0, (double) f.second / _cantidad);
+        }
+        enFrecuentes += f.second;
+    }
+    // El resto de los valores se reparte uniformemente entre los distintos
+    // que no están entre los frecuentes
+    double resto = max(0.0, 1.0 - (double) enFrecuentes / _cantidad);
+    double otros = max(1.0, distintos() - _frecuentes.size());
+    return resto / otros;
+}
+
+double EstadisticasCampo::fraccionMenores(int valor) const {
+    const vector<int> &limites = histograma();
+    if (limites.empty() or valor <= limites.front()) {
+        return 0;
+    }
+    if (valor > limites.back()) {
+        return 1;
+    }
+    for (int i = 0; i < CANT_BALDES; ++i) {
+        int desde = limites[i];
+        int hasta = limites[i + 1];
+        if (valor <= hasta) {
+            // Dentro del balde se supone una distribución uniforme
+            double dentro = hasta == desde ? 0 : (double) (valor - desde) / (hasta - desde);
+            return (i + dentro) / CANT_BALDES;
+        }
+    }
+    return 1;
+}
+
+uint64_t EstadisticasCampo::_mezclar(uint64_t h) {
+    // Finalizador de splitmix64
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
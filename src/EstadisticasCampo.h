@@ -0,0 +1,202 @@
+#ifndef ESTADISTICASCAMPO_H
+#define ESTADISTICASCAMPO_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Dato.h"
+
+using namespace std;
+
+/**
+ * @brief Estadísticas aproximadas de los valores de un campo de una tabla.
+ *
+ * Se actualizan con cada valor agregado, sin recorrer la tabla:
+ *  * la cantidad de valores distintos se estima con HyperLogLog;
+ *  * los valores más comunes se mantienen con el algoritmo Space-Saving, que
+ *    puede sobreestimar sus frecuencias;
+ *  * para los campos nat, un histograma equi-profundo se arma bajo demanda
+ *    a partir de una muestra uniforme de los valores.
+ *
+ * Al quitar un valor se descuenta de la cantidad, de los más comunes y de la
+ * muestra, pero HyperLogLog no puede olvidarlo. La muestra se mantiene
+ * uniforme con Random Pairing: cada valor agregado después compensa a uno
+ * quitado, y entra a la muestra solo si el quitado estaba en ella. Cuando se quitaron muchos
+ * valores respecto de los que quedan, desactualizadas() avisa que conviene
+ * recalcularlas de cero.
+ *
+ * **se explica con** Multiconjunto(Dato)
+ */
+class EstadisticasCampo {
+
+public:
+
+    /** @brief Cantidad de valores más comunes que se mantienen. */
+    static const int CANT_FRECUENTES = 16;
+
+    /** @brief Cantidad de baldes del histograma. */
+    static const int CANT_BALDES = 16;
+
+    /** @brief Tamaño máximo de la muestra para el histograma. */
+    static const int TAM_MUESTRA = 1024;
+
+    /**
+     * @brief Las estadísticas se desactualizan cuando los valores quitados
+     * superan 1 / PROPORCION_QUITADOS de los que quedan.
+     */
+    static const int PROPORCION_QUITADOS = 8;
+
+    /**
+     * @brief Inicializa estadísticas sin valores para un campo del tipo de
+     * \P{tipo}.
+     *
+     * \pre true
+     * \post cantidad(\P{res}) = 0
+     *
+     * \complexity{\O(1)}
+     */
+    EstadisticasCampo(const Dato &tipo);
+
+    /**
+     * @brief Incorpora un valor del campo.
+     *
+     * \pre Nat?(valor) = Nat?(tipo del campo)
+     * \post cantidad(\P{this}) = cantidad(\P{this}') + 1
+     *
+     * \complexity{\O(L + CANT_FRECUENTES * cmp(dato))}
+     */
+    void agregar(const Dato &valor);
+
+    /**
+     * @brief Quita un valor incorporado antes.
+     *
+     * \pre valor fue agregado y no quitado desde entonces
+     * \post cantidad(\P{this}) = cantidad(\P{this}') - 1
+     *
+     * \complexity{\O(CANT_FRECUENTES * cmp(dato) + TAM_MUESTRA)}
+     */
+    void quitar(const Dato &valor);
+
+    /**
+     * @brief Indica si se quitaron tantos valores que la estimación de
+     * distintos y la muestra dejaron de reflejar a los que quedan: más de
+     * 1 / PROPORCION_QUITADOS de cantidad().
+     *
+     * \complexity{\O(1)}
+     */
+    bool desactualizadas() const;
+
+    /**
+     * @brief Cantidad de valores incorporados.
+     *
+     * \complexity{\O(1)}
+     */
+    int cantidad() const;
+
+    /**
+     * @brief Estimación de la cantidad de valores distintos.
+     *
+     * \complexity{\O(1) amortizado}
+     */
+    double distintos() const;
+
+    /**
+     * @brief Valores más comunes y su frecuencia estimada, de mayor a menor.
+     *
+     * \complexity{\O(CANT_FRECUENTES * log(CANT_FRECUENTES))}
+     */
+    vector<pair<Dato, int> > frecuentes() const;
+
+    /**
+     * @brief Límites de los baldes del histograma equi-profundo.
+     *
+     * Cada balde [limites[i], limites[i + 1]] tiene aproximadamente la misma
+     * cantidad de valores. Se devuelve por referencia no-modificable y es
+     * vacío si el campo es string o no tiene valores.
+     *
+     * \complexity{\O(TAM_MUESTRA * log(TAM_MUESTRA)) si cambió desde la última
+     * llamada, \O(1) sino}
+     */
+    const vector<int> &histograma() const;
+
+    /**
+     * @brief Fracción estimada de valores iguales a \P{valor}.
+     *
+     * \pre Nat?(valor) = Nat?(tipo del campo)
+     * \post 0 \LEQ \P{res} \LEQ 1
+     *
+     * \complexity{\O(L + CANT_FRECUENTES * cmp(dato))}
+     */
+    double selectividadIgual(const Dato &valor) const;
+
+    /**
+     * @brief Fracción estimada de valores menores a \P{valor}, según el
+     * histograma.
+     *
+     * \pre el campo es nat
+     * \post 0 \LEQ \P{res} \LEQ 1
+     *
+     * \complexity{\O(CANT_BALDES)}
+     */
+    double fraccionMenores(int valor) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: estadisticascampo \TO bool\n
+     * rep(e) \EQUIV
+     *  * long(_registros) = 2^BITS_REGISTROS \LAND
+     *  * long(_frecuentes) \LEQ CANT_FRECUENTES \LAND
+     *  * long(_muestra) \LEQ min(_cantidad, TAM_MUESTRA) \LAND
+     *  * long(_muestra) + _pendientesMuestra =
+     *    min(_cantidad + _pendientesMuestra + _pendientesFuera, TAM_MUESTRA)
+     *    \LAND
+     *  * (\LNOT _esNat \IMPLIES _pendientesMuestra = 0 \LAND
+     *    _pendientesFuera = 0) \LAND
+     *  * _muestra es una muestra uniforme de los valores \LAND
+     *  * (\LNOT _esNat \IMPLIES vacía?(_muestra)) \LAND
+     *  * _histogramaValido \IMPLIES _limites es el histograma de _muestra
+     *
+     * abs: estadisticascampo \TO Multiconjunto(Dato)\n
+     * abs(e) \EQUIV el multiconjunto de los _cantidad valores agregados y
+     * no quitados
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @brief Bits del hash que eligen el registro de HyperLogLog. */
+    static const int BITS_REGISTROS = 10;
+
+    /** @{ */
+    /** @brief Define si el campo es nat. */
+    bool _esNat;
+    /** @brief Cantidad de valores agregados y no quitados. */
+    int _cantidad;
+    /** @brief Cantidad de valores quitados. */
+    int _quitados;
+    /** @brief Quitados que estaban en la muestra y ningún agregado compensó. */
+    int _pendientesMuestra;
+    /** @brief Quitados que no estaban en la muestra y ningún agregado compensó. */
+    int _pendientesFuera;
+    /** @brief Registros de HyperLogLog. */
+    vector<uint8_t> _registros;
+    /** @brief Valores más comunes con su frecuencia estimada. */
+    vector<pair<Dato, int> > _frecuentes;
+    /** @brief Muestra uniforme de los valores, si el campo es nat. */
+    vector<int> _muestra;
+    /** @brief Estado del generador que elige la muestra. */
+    uint64_t _semilla;
+    /** @brief Límites del histograma, armados a partir de _muestra. */
+    mutable vector<int> _limites;
+    /** @brief Indica si _limites refleja a _muestra. */
+    mutable bool _histogramaValido;
+    /** @} */
+
+    /**
+     * @brief Mezcla los bits de un hash para que se distribuyan uniformemente.
+     *
+     * \complexity{\O(1)}
+     */
+    static uint64_t _mezclar(uint64_t h);
+};
+
+#endif // ESTADISTICASCAMPO_H
@@ -0,0 +1,40 @@
+#include "HeapStrings.h"
+#include <cstring>
+
+const size_t HeapStrings::TAM_BLOQUE;
+const size_t HeapStrings::LONGITUD_COMPARTIDA;
+
+HeapStrings::HeapStrings() : _usado(0), _libre(0) {}
+
+HeapStrings::HeapStrings(const HeapStrings& otro) :
+        _bloques(otro._bloques), _usado(0), _libre(0) {}
+
+HeapStrings& HeapStrings::operator=(const HeapStrings& otro) {
+    _bloques = otro._bloques;
+    _usado = 0;
+    _libre = 0;
+    return *this;
+}
+
+Dato HeapStrings::guardar(const Dato& d) {
+    if (d._esNat or d._longitud <= 4 or
+        (d._caracteresSueltos and d._longitud >= LONGITUD_COMPARTIDA)) {
+        // Un arreglo suelto largo se comparte en lugar de copiarlo: ya ocupa
+        // solo lo justo y el pedido de memoria pesa poco frente a su largo
+        return d;
+    }
+    if (d._longitud > _libre) {
+        // Los strings más grandes que un bloque ocupan un bloque propio
+        size_t tam = max(TAM_BLOQUE, (size_t) d._longitud);
+        _bloques.push_back(shared_ptr<char>(new char[tam], default_delete<char[]>()));
+        _usado = 0;
+        _libre = tam;
+    }
+    char* destino = _bloques.back().get() + _usado;
+    memcpy(destino, d._caracteres.get(), d._longitud);
+    _usado += d._longitud;
+    _libre -= d._longitud;
+    // El dato comparte el contador de referencias del bloque
+    return Dato(d._longitud, d._prefijo,
+                shared_ptr<const char>(_bloques.back(), destino));
+}
@@ -0,0 +1,95 @@
+#ifndef HEAPSTRINGS_H
+#define HEAPSTRINGS_H
+
+#include <memory>
+#include <vector>
+#include "Dato.h"
+
+using namespace std;
+
+/**
+ * @brief Memoria compartida para los caracteres de los datos string de una
+ * tabla.
+ *
+ * Los caracteres de los strings largos se copian uno detrás de otro en bloques
+ * grandes, en lugar de pedir memoria por cada dato. Los de al menos
+ * LONGITUD_COMPARTIDA caracteres que ya tienen su propio arreglo suelto
+ * (como todo dato construido a partir de un string) se comparten sin
+ * copiarlos: para ellos la copia cuesta más que el pedido de memoria. Los
+ * datos devueltos mantienen vivo el bloque al que apuntan, por lo que pueden
+ * sobrevivir al heap.
+ */
+class HeapStrings {
+
+public:
+
+    /**
+     * @brief Longitud a partir de la cual un string con arreglo suelto se
+     * comparte en lugar de copiarse al heap.
+     */
+    static const size_t LONGITUD_COMPARTIDA = 64;
+
+    /**
+     * @brief Inicializa un heap sin bloques.
+     *
+     * \complexity{\O(1)}
+     */
+    HeapStrings();
+
+    /**
+     * @brief Constructor por copia.
+     *
+     * Los bloques se comparten con \P{otro}, pero la copia empieza a escribir
+     * en un bloque nuevo para no pisar los strings que agregue \P{otro}.
+     *
+     * \complexity{\O(B)}, con B la cantidad de bloques de \P{otro}
+     */
+    HeapStrings(const HeapStrings& otro);
+
+    /**
+     * @brief Asignación. Misma semántica que el constructor por copia.
+     *
+     * \complexity{\O(B)}
+     */
+    HeapStrings& operator=(const HeapStrings& otro);
+
+    /**
+     * @brief Devuelve un dato igual a \P{d} cuyos caracteres viven en el heap.
+     *
+     * Los datos nat, los strings que entran en el prefijo y los de al menos
+     * LONGITUD_COMPARTIDA caracteres en un arreglo suelto se devuelven tal
+     * cual, compartiendo los caracteres; el resto se copia al heap.
+     *
+     * \pre true
+     * \post \P{res} = d
+     *
+     * \complexity{\O(1) si se comparte, \O(long(valorStr(d))) si no}
+     */
+    Dato guardar(const Dato& d);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: heapstrings \TO bool\n
+     * rep(h) \EQUIV
+     *  * _usado + _libre \LEQ tamaño del último bloque \LAND
+     *  * vacía?(_bloques) \IMPLIES _usado = 0 \LAND _libre = 0
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    /** @brief Bloques de caracteres. Solo se escribe en el último. */
+    vector<shared_ptr<char> > _bloques;
+
+    /** @brief Posición libre dentro del último bloque. */
+    size_t _usado;
+
+    /** @brief Bytes que quedan libres en el último bloque. */
+    size_t _libre;
+    /** @} */
+
+    /** @brief Tamaño de los bloques que se piden. */
+    static const size_t TAM_BLOQUE = 64 * 1024;
+};
+
+#endif // HEAPSTRINGS_H
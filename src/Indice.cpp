@@ -1,51 +1,618 @@
 #include "Indice.h"
-Indice::Indice(const Tabla &tab, const string &campo, bool esString) {
-    _campo = campo;
+#include <algorithm>
+#include <thread>
+
+const int Indice::SALTO_GALOPE;
+const int Indice::MIN_REGISTROS_POR_HILO;
+const int Indice::REGISTROS_POR_TRAMO;
+const int Indice::BYTES_POR_CLAVE;
+int Indice::_hilos = 0;
+
+Indice::Indice(const Tabla &tab, const string &campo, bool esString,
+               Tipo tipo) {
+    _tabla = &tab;
+    _campos.push_back(campo);
+    _camposId.push_back(tab.campoId(campo));
     _esString = esString;
-    const_it_reg begin = tab.registros_begin();
-    const_it_reg end = tab.registros_end();
-    // recorro todos los registros en la tabla y agrego el iterador apuntando a cada registro a la lista del indice
-    while (begin != end){
-        this->agregarRegistro(begin);
-        ++begin;
+    _tipo = tipo;
+    _cantHash = 0;
+    _indexarTabla();
+}
+
+Indice::Indice(const Tabla &tab, const vector<string> &campos, Tipo tipo,
+               const vector<string> &incluidos, bool indexar) {
+    _tabla = &tab;
+    _campos = campos;
+    for (const string &campo : campos) {
+        _camposId.push_back(tab.campoId(campo));
+    }
+    _incluidos = incluidos;
+    for (const string &campo : incluidos) {
+        _incluidosId.push_back(tab.campoId(campo));
+    }
+    _esString = campos.size() > 1 or tab.tipoCampo(campos[0]).esString();
+    _tipo = tipo;
+    _cantHash = 0;
+    if (indexar) {
+        _indexarTabla();
     }
 }
 
-const_it_regInd Indice::dameRegistros_begin(const Dato &d) const{
-    if (_esString)
-        return _indicesStr.at(d.valorStr()).begin();
-    else
-        return _indicesNat.at(d.valorNat()).begin();
+void Indice::fijarHilos(int hilos) {
+    _hilos = hilos;
+}
+
+const vector<string> &Indice::campos() const {
+    return _campos;
+}
+
+const vector<string> &Indice::incluidos() const {
+    return _incluidos;
+}
+
+int Indice::cubierto(const string &campo) const {
+    if (_incluidos.empty()) {
+        return -1;
+    }
+    for (size_t i = 0; i < _campos.size(); ++i) {
+        if (_campos[i] == campo) {
+            return i;
+        }
+    }
+    for (size_t i = 0; i < _incluidos.size(); ++i) {
+        if (_incluidos[i] == campo) {
+            return _campos.size() + i;
+        }
+    }
+    return -1;
+}
+
+const Dato &Indice::valor(int id, int cubierto) const {
+    return _valores[(size_t) id * (_campos.size() + _incluidos.size()) +
+                    cubierto];
+}
+
+void Indice::filtrar(vector<int> &ids, int cubierto,
+                     const Restriccion &r) const {
+    int quedan = 0;
+    for (int id : ids) {
+        if (r.cumple(valor(id, cubierto))) {
+            ids[quedan++] = id;
+        }
+    }
+    ids.resize(quedan);
+}
+
+string Indice::nombre(const vector<string> &campos) {
+    string res = campos[0];
+    for (size_t i = 1; i < campos.size(); ++i) {
+        res += "," + campos[i];
+    }
+    return res;
+}
+
+string Indice::codificar(const vector<Dato> &datos) {
+    string res;
+    for (const Dato &d : datos) {
+        if (d.esNat()) {
+            // Con el bit de signo invertido, el orden sin signo es el de int
+            uint32_t v = (uint32_t) d.valorNat() ^ 0x80000000u;
+            for (int desplazamiento = 30; desplazamiento >= 0; desplazamiento -= 6) {
+                res += (char) (((v >> desplazamiento) & 63) + 1);
+            }
+        } else {
+            for (char c : d.valorStr()) {
+                unsigned char u = c;
+                if (u < 3) {
+                    res += (char) 2;
+                    res += (char) (u + 1);
+                } else if (u <= 124) {
+                    res += (char) u;
+                } else {
+                    res += (char) (125 + (u - 125) / 64);
+                    res += (char) ((u - 125) % 64 + 1);
+                }
+            }
+            res += (char) 1;
+        }
+    }
+    return res;
+}
+
+Indice::const_iterador Indice::dameRegistros_begin(const Dato &d) const {
+    const vector<int> &ids = this->ids(d);
+    return const_iterador(_tabla, ids.data());
+}
+
+Indice::const_iterador Indice::dameRegistros_end(const Dato &d) const {
+    const vector<int> &ids = this->ids(d);
+    return const_iterador(_tabla, ids.data() + ids.size());
+}
+
+pair<Indice::const_iterador, Indice::const_iterador>
+Indice::dameRegistros(const Dato &d) const {
+    const vector<int> *ids = buscar(d);
+    if (ids == NULL) {
+        return make_pair(const_iterador(), const_iterador());
+    }
+    return make_pair(const_iterador(_tabla, ids->data()),
+                     const_iterador(_tabla, ids->data() + ids->size()));
+}
+
+Indice::Tipo Indice::tipo() const {
+    return _tipo;
 }
 
-const_it_regInd Indice::dameRegistros_end(const Dato &d) const {
+size_t Indice::bytes() const {
+    size_t res = _valores.size() * sizeof(Dato);
+    if (_tipo == BITMAP) {
+        for (const MapaBits &mapa : _mapas) {
+            res += mapa.bytes() + BYTES_POR_CLAVE;
+        }
+        return res + _todos.bytes() + _ranuras.size() * sizeof(int);
+    }
+    if (_tipo == HASH) {
+        for (const vector<int> &ids : _idsHash) {
+            res += ids.size() * sizeof(int) + BYTES_POR_CLAVE;
+        }
+        return res + _ranuras.size() * sizeof(int);
+    }
+    if (_esString) {
+        for (auto it = _indicesStr.begin(); it != _indicesStr.end(); ++it) {
+            res += (*it).second.size() * sizeof(int) + (*it).first.size() +
+                   BYTES_POR_CLAVE;
+        }
+    } else {
+        for (auto it = _indicesNat.begin(); it != _indicesNat.end(); ++it) {
+            res += it.significado().size() * sizeof(int) + BYTES_POR_CLAVE;
+        }
+    }
+    return res;
+}
+
+size_t Indice::estimarBytes(int registros, double distintos, Tipo tipo) {
+    size_t claves = (size_t) distintos * BYTES_POR_CLAVE;
+    if (tipo != BITMAP) {
+        return (size_t) registros * sizeof(int) + claves;
+    }
+    // Cada dato tiene un contenedor por cada 2^16 ids, como arreglo de 2
+    // bytes por id o como mapa de 8 KB; más la unión de todos
+    size_t contenedores = (size_t) distintos * ((registros >> 16) + 1);
+    size_t arreglos = 2 * (size_t) registros;
+    return 2 * min(arreglos, contenedores * 8192) + claves;
+}
+
+const vector<int> &Indice::ids(const Dato &d) const {
+    if (_tipo == BITMAP) {
+        int entrada = _ranuras[_ranura(d)];
+        if (not _idsAlDia[entrada]) {
+            _idsHash[entrada] = _mapas[entrada].ids();
+            _idsAlDia[entrada] = true;
+        }
+        return _idsHash[entrada];
+    }
+    if (_tipo == HASH)
+        return _idsHash[_ranuras[_ranura(d)]];
     if (_esString)
-        return _indicesStr.at(d.valorStr()).end();
+        return _indicesStr.at(d.valorStr());
     else
-        return _indicesNat.at(d.valorNat()).end();
+        return *_indicesNat.buscar(d.valorNat());
+}
 
+const vector<int> *Indice::buscar(const Dato &d) const {
+    if (_tipo != ORDENADO) {
+        if (_ranuras.empty()) {
+            return NULL;
+        }
+        int entrada = _ranuras[_ranura(d)];
+        if (entrada == -1) {
+            return NULL;
+        }
+        if (_tipo == BITMAP) {
+            return _mapas[entrada].vacio() ? NULL : &ids(d);
+        }
+        return _idsHash[entrada].empty() ? NULL : &_idsHash[entrada];
+    }
+    return noTieneRegistros(d) ? NULL : &ids(d);
+}
+
+int Indice::cantRegistros(const Dato &d) const {
+    const vector<int> *ids = buscar(d);
+    return ids == NULL ? 0 : ids->size();
+}
+
+vector<int> Indice::idsQueCumplen(const Restriccion &r) const {
+    vector<int> res;
+    if (_esString) {
+        // Las claves del trie se recorren en orden lexicográfico: se corta en
+        // la primera que ya no puede cumplir la restricción
+        auto it = r.operador() == Restriccion::MENOR
+                      ? _indicesStr.begin()
+                      : _indicesStr.lower_bound(r.dato().valorStr());
+        for (; it != _indicesStr.end(); ++it) {
+            Dato clave = datoStr((*it).first);
+            if (r.cumple(clave)) {
+                res.insert(res.end(), (*it).second.begin(), (*it).second.end());
+            } else if (not (r.operador() == Restriccion::MAYOR and
+                            clave == r.dato())) {
+                break;
+            }
+        }
+    } else {
+        int desde = r.dato().valorNat();
+        auto it = r.operador() == Restriccion::MENOR ? _indicesNat.begin()
+                  : r.operador() == Restriccion::MAYOR
+                      ? _indicesNat.upper_bound(desde)
+                      : _indicesNat.lower_bound(desde);
+        for (; it != _indicesNat.end() and r.cumple(datoNat(it.clave())); ++it) {
+            res.insert(res.end(), it.significado().begin(),
+                       it.significado().end());
+        }
+    }
+    // Cada clave aporta ids distintos, pero las listas se intercalan
+    sort(res.begin(), res.end());
+    return res;
+}
+
+vector<int> Indice::idsConPrefijo(const vector<Dato> &prefijo) const {
+    if (prefijo.size() == _campos.size()) {
+        const vector<int> *ids = buscar(_campos.size() == 1
+                                        ? prefijo[0]
+                                        : datoStr(codificar(prefijo)));
+        return ids == NULL ? vector<int>() : *ids;
+    }
+    string clave = codificar(prefijo);
+    vector<int> res;
+    for (auto it = _indicesStr.lower_bound(clave); it != _indicesStr.end() and
+             (*it).first.compare(0, clave.size(), clave) == 0; ++it) {
+        res.insert(res.end(), (*it).second.begin(), (*it).second.end());
+    }
+    sort(res.begin(), res.end());
+    return res;
+}
+
+MapaBits Indice::mapaQueCumple(const Restriccion &r) const {
+    if (r.esRango()) {
+        // Pocos datos distintos: se unen los mapas de los que cumplen
+        MapaBits res;
+        for (int i = 0; i < _cantHash; ++i) {
+            if (r.cumple(_clavesHash[i])) {
+                res = MapaBits::unir(res, _mapas[i]);
+            }
+        }
+        return res;
+    }
+    int entrada = _ranuras.empty() ? -1 : _ranuras[_ranura(r.dato())];
+    if (r.igual()) {
+        return entrada == -1 ? MapaBits() : _mapas[entrada];
+    }
+    return entrada == -1 ? _todos : MapaBits::restar(_todos, _mapas[entrada]);
 }
 
 bool Indice::noTieneRegistros(const Dato &d) const {
+    if (_tipo != ORDENADO) {
+        return buscar(d) == NULL;
+    }
     if (_esString){
         bool noTieneRegistros = _indicesStr.end() == _indicesStr.find(d.valorStr());
         if (!noTieneRegistros)
             noTieneRegistros = _indicesStr.at(d.valorStr()).empty();
         return noTieneRegistros;
     } else {
-        bool noTieneRegistros = _indicesNat.end() == _indicesNat.find(d.valorNat());
-        if (!noTieneRegistros)
-            noTieneRegistros = _indicesNat.at(d.valorNat()).empty();
-        return noTieneRegistros;
+        const vector<int> *ids = _indicesNat.buscar(d.valorNat());
+        return ids == NULL or ids->empty();
     }
 }
 
-void Indice::agregarRegistro(const_it_reg &r) {
-    if (_esString){
-        string valorCampo = r->dato(_campo).valorStr();
-        _indicesStr[valorCampo].insert(r);
-    }else{
-        int valorCampo = r->dato(_campo).valorNat();
-        _indicesNat[valorCampo].insert(r);
+Dato Indice::clave(int id) const {
+    if (_camposId.size() == 1) {
+        return _tabla->dato(id, _camposId[0]);
+    }
+    vector<Dato> datos;
+    for (const FieldId &campo : _camposId) {
+        datos.push_back(_tabla->dato(id, campo));
     }
-}
\ No newline at end of file
+    return datoStr(codificar(datos));
+}
+
+void Indice::indexarPorTramos(const vector<int> &ids, mutex &cerrojo) {
+    vector<pair<Dato, int> > pares;
+    pares.reserve(ids.size());
+    for (size_t desde = 0; desde < ids.size(); desde += REGISTROS_POR_TRAMO) {
+        size_t hasta = min(ids.size(), desde + REGISTROS_POR_TRAMO);
+        lock_guard<mutex> lectura(cerrojo);
+        for (size_t i = desde; i < hasta; ++i) {
+            pares.push_back(make_pair(clave(ids[i]), ids[i]));
+            _guardarValores(ids[i]);
+        }
+    }
+    // El orden y el armado de las listas no tocan la tabla
+    sort(pares.begin(), pares.end());
+    _agregarTramo(pares);
+}
+
+void Indice::reubicar(const Tabla &tab) {
+    _tabla = &tab;
+}
+
+void Indice::agregarRegistro(int id) {
+    agregarRegistro(id, clave(id));
+}
+
+void Indice::agregarRegistro(int id, const Dato &clave) {
+    _guardarValores(id);
+    if (_tipo == BITMAP) {
+        _marcar(id, clave, true);
+        return;
+    }
+    vector<int> &ids = _idsDe(clave);
+    auto it = lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() or *it != id) {
+        ids.insert(it, id);
+    }
+}
+
+void Indice::agregarRegistros(int desde, int hasta) {
+    for (int id = desde; id < hasta; ++id) {
+        _guardarValores(id);
+        if (_tipo == BITMAP) {
+            _marcar(id, clave(id), true);
+            continue;
+        }
+        _idsDe(clave(id)).push_back(id);
+    }
+}
+
+void Indice::borrarRegistro(int id) {
+    borrarRegistro(id, clave(id));
+}
+
+void Indice::borrarRegistro(int id, const Dato &clave) {
+    if (_tipo == BITMAP) {
+        _marcar(id, clave, false);
+        return;
+    }
+    vector<int> &ids = _idsDe(clave);
+    auto it = lower_bound(ids.begin(), ids.end(), id);
+    if (it != ids.end() and *it == id) {
+        ids.erase(it);
+    }
+}
+
+vector<int> Indice::intersecar(const vector<int> &a, const vector<int> &b) {
+    const vector<int> &chica = a.size() <= b.size() ? a : b;
+    const vector<int> &grande = a.size() <= b.size() ? b : a;
+    vector<int> res;
+    if (chica.empty()) {
+        return res;
+    }
+    size_t n = grande.size();
+    if (n / chica.size() >= SALTO_GALOPE) {
+        res.reserve(chica.size());
+        size_t desde = 0;
+        for (int id : chica) {
+            // Se duplica el salto hasta pasar el id y se busca en ese tramo
+            size_t hasta = desde;
+            size_t salto = 1;
+            while (hasta < n and grande[hasta] < id) {
+                desde = hasta + 1;
+                hasta = desde + salto;
+                salto *= 2;
+            }
+            desde = lower_bound(grande.begin() + desde,
+                                grande.begin() + min(hasta + 1, n), id) -
+                    grande.begin();
+            if (desde == n) {
+                break;
+            }
+            if (grande[desde] == id) {
+                res.push_back(id);
+                desde++;
+            }
+        }
+        return res;
+    }
+    // Se escribe siempre y se avanza según las comparaciones, sin saltos
+    // condicionales que el procesador tenga que predecir
+    res.resize(chica.size());
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+    while (i < chica.size() and j < n) {
+        int x = chica[i];
+        int y = grande[j];
+        res[k] = x;
+        k += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+    res.resize(k);
+    return res;
+}
+
+vector<int> Indice::intersecar(vector<const vector<int> *> listas) {
+    sort(listas.begin(), listas.end(),
+         [](const vector<int> *a, const vector<int> *b) {
+             return a->size() < b->size();
+         });
+    vector<int> res = *listas[0];
+    for (size_t i = 1; i < listas.size() and not res.empty(); ++i) {
+        res = intersecar(res, *listas[i]);
+    }
+    return res;
+}
+
+vector<int> Indice::unir(const vector<int> &a, const vector<int> &b) {
+    vector<int> res;
+    res.reserve(a.size() + b.size());
+    set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(res));
+    return res;
+}
+
+void Indice::_indexarTabla() {
+    vector<int> ids = _tabla->ids();
+    int hilos = min<int>(_hilos > 0 ? _hilos : thread::hardware_concurrency(),
+                         ids.size() / MIN_REGISTROS_POR_HILO);
+    if (hilos <= 1) {
+        // recorro todos los registros en la tabla y agrego el id de cada registro a la lista del indice
+        for (int id : ids) {
+            _guardarValores(id);
+            if (_tipo == BITMAP) {
+                _marcar(id, clave(id), true);
+            } else {
+                _idsDe(clave(id)).push_back(id);
+            }
+        }
+        return;
+    }
+
+    // Cada hilo solo lee la tabla y escribe su tramo y los valores de sus
+    // ids, que ya tienen lugar
+    _guardarValores(ids.back());
+    vector<vector<pair<Dato, int> > > tramos(hilos);
+    vector<thread> trabajadores;
+    for (int h = 0; h < hilos; ++h) {
+        trabajadores.push_back(thread([this, &ids, &tramos, h, hilos]() {
+            size_t desde = ids.size() * h / hilos;
+            size_t hasta = ids.size() * (h + 1) / hilos;
+            vector<pair<Dato, int> > &tramo = tramos[h];
+            tramo.reserve(hasta - desde);
+            for (size_t i = desde; i < hasta; ++i) {
+                tramo.push_back(make_pair(clave(ids[i]), ids[i]));
+                _guardarValores(ids[i]);
+            }
+            sort(tramo.begin(), tramo.end());
+        }));
+    }
+    for (thread &trabajador : trabajadores) {
+        trabajador.join();
+    }
+
+    for (const vector<pair<Dato, int> > &tramo : tramos) {
+        _agregarTramo(tramo);
+    }
+}
+
+void Indice::_agregarTramo(const vector<pair<Dato, int> > &tramo) {
+    size_t i = 0;
+    while (i < tramo.size()) {
+        size_t fin = i;
+        while (fin < tramo.size() and tramo[fin].first == tramo[i].first) {
+            fin++;
+        }
+        if (_tipo == BITMAP) {
+            int entrada = _entrada(tramo[i].first);
+            for (size_t j = i; j < fin; ++j) {
+                _mapas[entrada].agregar(tramo[j].second);
+                _todos.agregar(tramo[j].second);
+            }
+            _idsAlDia[entrada] = false;
+        } else {
+            vector<int> &lista = _idsDe(tramo[i].first);
+            for (size_t j = i; j < fin; ++j) {
+                lista.push_back(tramo[j].second);
+            }
+        }
+        i = fin;
+    }
+}
+
+void Indice::_guardarValores(int id) {
+    if (_incluidos.empty()) {
+        return;
+    }
+    size_t k = _campos.size() + _incluidos.size();
+    size_t base = (size_t) id * k;
+    if (_valores.size() < base + k) {
+        _valores.resize(max(base + k, 2 * _valores.size()), datoNat(0));
+    }
+    for (size_t j = 0; j < _camposId.size(); ++j) {
+        _valores[base + j] = _tabla->dato(id, _camposId[j]);
+    }
+    for (size_t j = 0; j < _incluidosId.size(); ++j) {
+        _valores[base + _camposId.size() + j] = _tabla->dato(id, _incluidosId[j]);
+    }
+}
+
+vector<int> &Indice::_idsDe(const Dato &d) {
+    if (_tipo == HASH) {
+        return _idsHash[_entrada(d)];
+    }
+    if (_esString)
+        return _indicesStr[d.valorStr()];
+    else
+        return _indicesNat[d.valorNat()];
+}
+
+int Indice::_entrada(const Dato &d) {
+    // Se mantiene la carga por debajo de 1/2 para que las búsquedas
+    // terminen en una o dos ranuras
+    if (2 * (_cantHash + 1) > (int) _ranuras.size()) {
+        _agrandarHash();
+    }
+    int ranura = _ranura(d);
+    if (_ranuras[ranura] == -1) {
+        _ranuras[ranura] = _cantHash++;
+        _clavesHash.push_back(d);
+        _idsHash.push_back(vector<int>());
+        if (_tipo == BITMAP) {
+            _mapas.push_back(MapaBits());
+            _idsAlDia.push_back(true);
+        }
+    }
+    return _ranuras[ranura];
+}
+
+void Indice::_marcar(int id, const Dato &clave, bool agregar) {
+    int entrada = _entrada(clave);
+    if (agregar) {
+        _mapas[entrada].agregar(id);
+        _todos.agregar(id);
+    } else {
+        _mapas[entrada].sacar(id);
+        _todos.sacar(id);
+    }
+    _idsAlDia[entrada] = false;
+}
+
+int Indice::_ranura(const Dato &d) const {
+    size_t mascara = _ranuras.size() - 1;
+    size_t ranura = hashDato(d) & mascara;
+    while (_ranuras[ranura] != -1 and not (_clavesHash[_ranuras[ranura]] == d)) {
+        ranura = (ranura + 1) & mascara;
+    }
+    return ranura;
+}
+
+void Indice::_agrandarHash() {
+    _ranuras.assign(_ranuras.empty() ? 16 : 2 * _ranuras.size(), -1);
+    for (int i = 0; i < _cantHash; ++i) {
+        _ranuras[_ranura(_clavesHash[i])] = i;
+    }
+}
+
+Indice::const_iterador::const_iterador() : tabla(NULL), pos(NULL) {}
+
+Indice::const_iterador::const_iterador(const Tabla *tabla, const int *pos) :
+        tabla(tabla), pos(pos) {}
+
+const_it_reg Indice::const_iterador::operator*() const {
+    return tabla->iterador(*pos);
+}
+
+int Indice::const_iterador::id() const {
+    return *pos;
+}
+
+Indice::const_iterador &Indice::const_iterador::operator++() {
+    ++pos;
+    return *this;
+}
+
+bool Indice::const_iterador::operator==(const const_iterador &o_it) const {
+    return pos == o_it.pos;
+}
+
+bool Indice::const_iterador::operator!=(const const_iterador &o_it) const {
+    return not (*this == o_it);
+}
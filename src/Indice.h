@@ -1,11 +1,15 @@
 #ifndef INDICE_H
 #define INDICE_H
 
+#include <mutex>
 #include <string>
+#include <vector>
 #include "string_map.h"
-#include <map>
+#include "ArbolBMas.h"
+#include "MapaBits.h"
 #include "Tabla.h"
 #include "Registro.h"
+#include "Restriccion.h"
 //#include <stdio.h>
 //#include <stdlib.h>
 #include "string"
@@ -15,16 +19,84 @@ using namespace std;
 /**
  *  @brief Representa un Indice de una Tabla en una Base de Datos.
  *
+ *  Para cada dato guarda los ids de los registros de la tabla con ese dato en
+ *  el campo indexado, ordenados de menor a mayor: 4 bytes por registro. Los
+ *  registros se obtienen de la tabla a partir de su id, así que el índice
+ *  queda asociado a la tabla con la que se construyó y se invalida si esta se
+ *  compacta.
+ *
+ *  Un índice ORDENADO busca los datos en un árbol B+ (nat) o un trie
+ *  (string).
+ *  Un índice HASH solo sirve para igualdades: busca los datos en una tabla
+ *  de hash con direccionamiento abierto, en \O(1) esperado.
+ *  Un índice BITMAP busca los datos igual que uno HASH, pero guarda los ids
+ *  de cada dato en un MapaBits: conviene en campos con pocos valores
+ *  distintos, donde las restricciones de un criterio se combinan con
+ *  operaciones sobre los mapas en lugar de revisar registro por registro.
+ *  Los ids de un dato como lista se arman recién cuando se piden, incluso
+ *  desde las consultas const, por lo que un índice BITMAP no admite
+ *  consultas desde varios hilos a la vez.
+ *
+ *  Un índice compuesto indexa la tupla de datos de varios campos. Cada tupla
+ *  se guarda como un string con codificar(), que preserva el orden y en el
+ *  que la codificación de un prefijo de la tupla es prefijo de la de la
+ *  tupla: un índice ORDENADO compuesto responde por cualquier prefijo de sus
+ *  campos con un solo recorrido del trie.
+ *
+ *  Un índice con campos incluidos (índice cubriente) guarda además, por
+ *  cada id indexado, los valores de sus campos y de los incluidos, uno
+ *  detrás de otro. Las búsquedas que solo miran esos campos se filtran y se
+ *  responden con esos valores, sin volver a los registros de la tabla.
+ *
  *  **se explica con** TAD Diccionario(Dato, Conjunto(puntero a Registro))
  */
 
 typedef Tabla::const_iterador_registros const_it_reg;
-typedef linear_set<const_it_reg>::const_iterator const_it_regInd;
 
 class Indice {
 
 public:
 
+    class const_iterador;
+
+    /**
+     * @brief Cociente de tamaños a partir del cual intersecar busca los ids
+     * de la lista chica en la grande en lugar de recorrer ambas.
+     */
+    static const int SALTO_GALOPE = 32;
+
+    /**
+     * @brief Cantidad mínima de registros por hilo al construir el índice:
+     * con menos, el costo de lanzar los hilos no se compensa.
+     */
+    static const int MIN_REGISTROS_POR_HILO = 1 << 14;
+
+    /**
+     * @brief Cantidad de registros que se leen por vez al indexar por tramos,
+     * mientras otro hilo puede estar modificando la tabla.
+     */
+    static const int REGISTROS_POR_TRAMO = 1 << 12;
+
+    /**
+     * @brief Memoria que se cuenta por cada dato distinto del índice, además
+     * de la de sus ids: nodo o ranura, lista y dato.
+     */
+    static const int BYTES_POR_CLAVE = 48;
+
+    /** @brief Estructura con la que se buscan los datos del índice. */
+    enum Tipo { ORDENADO, HASH, BITMAP };
+
+    /**
+     * @brief Fija la cantidad máxima de hilos con que se construyen los
+     * índices. Con 0 (el valor inicial) se usan tantos como núcleos tenga el
+     * procesador.
+     *
+     * \pre hilos \GEQ 0
+     *
+     * \complexity{\O(1)}
+     */
+    static void fijarHilos(int hilos);
+
     /**
      * @brief Inicializa un índice vacío
      *
@@ -33,17 +105,134 @@ public:
      *
      * \complexity{\O(1)}
      */
-    Indice() {}
+    Indice() : _tabla(NULL), _esString(false), _tipo(ORDENADO), _cantHash(0) {}
 
 
     /**
      * @brief Inicializa un índice en la tabla y el campo pasados como parametros
      *
+     * El campo se resuelve una sola vez contra el schema de la tabla.
+     *
      * \pre campo \IN campos(tab)
      *
+     * \complexity{\O(m * [L + log(m)]) si tipo es ORDENADO, \O(m * L)
+     * esperado si es HASH}
+     */
+    Indice(const Tabla &tab, const string &campo, bool esString,
+           Tipo tipo = ORDENADO);
+
+    /**
+     * @brief Inicializa un índice compuesto en la tabla y los campos pasados
+     * como parámetros, en ese orden
+     *
+     * Con un solo campo es igual al índice simple sobre ese campo. Si
+     * \P{incluidos} no es vacía, el índice guarda los valores de los campos
+     * indexados e incluidos de cada registro. Si \P{indexar} es falso el
+     * índice queda vacío, para llenarlo después con indexarPorTramos.
+     *
+     * \pre \LNOT vacía?(campos) \LAND cada campo de campos e incluidos \IN
+     *      campos(tab)
+     *
+     * \complexity{\O(m * [(c + i) * L + log(m)]) si tipo es ORDENADO,
+     * \O(m * (c + i) * L) esperado si es HASH, \O((c + i) * L) si no indexa}
+     */
+    Indice(const Tabla &tab, const vector<string> &campos, Tipo tipo = ORDENADO,
+           const vector<string> &incluidos = vector<string>(),
+           bool indexar = true);
+
+    /**
+     * @brief Campos indexados, en el orden de la tupla.
+     *
+     * \complexity{\O(1)}
+     */
+    const vector<string> &campos() const;
+
+    /**
+     * @brief Campos incluidos, cuyos valores se guardan sin indexarlos.
+     *
+     * \complexity{\O(1)}
+     */
+    const vector<string> &incluidos() const;
+
+    /**
+     * @brief Posición del campo entre los que el índice guarda valores: los
+     * indexados y después los incluidos. Si el índice no tiene incluidos, o
+     * el campo no es de esos, -1.
+     *
+     * \complexity{\O((c + i) * L)}
+     */
+    int cubierto(const string &campo) const;
+
+    /**
+     * @brief Valor guardado del campo cubierto de posición \P{cubierto} en
+     * el registro \P{id}.
+     *
+     * \pre \P{id} está en el índice \LAND 0 \LEQ cubierto \LT c + i \LAND
+     *      \LNOT vacía?(incluidos(\P{this}))
+     *
+     * \complexity{\O(1)}
+     */
+    const Dato &valor(int id, int cubierto) const;
+
+    /**
+     * @brief Deja en \P{ids} solo los que cumplen la restricción sobre el
+     * campo cubierto de posición \P{cubierto}, mirando los valores guardados
+     * en el índice y no la tabla.
+     *
+     * \pre cada id de \P{ids} está en el índice \LAND 0 \LEQ cubierto \LT
+     *      c + i \LAND \LNOT vacía?(incluidos(\P{this}))
+     *
+     * \complexity{\O(long(ids) * cmp(dato))}
+     */
+    void filtrar(vector<int> &ids, int cubierto, const Restriccion &r) const;
+
+    /**
+     * @brief Nombre con el que se guarda un índice sobre los campos: el
+     * campo, si es uno solo, o los campos separados por comas.
+     *
+     * \complexity{\O(c * L)}
+     */
+    static string nombre(const vector<string> &campos);
+
+    /**
+     * @brief Codificación de una tupla de datos como string.
+     *
+     * Cada dato se codifica sin ambigüedad: un nat como 6 caracteres de 6
+     * bits cada uno, y un string como sus caracteres con escape de los
+     * menores a 3 y los mayores a 124, seguidos de un terminador menor a
+     * todos. Así, comparar las codificaciones de dos tuplas del mismo tipo es
+     * compararlas campo a campo, y la codificación de un prefijo de una tupla
+     * es prefijo de la codificación de la tupla. La codificación no usa el
+     * caracter 0 ni caracteres mayores a 127, así que es una clave válida de
+     * string_map.
+     *
+     * \complexity{\O(c * L)}
+     */
+    static string codificar(const vector<Dato> &datos);
+
+    /**
+     * @brief Estructura con la que se buscan los datos del índice.
+     *
      * \complexity{\O(1)}
      */
-    Indice(const Tabla &tab, const string &campo, bool esString);
+    Tipo tipo() const;
+
+    /**
+     * @brief Memoria aproximada que ocupa el índice, en bytes: los ids (o
+     * los mapas), BYTES_POR_CLAVE por dato y los valores guardados.
+     *
+     * \complexity{\O(k * S), con k la cantidad de datos}
+     */
+    size_t bytes() const;
+
+    /**
+     * @brief Memoria que ocuparía un índice del tipo dado sobre
+     * \P{registros} registros con \P{distintos} datos distintos, medida como
+     * bytes().
+     *
+     * \complexity{\O(1)}
+     */
+    static size_t estimarBytes(int registros, double distintos, Tipo tipo);
 
 
     /**
@@ -60,9 +249,9 @@ public:
      *
      * \pre d \IN claves(\P{this})
      *
-     * \complexity{\O(1)}
+     * \complexity{\O(L + log(m))}
      */
-    const_it_regInd dameRegistros_begin(const Dato &d) const;
+    const_iterador dameRegistros_begin(const Dato &d) const;
 
 
     /**
@@ -70,17 +259,198 @@ public:
      *
      * \pre d \IN claves(\P{this})
      *
+     * \complexity{\O(L + log(m))}
+     */
+    const_iterador dameRegistros_end(const Dato &d) const;
+
+    /**
+     * @brief Devuelve el rango [begin, end) de los registros con dato d, con
+     * una sola búsqueda. Si d no tiene registros, el rango es vacío.
+     *
+     * \pre true
+     *
+     * \complexity{\O(L + log(m)) si tipo es ORDENADO, \O(L) esperado si es
+     * HASH}
+     */
+    pair<const_iterador, const_iterador> dameRegistros(const Dato &d) const;
+
+    /**
+     * @brief Ids de los registros con dato d, de menor a mayor.
+     *
+     * Se devuelven por referencia no-modificable, así que se pueden combinar
+     * con los de otros datos o índices de la misma tabla sin leer los
+     * registros.
+     *
+     * \pre d \IN claves(\P{this})
+     *
+     * \complexity{\O(L + log(m))}
+     */
+    const vector<int> &ids(const Dato &d) const;
+
+    /**
+     * @brief Ids de los registros con dato d, o NULL si no tiene registros.
+     *
+     * Resuelve con una sola búsqueda lo que noTieneRegistros e ids harían
+     * con dos.
+     *
+     * \pre true
+     *
+     * \complexity{\O(L + log(m)) si tipo es ORDENADO, \O(L) esperado si es
+     * HASH}
+     */
+    const vector<int> *buscar(const Dato &d) const;
+
+    /**
+     * @brief Cantidad de registros con dato d.
+     *
+     * \pre true
+     *
+     * \complexity{\O(L + log(m))}
+     */
+    int cantRegistros(const Dato &d) const;
+
+    /**
+     * @brief Ids de los registros cuyo dato cumple una restricción de rango,
+     * de menor a mayor.
+     *
+     * Baja una sola vez a la primera clave del rango y recorre en orden solo
+     * las claves del rango; después ordena los ids juntados.
+     *
+     * \pre tipo(\P{this}) = ORDENADO \LAND esRango(r) \LAND
+     *      Nat?(dato(r)) = Nat?(campo indexado)
+     * \post \P{res} son los ids indexados cuyo dato cumple r, ordenados
+     *
+     * \complexity{\O(L + log(m) + k * L + n * log(n)), con k las claves y n
+     * los ids del rango}
+     */
+    vector<int> idsQueCumplen(const Restriccion &r) const;
+
+    /**
+     * @brief Ids de los registros cuyos primeros long(prefijo) campos tienen
+     * los datos de \P{prefijo}, de menor a mayor.
+     *
+     * Si el prefijo fija todos los campos es una sola búsqueda; si no,
+     * recorre las claves del trie que empiezan con su codificación.
+     *
+     * \pre 1 \LEQ long(prefijo) \LEQ long(campos(\P{this})) \LAND cada dato
+     *      tiene el tipo de su campo \LAND (tipo(\P{this}) = HASH \IMPLIES
+     *      long(prefijo) = long(campos(\P{this})))
+     *
+     * \complexity{\O(c * L + log(m)) si fija todos los campos, \O(c * L + k *
+     * S + n * log(n)) si no, con k las claves y n los ids del prefijo}
+     */
+    vector<int> idsConPrefijo(const vector<Dato> &prefijo) const;
+
+    /**
+     * @brief Ids de los registros cuyo dato cumple la restricción, como mapa
+     * de bits.
+     *
+     * Una igualdad es el mapa de su dato; una desigualdad, el de todos los
+     * registros menos el de su dato; un rango o prefijo, la unión de los
+     * mapas de los datos que lo cumplen.
+     *
+     * \pre tipo(\P{this}) = BITMAP \LAND long(campos(\P{this})) = 1 \LAND
+     *      Nat?(dato(r)) = Nat?(campo indexado)
+     * \post \P{res} son los ids indexados cuyo dato cumple r
+     *
+     * \complexity{\O(L) esperado más el costo de las operaciones de mapas}
+     */
+    MapaBits mapaQueCumple(const Restriccion &r) const;
+
+
+    /**
+     * @brief Clave del registro \P{id} en el índice: su dato en el campo, o
+     * la codificación de su tupla si el índice es compuesto.
+     *
+     * \complexity{\O(c * L)}
+     */
+    Dato clave(int id) const;
+
+    /**
+     * @brief Indexa los registros \P{ids} leyendo la tabla de a
+     * REGISTROS_POR_TRAMO, con \P{cerrojo} tomado solo mientras se lee cada
+     * tramo. Así otro hilo puede modificar la tabla entre tramo y tramo si
+     * toma el mismo cerrojo.
+     *
+     * Se indexa cada registro con su clave al momento de leerlo: los cambios
+     * posteriores se ponen al día con agregarRegistro y borrarRegistro con
+     * las claves explícitas.
+     *
+     * \pre el índice no comparte ids con \P{ids} \LAND ningún id de \P{ids}
+     *      se compacta mientras se indexa
+     *
+     * \complexity{\O(n * [c * L + log(n)])}
+     */
+    void indexarPorTramos(const vector<int> &ids, mutex &cerrojo);
+
+    /**
+     * @brief Pasa a indexar \P{tab}, que tiene los mismos registros con los
+     * mismos ids que la tabla indexada hasta ahora.
+     *
+     * Se usa al instalar una tabla compactada aparte, cuyo índice se armó
+     * sobre la copia.
+     *
+     * \pre schema(tab) = schema de la tabla indexada \LAND registro(id, tab)
+     *      = registro(id) de la tabla indexada para todo id indexado
+     *
      * \complexity{\O(1)}
      */
-    const_it_regInd dameRegistros_end(const Dato &d) const;
+    void reubicar(const Tabla &tab);
 
+    /**
+     * @brief Agrega al indice el registro de la tabla con el id parámetro
+     *
+     * Si el registro ya estaba en el índice solo vuelve a leer los valores
+     * que guarda.
+     *
+     * \complexity{\O(L + log(m) + S)}
+     */
+    void agregarRegistro(int id);
 
     /**
-     * @brief Agrega el registro al indice
+     * @brief Agrega al índice el registro \P{id} con la clave pasada, que
+     * puede no ser la que tiene ahora en la tabla.
+     *
+     * Si el registro ya estaba con esa clave solo vuelve a leer de la tabla
+     * los valores que guarda.
      *
-     * \complexity{\O(S)}
+     * \complexity{\O(L + log(m) + S)}
      */
-    void agregarRegistro(const_it_reg &r);
+    void agregarRegistro(int id, const Dato &clave);
+
+    /**
+     * @brief Agrega al indice los registros con ids en [desde, hasta)
+     *
+     * Los registros del rango son nuevos en la tabla y tienen ids mayores a
+     * los de los registros indexados, así que se agregan al final de los ids
+     * de su dato sin buscarlos.
+     *
+     * \pre ningún registro del rango está en el índice \LAND los ids del
+     *      índice son menores a desde
+     *
+     * \complexity{\O(k * [L + log(m)]), con k el largo del rango}
+     */
+    void agregarRegistros(int desde, int hasta);
+
+    /**
+     * @brief Saca del indice el registro de la tabla con el id parámetro
+     *
+     * El registro se busca en los ids de su dato actual, así que hay que
+     * sacarlo antes de modificarlo.
+     *
+     * \pre el registro id está en el índice
+     *
+     * \complexity{\O(L + log(m) + S)}
+     */
+    void borrarRegistro(int id);
+
+    /**
+     * @brief Saca del índice el registro \P{id} de los ids de la clave
+     * pasada, si estaba.
+     *
+     * \complexity{\O(L + log(m) + S)}
+     */
+    void borrarRegistro(int id, const Dato &clave);
 
 
 
@@ -89,24 +459,98 @@ public:
      *
      * \pre d \IN claves(\P{this})
      *
-     * \complexity{\O(S)}
+     * \complexity{\O(L + log(m))}
      */
     bool noTieneRegistros(const Dato &d) const;
 
+    /**
+     * @brief Ids que están en ambas listas, de menor a mayor.
+     *
+     * Si las listas tienen tamaños parecidos las recorre juntas, avanzando
+     * sin saltos condicionales; si una es mucho más chica que la otra (al
+     * menos SALTO_GALOPE veces), busca cada id de la chica en la grande con
+     * búsqueda exponencial (galloping) desde el último encontrado.
+     *
+     * \pre a y b ordenados de forma estrictamente creciente
+     *
+     * \complexity{\O(min(long(a) + long(b), k * log(long(a) + long(b)))),
+     * con k el tamaño de la más chica}
+     */
+    static vector<int> intersecar(const vector<int> &a, const vector<int> &b);
+
+    /**
+     * @brief Ids que están en todas las listas, de menor a mayor.
+     *
+     * Se interseca de la lista más chica a la más grande, así cada paso
+     * parte del resultado más chico posible, y se corta si queda vacío.
+     *
+     * \pre \LNOT vacía?(listas) \LAND cada lista ordenada de forma
+     *      estrictamente creciente
+     *
+     * \complexity{\O(l * log(l) + suma de los costos de intersecar),
+     * con l = long(listas)}
+     */
+    static vector<int> intersecar(vector<const vector<int> *> listas);
+
+    /**
+     * @brief Ids que están en alguna de las listas, de menor a mayor.
+     *
+     * \pre a y b ordenados de forma estrictamente creciente
+     *
+     * \complexity{\O(long(a) + long(b))}
+     */
+    static vector<int> unir(const vector<int> &a, const vector<int> &b);
+
 private:
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////
     /** \name Representación
      * rep: indice \TO bool\n
      * rep(d) \EQUIV
+     * * _tabla != NULL \LAND
+     *  *
+     *  long(_campos) = long(_camposId) \GEQ 1 \LAND _camposId[i] es
+     *  _campos[i] resuelto contra el schema de *_tabla \LAND
+     *  (long(_campos) > 1 \IMPLIES _esString) \LAND
+     *  *
+     *  (_tipo != ORDENADO \IMPLIES _indicesNat = \EMPTYSET \LAND _indicesStr = \EMPTYSET) \LAND
+     *  *
+     *  (_tipo = BITMAP \IMPLIES long(_mapas) = long(_idsAlDia) = _cantHash
+     *  \LAND _todos es la unión de _mapas \LAND (_idsAlDia[i] \IMPLIES
+     *  _idsHash[i] = ids(_mapas[i]))) \LAND
+     *  (_tipo != BITMAP \IMPLIES vacía?(_mapas) \LAND vacío?(_todos)) \LAND
+     *  *
+     *  (_tipo = ORDENADO \IMPLIES vacía?(_ranuras) \LAND vacía?(_clavesHash)) \LAND
+     *  *
+     *  long(_incluidos) = long(_incluidosId) \LAND _incluidosId[i] es
+     *  _incluidos[i] resuelto contra el schema de *_tabla \LAND
+     *  (vacía?(_incluidos) \IMPLIES vacía?(_valores)) \LAND
+     *  (\LNOT vacía?(_incluidos) \IMPLIES para cada id indexado y cada j
+     *  \LT k = long(_campos) + long(_incluidos), _valores[id * k + j] es el
+     *  valor en registro(id, *_tabla) del j-ésimo campo de _campos seguido de
+     *  _incluidos) \LAND
+     *  *
+     *  long(_clavesHash) = long(_idsHash) = _cantHash \LAND _clavesHash sin
+     *  repetidos \LAND (vacía?(_ranuras) \LOR long(_ranuras) es potencia de 2
+     *  mayor a 2 * _cantHash) \LAND cada entrada i de _clavesHash está en
+     *  la primera ranura libre o con entrada i a partir de
+     *  hashDato(_clavesHash[i]) mod long(_ranuras), recorriendo en forma
+     *  circular \LAND
+     *  *
+     *  (\FORALL ids : vector(nat)) ids es significado de _indicesStr o de
+     *  _indicesNat o está en _idsHash \IMPLIES ids está ordenado de forma estrictamente creciente
+     *  \LAND cada id es de un registro no borrado de *_tabla \LAND
+     *
      * * _esString = true \IMPLIES
      *  *
      *  _indicesNat = \EMPTYSET \LAND
      *  *
      *  (\FORALL s : string) def?(s, _indicesStr) \IMPLIES
      *   *
-     *   (\FORALL p : puntero(Registro)) p \IN obtener(s, _indicesStr) \IMPLIES
-     *   _campo \IN campos(*p) \LAND valor(_campo, *p) = datoString(s)
+     *   (\FORALL id : nat) id \IN obtener(s, _indicesStr) \IMPLIES
+     *   (long(_campos) = 1 \IMPLIES valor(_campos[0], registro(id, *_tabla))
+     *   = datoString(s)) \LAND (long(_campos) > 1 \IMPLIES s = codificar(los
+     *   valores de _campos en registro(id, *_tabla)))
      *
      * * _esString = false \IMPLIES
      *  *
@@ -114,8 +558,8 @@ private:
      *  *
      *  (\FORALL n : nat) def?(n, _indicesNat) \IMPLIES
      *   *
-     *   (\FORALL p : puntero(Registro)) p \IN obtener(n, _indicesNat) \IMPLIES
-     *   _campo \IN campos(*p) \LAND valor(_campo, *p) = datoNat(n)
+     *   (\FORALL id : nat) id \IN obtener(n, _indicesNat) \IMPLIES
+     *   valor(_campos[0], registro(id, *_tabla)) = datoNat(n)
      *
      *
      *
@@ -123,30 +567,224 @@ private:
      * abs(d) \EQUIV d' \|
      *  (\FORALL dat : Dato)
      *  * def?(dat, d') \IFF
+     *       (_tipo = HASH \LAND dat \IN _clavesHash) \LOR
      *       Nat?(dat) \IMPLIES def?(dat, _indicesNat) \LOR String?(dat) \IMPLIES def?(dat, _indicesStr) \LAND
      *
-     *  * def?(dat, d') \IMPLIES
+     *  * def?(dat, d') \IMPLIES obtener(dat, d') es el conjunto de punteros
+     *       a registro(id, *_tabla) para cada id en
      *       *
-     *        Nat?(dat) \IMPLIES obtener(dat, d') = obtener(dat, _indicesNat) \LOR
+     *        Nat?(dat) \IMPLIES obtener(dat, _indicesNat) \LOR
      *       *
-     *        String?(dat) \IMPLIES obtener(dat, d') = obtener(dat, _indicesStr)
+     *        String?(dat) \IMPLIES obtener(dat, _indicesStr)
+     *       *
+     *        (o _idsHash[i] con _clavesHash[i] = dat, si _tipo = HASH)
      */
     //////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+    /** @brief Máximo de hilos de construcción fijado, o 0. */
+    static int _hilos;
+
     /** @{ */
 
-    /** @brief Define si el campo es string. */
+    /** @brief Tabla indexada. */
+    const Tabla *_tabla;
+    /** @brief Define si las claves son strings (campo string o compuesto). */
     bool _esString;
-    /** @brief Nombre del campo. */
-    string _campo;
-    /** @brief Diccionario si el campo es nat. */
-    map<int, linear_set<const_it_reg> > _indicesNat;
+    /** @brief Nombres de los campos. */
+    vector<string> _campos;
+    /** @brief Campos resueltos contra el schema de la tabla indexada. */
+    vector<FieldId> _camposId;
+    /** @brief Nombres de los campos incluidos. */
+    vector<string> _incluidos;
+    /** @brief Campos incluidos resueltos contra el schema de la tabla. */
+    vector<FieldId> _incluidosId;
+    /**
+     * @brief Valores de los campos indexados e incluidos de cada id, de a
+     * long(_campos) + long(_incluidos) por id (si hay incluidos).
+     */
+    vector<Dato> _valores;
+    /** @brief Diccionario si el campo es nat, como árbol B+. */
+    ArbolBMas _indicesNat;
     /** @brief Diccionario si el campo es string. */
-    string_map<linear_set<const_it_reg> > _indicesStr;
+    string_map<vector<int> > _indicesStr;
+    /** @brief Estructura con la que se buscan los datos. */
+    Tipo _tipo;
+    /**
+     * @brief Ranuras de la tabla de hash (HASH): posición del dato en
+     * _clavesHash, o -1 si está libre.
+     */
+    vector<int> _ranuras;
+    /** @brief Datos del índice, en orden de aparición (HASH). */
+    vector<Dato> _clavesHash;
+    /**
+     * @brief Ids de los registros de cada dato de _clavesHash (HASH), o su
+     * copia como lista, armada al pedirla (BITMAP).
+     */
+    mutable vector<vector<int> > _idsHash;
+    /** @brief Ids de los registros de cada dato de _clavesHash (BITMAP). */
+    vector<MapaBits> _mapas;
+    /** @brief Unión de _mapas (BITMAP). */
+    MapaBits _todos;
+    /** @brief Define si _idsHash[i] refleja _mapas[i] (BITMAP). */
+    mutable vector<bool> _idsAlDia;
+    /** @brief Cantidad de datos en la tabla de hash (HASH). */
+    int _cantHash;
 
     /** @} */
+
+    /**
+     * @brief Indexa los registros vivos de la tabla.
+     *
+     * Si la tabla es grande, reparte los ids en tramos contiguos entre
+     * varios hilos: cada uno lee los datos de su tramo y los ordena. Después
+     * se agregan los tramos en orden de id, una búsqueda por dato distinto
+     * de cada tramo, así cada lista de ids queda ordenada sin reordenarla.
+     *
+     * \complexity{\O(m * [c * L + log(m)]), repartido entre los hilos salvo
+     * el agregado final}
+     */
+    void _indexarTabla();
+
+    /**
+     * @brief Agrega los registros de un tramo, ordenado por clave y id. Los
+     * ids del tramo son mayores a los ya indexados con la misma clave, así
+     * que se agregan al final de su lista.
+     *
+     * \complexity{\O(n * c * L + k * [L + log(m)]), con k las claves
+     * distintas del tramo}
+     */
+    void _agregarTramo(const vector<pair<Dato, int> > &tramo);
+
+    /**
+     * @brief Lee de la tabla los valores que el índice guarda del registro
+     * \P{id}. Si _valores ya alcanza para el id no lo agranda, así que
+     * varios hilos pueden guardar ids distintos a la vez.
+     *
+     * \complexity{\O((c + i) * L) amortizado}
+     */
+    void _guardarValores(int id);
+
+    /**
+     * @brief Ranura de la tabla de hash donde está el dato, o la ranura libre
+     * donde debería agregarse.
+     *
+     * \pre \LNOT vacía?(_ranuras)
+     *
+     * \complexity{\O(L) esperado}
+     */
+    int _ranura(const Dato &d) const;
+
+    /**
+     * @brief Duplica las ranuras de la tabla de hash y vuelve a ubicar los
+     * datos.
+     *
+     * \complexity{\O(_cantHash) esperado}
+     */
+    void _agrandarHash();
+
+    /**
+     * @brief Ids de los registros con el dato parámetro, creándolos vacíos si
+     * el dato no estaba.
+     *
+     * \pre tipo(\P{this}) != BITMAP
+     *
+     * \complexity{\O(L + log(m))}
+     */
+    vector<int> &_idsDe(const Dato &d);
+
+    /**
+     * @brief Posición del dato en _clavesHash, agregándolo si no estaba.
+     *
+     * \pre tipo(\P{this}) != ORDENADO
+     *
+     * \complexity{\O(L) esperado}
+     */
+    int _entrada(const Dato &d);
+
+    /**
+     * @brief Agrega o saca el registro \P{id} del mapa de la clave (BITMAP).
+     *
+     * \complexity{\O(L + MAX_ARREGLO) esperado}
+     */
+    void _marcar(int id, const Dato &clave, bool agregar);
 };
 
+/**
+ * @brief Iterador de los registros de un dato de un índice, en orden de id.
+ *
+ * Desreferenciarlo devuelve un iterador al registro en la tabla indexada.
+ */
+class Indice::const_iterador {
+
+public:
+    using iterator_category = forward_iterator_tag;
+    using value_type = const_it_reg;
+    using difference_type = ptrdiff_t;
+    using pointer = const const_it_reg*;
+    using reference = const_it_reg;
+
+    /**
+     * @brief Iterador que no apunta a ningún índice.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador();
+
+    /**
+     * @brief Iterador al registro apuntado, en la tabla indexada.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    const_it_reg operator*() const;
+
+    /**
+     * @brief Id del registro apuntado.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    int id() const;
+
+    /**
+     * @brief Avanza el iterador al siguiente registro del dato.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador &operator++();
+
+    /**
+     * @brief Comparación entre iteradores.
+     *
+     * \complexity{\O(1)}
+     */
+    bool operator==(const const_iterador &o_it) const;
+
+    /**
+     * @brief Comparación entre iteradores.
+     *
+     * \complexity{\O(1)}
+     */
+    bool operator!=(const const_iterador &o_it) const;
+
+private:
+    friend class Indice;
+
+    const_iterador(const Tabla *tabla, const int *pos);
+
+    /** @brief Tabla indexada. */
+    const Tabla *tabla;
+
+    /** @brief Id apuntado dentro de los ids del dato. */
+    const int *pos;
+};
+
+typedef Indice::const_iterador const_it_regInd;
+
 
 #endif // INDICE_H
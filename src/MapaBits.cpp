@@ -0,0 +1,325 @@
+#include "MapaBits.h"
+#include <algorithm>
+#include <iterator>
+
+const int MapaBits::MAX_ARREGLO;
+const int MapaBits::PALABRAS;
+
+MapaBits::MapaBits() {}
+
+void MapaBits::agregar(int id) {
+    int alto = id >> 16;
+    uint16_t bajo = id & 0xFFFF;
+    int i = _buscar(alto);
+    if (i == (int) _contenedores.size() or _contenedores[i].alto != alto) {
+        Contenedor c;
+        c.alto = alto;
+        c.cant = 0;
+        _contenedores.insert(_contenedores.begin() + i, c);
+    }
+    Contenedor &c = _contenedores[i];
+    if (not c.bits.empty()) {
+        uint64_t &palabra = c.bits[bajo / 64];
+        if (not (palabra >> (bajo % 64) & 1)) {
+            palabra |= uint64_t(1) << (bajo % 64);
+            c.cant++;
+        }
+        return;
+    }
+    auto it = lower_bound(c.arreglo.begin(), c.arreglo.end(), bajo);
+    if (it == c.arreglo.end() or *it != bajo) {
+        c.arreglo.insert(it, bajo);
+        c.cant++;
+        _normalizar(c);
+    }
+}
+
+void MapaBits::sacar(int id) {
+    int alto = id >> 16;
+    uint16_t bajo = id & 0xFFFF;
+    int i = _buscar(alto);
+    if (i == (int) _contenedores.size() or _contenedores[i].alto != alto) {
+        return;
+    }
+    Contenedor &c = _contenedores[i];
+    if (not c.bits.empty()) {
+        uint64_t &palabra = c.bits[bajo / 64];
+        if (palabra >> (bajo % 64) & 1) {
+            palabra &= ~(uint64_t(1) << (bajo % 64));
+            c.cant--;
+            _normalizar(c);
+        }
+    } else {
+        auto it = lower_bound(c.arreglo.begin(), c.arreglo.end(), bajo);
+        if (it != c.arreglo.end() and *it == bajo) {
+            c.arreglo.erase(it);
+            c.cant--;
+        }
+    }
+    if (c.cant == 0) {
+        _contenedores.erase(_contenedores.begin() + i);
+    }
+}
+
+bool MapaBits::contiene(int id) const {
+    int alto = id >> 16;
+    uint16_t bajo = id & 0xFFFF;
+    int i = _buscar(alto);
+    if (i == (int) _contenedores.size() or _contenedores[i].alto != alto) {
+        return false;
+    }
+    const Contenedor &c = _contenedores[i];
+    if (not c.bits.empty()) {
+        return c.bits[bajo / 64] >> (bajo % 64) & 1;
+    }
+    return binary_search(c.arreglo.begin(), c.arreglo.end(), bajo);
+}
+
+int MapaBits::cardinal() const {
+    int res = 0;
+    for (const Contenedor &c : _contenedores) {
+        res += c.cant;
+    }
+    return res;
+}
+
+bool MapaBits::vacio() const {
+    return _contenedores.empty();
+}
+
+vector<int> MapaBits::ids() const {
+    vector<int> res;
+    res.reserve(cardinal());
+    for (const Contenedor &c : _contenedores) {
+        int base = c.alto << 16;
+        if (c.bits.empty()) {
+            for (uint16_t bajo : c.arreglo) {
+                res.push_back(base + bajo);
+            }
+            continue;
+        }
+        for (int p = 0; p < PALABRAS; ++p) {
+            uint64_t palabra = c.bits[p];
+            while (palabra != 0) {
+                // Se recorren solo los bits en 1, del menor al mayor
+                res.push_back(base + p * 64 + __builtin_ctzll(palabra));
+                palabra &= palabra - 1;
+            }
+        }
+    }
+    return res;
+}
+
+size_t MapaBits::bytes() const {
+    size_t res = 0;
+    for (const Contenedor &c : _contenedores) {
+        res += c.arreglo.size() * sizeof(uint16_t) +
+               c.bits.size() * sizeof(uint64_t);
+    }
+    return res;
+}
+
+MapaBits MapaBits::intersecar(const MapaBits &a, const MapaBits &b) {
+    MapaBits res;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a._contenedores.size() and j < b._contenedores.size()) {
+        const Contenedor &ca = a._contenedores[i];
+        const Contenedor &cb = b._contenedores[j];
+        if (ca.alto < cb.alto) {
+            i++;
+        } else if (cb.alto < ca.alto) {
+            j++;
+        } else {
+            Contenedor c = _intersecar(ca, cb);
+            if (c.cant > 0) {
+                res._contenedores.push_back(c);
+            }
+            i++;
+            j++;
+        }
+    }
+    return res;
+}
+
+MapaBits MapaBits::restar(const MapaBits &a, const MapaBits &b) {
+    MapaBits res;
+    size_t j = 0;
+    for (const Contenedor &ca : a._contenedores) {
+        while (j < b._contenedores.size() and b._contenedores[j].alto < ca.alto) {
+            j++;
+        }
+        if (j == b._contenedores.size() or b._contenedores[j].alto != ca.alto) {
+            res._contenedores.push_back(ca);
+            continue;
+        }
+        Contenedor c = _restar(ca, b._contenedores[j]);
+        if (c.cant > 0) {
+            res._contenedores.push_back(c);
+        }
+    }
+    return res;
+}
+
+MapaBits MapaBits::unir(const MapaBits &a, const MapaBits &b) {
+    MapaBits res;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a._contenedores.size() or j < b._contenedores.size()) {
+        if (j == b._contenedores.size() or
+            (i < a._contenedores.size() and
+             a._contenedores[i].alto < b._contenedores[j].alto)) {
+            res._contenedores.push_back(a._contenedores[i++]);
+        } else if (i == a._contenedores.size() or
+                   b._contenedores[j].alto < a._contenedores[i].alto) {
+            res._contenedores.push_back(b._contenedores[j++]);
+        } else {
+            res._contenedores.push_back(
+                _unir(a._contenedores[i++], b._contenedores[j++]));
+        }
+    }
+    return res;
+}
+
+bool MapaBits::operator==(const MapaBits &otro) const {
+    if (_contenedores.size() != otro._contenedores.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < _contenedores.size(); ++i) {
+        const Contenedor &a = _contenedores[i];
+        const Contenedor &b = otro._contenedores[i];
+        if (a.alto != b.alto or a.cant != b.cant or a.arreglo != b.arreglo or
+            a.bits != b.bits) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int MapaBits::_buscar(int alto) const {
+    int desde = 0;
+    int hasta = _contenedores.size();
+    while (desde < hasta) {
+        int medio = (desde + hasta) / 2;
+        if (_contenedores[medio].alto < alto) {
+            desde = medio + 1;
+        } else {
+            hasta = medio;
+        }
+    }
+    return desde;
+}
+
+void MapaBits::_normalizar(Contenedor &c) {
+    if (c.bits.empty() and c.cant > MAX_ARREGLO) {
+        c.bits.assign(PALABRAS, 0);
+        for (uint16_t bajo : c.arreglo) {
+            c.bits[bajo / 64] |= uint64_t(1) << (bajo % 64);
+        }
+        c.arreglo = vector<uint16_t>();
+    } else if (not c.bits.empty() and c.cant <= MAX_ARREGLO) {
+        c.arreglo.clear();
+        c.arreglo.reserve(c.cant);
+        for (int p = 0; p < PALABRAS; ++p) {
+            uint64_t palabra = c.bits[p];
+            while (palabra != 0) {
+                c.arreglo.push_back(p * 64 + __builtin_ctzll(palabra));
+                palabra &= palabra - 1;
+            }
+        }
+        c.bits = vector<uint64_t>();
+    }
+}
+
+MapaBits::Contenedor MapaBits::_intersecar(const Contenedor &a,
+                                           const Contenedor &b) {
+    Contenedor res;
+    res.alto = a.alto;
+    res.cant = 0;
+    if (not a.bits.empty() and not b.bits.empty()) {
+        res.bits.resize(PALABRAS);
+        for (int p = 0; p < PALABRAS; ++p) {
+            res.bits[p] = a.bits[p] & b.bits[p];
+            res.cant += __builtin_popcountll(res.bits[p]);
+        }
+        _normalizar(res);
+    } else if (a.bits.empty() and b.bits.empty()) {
+        set_intersection(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(),
+                         b.arreglo.end(), back_inserter(res.arreglo));
+        res.cant = res.arreglo.size();
+    } else {
+        // Se recorre el arreglo y se consulta el mapa
+        const Contenedor &arreglo = a.bits.empty() ? a : b;
+        const Contenedor &mapa = a.bits.empty() ? b : a;
+        for (uint16_t bajo : arreglo.arreglo) {
+            if (mapa.bits[bajo / 64] >> (bajo % 64) & 1) {
+                res.arreglo.push_back(bajo);
+            }
+        }
+        res.cant = res.arreglo.size();
+    }
+    return res;
+}
+
+MapaBits::Contenedor MapaBits::_restar(const Contenedor &a,
+                                       const Contenedor &b) {
+    Contenedor res;
+    res.alto = a.alto;
+    res.cant = 0;
+    if (a.bits.empty()) {
+        for (uint16_t bajo : a.arreglo) {
+            bool enB = b.bits.empty()
+                           ? binary_search(b.arreglo.begin(), b.arreglo.end(), bajo)
+                           : (b.bits[bajo / 64] >> (bajo % 64) & 1);
+            if (not enB) {
+                res.arreglo.push_back(bajo);
+            }
+        }
+        res.cant = res.arreglo.size();
+        return res;
+    }
+    res.bits = a.bits;
+    if (b.bits.empty()) {
+        for (uint16_t bajo : b.arreglo) {
+            res.bits[bajo / 64] &= ~(uint64_t(1) << (bajo % 64));
+        }
+    } else {
+        for (int p = 0; p < PALABRAS; ++p) {
+            res.bits[p] &= ~b.bits[p];
+        }
+    }
+    for (int p = 0; p < PALABRAS; ++p) {
+        res.cant += __builtin_popcountll(res.bits[p]);
+    }
+    _normalizar(res);
+    return res;
+}
+
+MapaBits::Contenedor MapaBits::_unir(const Contenedor &a, const Contenedor &b) {
+    Contenedor res;
+    res.alto = a.alto;
+    res.cant = 0;
+    if (a.bits.empty() and b.bits.empty()) {
+        set_union(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(),
+                  b.arreglo.end(), back_inserter(res.arreglo));
+        res.cant = res.arreglo.size();
+        _normalizar(res);
+        return res;
+    }
+    res.bits.assign(PALABRAS, 0);
+    for (const Contenedor *c : {&a, &b}) {
+        if (c->bits.empty()) {
+            for (uint16_t bajo : c->arreglo) {
+                res.bits[bajo / 64] |= uint64_t(1) << (bajo % 64);
+            }
+        } else {
+            for (int p = 0; p < PALABRAS; ++p) {
+                res.bits[p] |= c->bits[p];
+            }
+        }
+    }
+    for (int p = 0; p < PALABRAS; ++p) {
+        res.cant += __builtin_popcountll(res.bits[p]);
+    }
+    return res;
+}
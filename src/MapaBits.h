@@ -0,0 +1,176 @@
+#ifndef MAPABITS_H
+#define MAPABITS_H
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Conjunto de ids comprimido, al estilo de los Roaring bitmaps.
+ *
+ * Los ids se agrupan por sus 16 bits altos. Cada grupo es un contenedor con
+ * los 16 bits bajos de sus ids, que se guarda de una de dos formas:
+ *  * arreglo ordenado, si tiene hasta MAX_ARREGLO ids (2 bytes por id);
+ *  * mapa de 2^16 bits (8 KB), si tiene más.
+ *
+ * Así un conjunto ocupa a lo sumo 2 bytes por id o 1 bit por id posible, lo
+ * que sea menor. La intersección, la diferencia y la unión se hacen
+ * contenedor por contenedor; entre mapas de bits, de a palabras de 64 bits.
+ *
+ * **se explica con** Conjunto(nat)
+ */
+class MapaBits {
+
+public:
+
+    /** @brief Máxima cantidad de ids de un contenedor guardado como arreglo. */
+    static const int MAX_ARREGLO = 4096;
+
+    /**
+     * @brief Inicializa un conjunto vacío.
+     *
+     * \complexity{\O(1)}
+     */
+    MapaBits();
+
+    /**
+     * @brief Agrega un id al conjunto.
+     *
+     * \pre id \GEQ 0
+     * \post \P{this} = agregar(id, \P{this}')
+     *
+     * \complexity{\O(C + MAX_ARREGLO), con C la cantidad de contenedores}
+     */
+    void agregar(int id);
+
+    /**
+     * @brief Saca un id del conjunto, si estaba.
+     *
+     * \pre id \GEQ 0
+     * \post \P{this} = \P{this}' - {id}
+     *
+     * \complexity{\O(C + MAX_ARREGLO)}
+     */
+    void sacar(int id);
+
+    /**
+     * @brief Indica si el id está en el conjunto.
+     *
+     * \complexity{\O(log(C) + log(MAX_ARREGLO))}
+     */
+    bool contiene(int id) const;
+
+    /**
+     * @brief Cantidad de ids del conjunto.
+     *
+     * \complexity{\O(C)}
+     */
+    int cardinal() const;
+
+    /**
+     * @brief Indica si el conjunto no tiene ids.
+     *
+     * \complexity{\O(1)}
+     */
+    bool vacio() const;
+
+    /**
+     * @brief Ids del conjunto, de menor a mayor.
+     *
+     * \complexity{\O(n + C * 2^16 / 64)}
+     */
+    vector<int> ids() const;
+
+    /**
+     * @brief Memoria que ocupan los contenedores, en bytes.
+     *
+     * \complexity{\O(C)}
+     */
+    size_t bytes() const;
+
+    /**
+     * @brief Ids que están en ambos conjuntos.
+     *
+     * \complexity{\O(C_a + C_b + tamaño de los contenedores comunes)}
+     */
+    static MapaBits intersecar(const MapaBits &a, const MapaBits &b);
+
+    /**
+     * @brief Ids de \P{a} que no están en \P{b}.
+     *
+     * \complexity{\O(C_a + C_b + tamaño de los contenedores)}
+     */
+    static MapaBits restar(const MapaBits &a, const MapaBits &b);
+
+    /**
+     * @brief Ids que están en alguno de los conjuntos.
+     *
+     * \complexity{\O(C_a + C_b + tamaño de los contenedores)}
+     */
+    static MapaBits unir(const MapaBits &a, const MapaBits &b);
+
+    bool operator==(const MapaBits &otro) const;
+
+private:
+
+    /** @brief Palabras de 64 bits de un contenedor guardado como mapa. */
+    static const int PALABRAS = 1024;
+
+    /** @brief Ids con los mismos 16 bits altos. */
+    struct Contenedor {
+        /** @brief 16 bits altos de los ids. */
+        int alto;
+        /** @brief Cantidad de ids. */
+        int cant;
+        /** @brief 16 bits bajos de los ids, ordenados, si cant \LEQ MAX_ARREGLO. */
+        vector<uint16_t> arreglo;
+        /** @brief Mapa de los 16 bits bajos, si cant \GT MAX_ARREGLO. */
+        vector<uint64_t> bits;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: mapabits \TO bool\n
+     * rep(m) \EQUIV
+     *  * _contenedores está ordenado de forma estrictamente creciente por
+     *    alto \LAND ningún contenedor tiene cant = 0 \LAND
+     *  * para cada contenedor c:
+     *    * c.cant \LEQ MAX_ARREGLO \IMPLIES vacía?(c.bits) \LAND
+     *      long(c.arreglo) = c.cant \LAND c.arreglo estrictamente creciente
+     *    * c.cant \GT MAX_ARREGLO \IMPLIES vacía?(c.arreglo) \LAND
+     *      long(c.bits) = PALABRAS \LAND c.cant es la cantidad de bits en 1
+     *
+     * abs: mapabits \TO Conjunto(nat)\n
+     * abs(m) \EQUIV {c.alto * 2^16 + b \| c \IN _contenedores \LAND b \IN
+     *  c.arreglo o el bit b de c.bits está en 1}
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    vector<Contenedor> _contenedores;
+    /** @} */
+
+    /**
+     * @brief Posición del contenedor de \P{alto}, o la posición donde
+     * debería insertarse.
+     *
+     * \complexity{\O(log(C))}
+     */
+    int _buscar(int alto) const;
+
+    /**
+     * @brief Pasa el contenedor a la forma que le corresponde según su
+     * cantidad de ids.
+     *
+     * \complexity{\O(2^16 / 64 + MAX_ARREGLO)}
+     */
+    static void _normalizar(Contenedor &c);
+
+    /** @brief Intersección, diferencia y unión de contenedores de igual alto. */
+    static Contenedor _intersecar(const Contenedor &a, const Contenedor &b);
+    static Contenedor _restar(const Contenedor &a, const Contenedor &b);
+    static Contenedor _unir(const Contenedor &a, const Contenedor &b);
+};
+
+#endif // MAPABITS_H
@@ -0,0 +1,51 @@
+#include "Particionado.h"
+#include <algorithm>
+
+Particionado::Particionado() : _tipo(NINGUNO), _cantidad(1) {}
+
+Particionado Particionado::porHash(const string &campo, int cantidad) {
+    Particionado res;
+    res._tipo = HASH;
+    res._campo = campo;
+    res._cantidad = cantidad;
+    return res;
+}
+
+Particionado Particionado::porRangos(const string &campo,
+                                     const vector<int> &limites) {
+    Particionado res;
+    res._tipo = RANGOS;
+    res._campo = campo;
+    res._cantidad = limites.size() + 1;
+    res._limites = limites;
+    return res;
+}
+
+Particionado::Tipo Particionado::tipo() const {
+    return _tipo;
+}
+
+const string &Particionado::campo() const {
+    return _campo;
+}
+
+int Particionado::cantParticiones() const {
+    return _cantidad;
+}
+
+int Particionado::particion(const Dato &valor) const {
+    switch (_tipo) {
+        case HASH:
+            return hashDato(valor) % _cantidad;
+        case RANGOS:
+            return upper_bound(_limites.begin(), _limites.end(),
+                               valor.valorNat()) - _limites.begin();
+        default:
+            return 0;
+    }
+}
+
+bool Particionado::mismoEsquema(const Particionado &otro) const {
+    return _tipo == otro._tipo and _cantidad == otro._cantidad and
+           _limites == otro._limites;
+}
@@ -0,0 +1,133 @@
+#ifndef PARTICIONADO_H
+#define PARTICIONADO_H
+
+#include <string>
+#include <vector>
+#include "Dato.h"
+
+using namespace std;
+
+/**
+ * @brief Describe cómo se reparten los registros de una tabla en particiones.
+ *
+ * Una tabla puede particionarse por un campo, por hash del dato en ese campo
+ * (en una cantidad fija de particiones) o por rangos de un campo nat. Cada
+ * registro pertenece a una única partición, determinada por su dato en el
+ * campo de particionado, así que una igualdad sobre ese campo solo puede
+ * cumplirse en una partición.
+ *
+ * **se explica con** TAD Particionado
+ */
+class Particionado {
+
+public:
+
+    /** @brief Forma de asignar los registros a las particiones. */
+    enum Tipo { NINGUNO, HASH, RANGOS };
+
+    /**
+     * @brief Particionado trivial: todos los registros van a la partición 0.
+     *
+     * \pre true
+     * \post tipo(\P{res}) = NINGUNO \LAND cantParticiones(\P{res}) = 1
+     *
+     * \complexity{\O(1)}
+     */
+    Particionado();
+
+    /**
+     * @brief Particionado por hash del dato en \P{campo}.
+     *
+     * \pre cantidad \GT 0
+     * \post tipo(\P{res}) = HASH \LAND cantParticiones(\P{res}) = cantidad
+     *
+     * \complexity{\O(copy(campo))}
+     */
+    static Particionado porHash(const string &campo, int cantidad);
+
+    /**
+     * @brief Particionado por rangos de un campo nat.
+     *
+     * La partición i tiene los valores v con limites[i - 1] \LEQ v \LT
+     * limites[i]; la primera y la última no tienen cota inferior y superior,
+     * respectivamente.
+     *
+     * \pre limites ordenados de forma estrictamente creciente
+     * \post tipo(\P{res}) = RANGOS \LAND
+     *       cantParticiones(\P{res}) = long(limites) + 1
+     *
+     * \complexity{\O(copy(campo) + long(limites))}
+     */
+    static Particionado porRangos(const string &campo,
+                                  const vector<int> &limites);
+
+    /**
+     * @brief Forma de asignar los registros a las particiones.
+     *
+     * \complexity{\O(1)}
+     */
+    Tipo tipo() const;
+
+    /**
+     * @brief Campo de particionado. Se devuelve por referencia no-modificable.
+     *
+     * \pre tipo(\P{this}) != NINGUNO
+     *
+     * \complexity{\O(1)}
+     */
+    const string &campo() const;
+
+    /**
+     * @brief Cantidad de particiones.
+     *
+     * \complexity{\O(1)}
+     */
+    int cantParticiones() const;
+
+    /**
+     * @brief Partición a la que pertenece un registro con \P{valor} en el
+     * campo de particionado.
+     *
+     * \pre tipo(\P{this}) = RANGOS \IMPLIES Nat?(valor)
+     * \post 0 \LEQ \P{res} \LT cantParticiones(\P{this})
+     *
+     * \complexity{\O(1) si tipo es NINGUNO, \O(L) si es HASH,
+     * \O(log(cantParticiones)) si es RANGOS}
+     */
+    int particion(const Dato &valor) const;
+
+    /**
+     * @brief Indica si dos particionados asignan cada valor a la misma
+     * partición, sin importar el nombre del campo.
+     *
+     * \complexity{\O(cantParticiones)}
+     */
+    bool mismoEsquema(const Particionado &otro) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: particionado \TO bool\n
+     * rep(p) \EQUIV
+     *  * _cantidad \GT 0 \LAND
+     *  * (_tipo = NINGUNO \IMPLIES _cantidad = 1) \LAND
+     *  * (_tipo = RANGOS \IMPLIES _cantidad = long(_limites) + 1 \LAND
+     *    _limites ordenados de forma estrictamente creciente) \LAND
+     *  * (_tipo != RANGOS \IMPLIES vacía?(_limites))
+     *
+     * abs: particionado \TO Particionado\n
+     * abs(p) \EQUIV p' \| tipo(p') = _tipo \LAND campo(p') = _campo \LAND
+     *   cantParticiones(p') = _cantidad \LAND la partición de cada valor se
+     *   calcula según _tipo
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    Tipo _tipo;
+    string _campo;
+    int _cantidad;
+    vector<int> _limites;
+    /** @} */
+};
+
+#endif // PARTICIONADO_H
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <stdexcept>
 #include "Registro.h"
 #include "utils.h"
 
@@ -6,34 +7,62 @@ using namespace std;
 
 
 
-Registro::Registro(const vector<string>& campos, const vector<Dato>& datos){
-    for (int i = 0; i < campos.size(); ++i) {
-        _campos.insert(campos[i]);
-        _camposYdatos.insert(make_pair(campos[i], datos[i]));
+Registro::Registro(const vector<string>& campos, const vector<Dato>& datos) :
+        _schema(make_shared<const Schema>(campos)) {
+    _datos.reserve(_schema->cantCampos());
+    for (size_t i = 0; i < campos.size(); ++i) {
+        int ordinal = _schema->ordinal(campos[i]);
+        if (ordinal < (int) _datos.size()) {
+            // Campo repetido: vale el último dato
+            _datos[ordinal] = datos[i];
+        } else {
+            _datos.push_back(datos[i]);
+        }
     }
 };
 
+Registro::Registro(const Schema& schema, const vector<Dato>& datos) :
+        _schema(schema.shared_from_this()), _datos(datos) {};
+
 
 
 const Dato& Registro::dato(const string& campo) const {
-    return _camposYdatos.at(campo);
+    int ordinal = _schema->ordinal(campo);
+    if (ordinal == -1) {
+        throw out_of_range("Registro::dato: campo inexistente " + campo);
+    }
+    return _datos[ordinal];
+}
+
+
+const Dato& Registro::dato(const FieldId& id) const {
+    if (id.schema() == _schema.get()) {
+        return _datos[id.ordinal()];
+    }
+    return dato(id.campo());
 }
 
 
 const linear_set<string> Registro::campos() const {
-    return _campos;
+    return _schema->campos();
+}
+
+const shared_ptr<const Schema>& Registro::schema() const {
+    return _schema;
 }
 
 
 bool operator==(const Registro& r1, const Registro& r2) {
-    linear_set<string> c1 = r1.campos();
-    linear_set<string> c2 = r2.campos();
-    if (not (c1 == c2)) {
+    const Schema& s1 = *r1._schema;
+    const Schema& s2 = *r2._schema;
+    if (&s1 == &s2) {
+        return r1._datos == r2._datos;
+    }
+    if (not s1.mismosCampos(s2)) {
         return false;
     }
-    linear_set<string> campos = r1.campos();
-    for (auto c : campos) {
-        if (r1.dato(c) != r2.dato(c)) {
+    for (int i = 0; i < s1.cantCampos(); ++i) {
+        if (r1._datos[i] != r2._datos[s2.ordinal(s1.campo(i))]) {
             return false;
         }
     }
@@ -41,7 +70,7 @@ bool operator==(const Registro& r1, const Registro& r2) {
 }
 
 
-ostream &operator<<(ostream &os, const Registro &r) {
+ostream &operator<<(ostream &os, const Registro &) {
     //os toma un linear_set
     //os << r._campoYdato.significados();
     return os;
@@ -2,11 +2,11 @@
 #define _REGISTRO_H
 
 #include <vector>
+#include <memory>
 #include <iostream>
 #include "Dato.h"
+#include "Schema.h"
 #include "linear_set.h"
-#include "linear_map.h"
-#include "string_map.h"
 
 using namespace std;
 
@@ -14,7 +14,8 @@ using namespace std;
  * @brief Representa un registro de una tabla.
  *
  * Un registro asocia campos identificados con un string con valores
- * específicos.
+ * específicos. Los valores se guardan en un arreglo indexado por los
+ * ordinales de un Schema, que los registros de una misma tabla comparten.
  *
  * **se explica con** TAD Diccionario(string, Dato)
  */
@@ -26,25 +27,72 @@ public:
     /**
      * @brief Genera un nuevo registro con los campos y valores designados.
      *
+     * El registro tiene su propio schema. Si un campo aparece repetido, vale
+     * el último dato asociado.
+     *
      * \pre long(campos) = long(datos)
      * \post \P{res} = nuevoRegistro(campos, datos)
      *
-     * \complexity{\O(long(campos) * (copy(campo) + copy(dato)))}
+     * \complexity{\O(long(campos)^2 * L + long(campos) * (copy(campo) + copy(dato)))}
      */
     Registro(const vector<string>& campos, const vector<Dato>& datos);
 
+    /**
+     * @brief Genera un nuevo registro sobre un schema existente.
+     *
+     * El dato i-ésimo corresponde al campo de ordinal i del schema. El
+     * registro comparte el schema en lugar de copiarlo, por lo que el schema
+     * debe pertenecer a un shared_ptr (como todo schema creado con
+     * make_shared); si no, el comportamiento no está definido.
+     *
+     * \pre long(datos) = cantCampos(schema) \LAND schema pertenece a un
+     * shared_ptr
+     * \post \P{res} = nuevoRegistro(schema, datos)
+     *
+     * \complexity{\O(long(datos) * copy(dato))}
+     */
+    Registro(const Schema& schema, const vector<Dato>& datos);
+
     /**
      * @brief Devuelve el dato asociado a un campo.
      *
-     * Devuelve el dato por referencia no modificable.
+     * Devuelve el dato por referencia no modificable. Pedir un campo que no
+     * está en el registro lanza out_of_range.
      *
      * \pre campo \in campos(\P{this})
      * \post \P{res} = valor(campo, \P{this})
      * 
-     * \complexity{\O(1)}
+     * \complexity{\O(C * L)}
      */
     const Dato& dato(const string& campo) const;
 
+    /**
+     * @brief Devuelve el dato asociado a un campo ya resuelto.
+     *
+     * Si el registro comparte el schema del campo el acceso es directo por
+     * ordinal. Si no, se busca el campo por nombre.
+     *
+     * Devuelve el dato por referencia no modificable.
+     *
+     * \pre campo(id) \in campos(\P{this})
+     * \post \P{res} = valor(campo(id), \P{this})
+     *
+     * \complexity{\O(1) si schema(id) = schema(\P{this}), \O(C * L) sino}
+     */
+    const Dato& dato(const FieldId& id) const;
+
+    /**
+     * @brief Devuelve el schema del registro.
+     *
+     * Se devuelve por referencia no modificable.
+     *
+     * \pre true
+     * \post campos(\P{res}) = campos(\P{this})
+     *
+     * \complexity{\O(1)}
+     */
+    const shared_ptr<const Schema>& schema() const;
+
     /**
      * @brief Devuelve los campos definidos en un registro
      *
@@ -53,7 +101,7 @@ public:
      * \pre true
      * \post \P{res} = campos(\P{this})
      *
-     * \complexity{\O(1)}
+     * \complexity{\O(C * copy(campo))}
      */
     const linear_set<string> campos() const;
 
@@ -63,23 +111,26 @@ private:
     /** \name Representación
      * rep: registro \TO bool\n
      * rep(d) \EQUIV 
-     *  * _campos = claves(_campoYdato)
+     *  * _schema != NULL \LAND long(_datos) = cantCampos(*_schema)
      *
      * abs: registro \TO Registro\n
      * abs(r) \EQUIV r' \|
-     *  * campos(r') = _campos \LAND
-     *  * \FORALL (c : string) def?(c, _campoYdato) \IMPLIES valor(c, r') =
-     *  obtener(c, _campoYdato)
+     *  * campos(r') = campos(*_schema) \LAND
+     *  * \FORALL (i : nat) 0 \LEQ i \LT long(_datos) \IMPLIES
+     *    valor(campo(i, *_schema), r') = _datos[i]
      */
     //////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /** @{ */
-    string_map<Dato> _camposYdatos;
-    linear_set<string> _campos;
+    /** @brief Schema que da el ordinal de cada campo. */
+    shared_ptr<const Schema> _schema;
+    /** @brief Datos del registro, indexados por ordinal. */
+    vector<Dato> _datos;
     /** @} */
 
 
 
+    friend bool operator==(const Registro&, const Registro&);
     friend ostream &operator<<(ostream &, const Registro &);
 
 };
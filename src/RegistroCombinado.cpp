@@ -0,0 +1,58 @@
+#include "RegistroCombinado.h"
+
+RegistroCombinado::RegistroCombinado(const Registro &prioritario,
+                                     const Registro &otro) :
+        _prioritario(&prioritario), _otro(&otro) {}
+
+const Dato &RegistroCombinado::dato(const string &campo) const {
+    if (_prioritario->schema()->ordinal(campo) != -1) {
+        return _prioritario->dato(campo);
+    }
+    return _otro->dato(campo);
+}
+
+const Dato &RegistroCombinado::dato(const FieldId &id) const {
+    if (id.schema() == _prioritario->schema().get()) {
+        return _prioritario->dato(id);
+    }
+    int ordinal = _prioritario->schema()->ordinal(id.campo());
+    if (ordinal != -1) {
+        return _prioritario->dato(FieldId(*_prioritario->schema(), ordinal));
+    }
+    return _otro->dato(id);
+}
+
+const linear_set<string> RegistroCombinado::campos() const {
+    linear_set<string> res = _prioritario->campos();
+    const Schema &otro = *_otro->schema();
+    for (int i = 0; i < otro.cantCampos(); ++i) {
+        if (_prioritario->schema()->ordinal(otro.campo(i)) == -1) {
+            res.fast_insert(otro.campo(i));
+        }
+    }
+    return res;
+}
+
+Registro RegistroCombinado::materializar() const {
+    const Schema &prioritario = *_prioritario->schema();
+    const Schema &otro = *_otro->schema();
+    vector<string> campos;
+    vector<Dato> datos;
+    for (int i = 0; i < prioritario.cantCampos(); ++i) {
+        FieldId id(prioritario, i);
+        campos.push_back(id.campo());
+        datos.push_back(_prioritario->dato(id));
+    }
+    for (int i = 0; i < otro.cantCampos(); ++i) {
+        FieldId id(otro, i);
+        if (prioritario.ordinal(id.campo()) == -1) {
+            campos.push_back(id.campo());
+            datos.push_back(_otro->dato(id));
+        }
+    }
+    return Registro(campos, datos);
+}
+
+RegistroCombinado::operator Registro() const {
+    return materializar();
+}
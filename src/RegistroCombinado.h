@@ -0,0 +1,117 @@
+#ifndef REGISTROCOMBINADO_H
+#define REGISTROCOMBINADO_H
+
+#include <string>
+#include "Dato.h"
+#include "Schema.h"
+#include "Registro.h"
+#include "linear_set.h"
+
+using namespace std;
+
+/**
+ * @brief Vista de la combinación de dos registros.
+ *
+ * Representa al registro que tiene los campos de ambos registros, donde ante
+ * campos repetidos vale el dato del registro prioritario. No copia ningún
+ * dato: referencia a los dos registros originales y resuelve cada campo al
+ * consultarlo. Solo se arma un Registro nuevo al materializarla.
+ *
+ * **se explica con** TAD Diccionario(string, Dato)
+ */
+class RegistroCombinado {
+
+public:
+
+    /**
+     * @brief Combina dos registros sin copiarlos.
+     *
+     * La vista tiene aliasing con ambos registros.
+     *
+     * \pre true
+     * \post \P{res} = combinar(prioritario, otro)
+     *
+     * \complexity{\O(1)}
+     */
+    RegistroCombinado(const Registro &prioritario, const Registro &otro);
+
+    /**
+     * @brief Devuelve el dato asociado a un campo.
+     *
+     * Devuelve el dato por referencia no modificable.
+     *
+     * \pre campo \IN campos(\P{this})
+     * \post \P{res} = valor(campo, \P{this})
+     *
+     * \complexity{\O(C * L)}
+     */
+    const Dato &dato(const string &campo) const;
+
+    /**
+     * @brief Devuelve el dato asociado a un campo ya resuelto.
+     *
+     * Devuelve el dato por referencia no modificable.
+     *
+     * \pre campo(id) \IN campos(\P{this})
+     * \post \P{res} = valor(campo(id), \P{this})
+     *
+     * \complexity{\O(1) si id se resolvió contra el schema del registro
+     * prioritario, \O(C * L) sino}
+     */
+    const Dato &dato(const FieldId &id) const;
+
+    /**
+     * @brief Devuelve los campos de la combinación.
+     *
+     * \pre true
+     * \post \P{res} = campos(prioritario) ∪ campos(otro)
+     *
+     * \complexity{\O(C^2 * L)}
+     */
+    const linear_set<string> campos() const;
+
+    /**
+     * @brief Arma un Registro con los campos y datos de la combinación.
+     *
+     * \pre true
+     * \post campos(\P{res}) = campos(\P{this}) \LAND
+     *       \FORALL (c : campo) c \IN campos(\P{res}) \IMPLIES
+     *       valor(c, \P{res}) = valor(c, \P{this})
+     *
+     * \complexity{\O(C^2 * L + C * copy(dato))}
+     */
+    Registro materializar() const;
+
+    /**
+     * @brief Conversión a Registro, para usar la vista donde se espera un
+     * Registro. Equivale a materializar().
+     *
+     * \complexity{\O(C^2 * L + C * copy(dato))}
+     */
+    operator Registro() const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: registrocombinado \TO bool\n
+     * rep(r) \EQUIV _prioritario != NULL \LAND _otro != NULL
+     *
+     * abs: registrocombinado \TO Diccionario(string, Dato)\n
+     * abs(r) \EQUIV r' \|
+     *  * campos(r') = campos(*_prioritario) ∪ campos(*_otro) \LAND
+     *  * \FORALL (c : campo) c \IN campos(*_prioritario) \IMPLIES
+     *    valor(c, r') = valor(c, *_prioritario) \LAND
+     *  * \FORALL (c : campo) c \IN campos(*_otro) - campos(*_prioritario)
+     *    \IMPLIES valor(c, r') = valor(c, *_otro)
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    /** @brief Registro cuyos datos valen ante campos repetidos. */
+    const Registro *_prioritario;
+    /** @brief Registro que completa los campos restantes. */
+    const Registro *_otro;
+    /** @} */
+};
+
+#endif // REGISTROCOMBINADO_H
@@ -2,7 +2,13 @@
 #include <tuple>
 
 Restriccion::Restriccion(const string &campo, const Dato &dato, bool igual)
-    : _campo(campo), _dato(dato), _igual(igual){};
+    : _campo(campo), _dato(dato), _igual(igual),
+      _operador(igual ? IGUAL : DISTINTO), _hasta(dato){};
+
+Restriccion::Restriccion(const string &campo, Operador operador,
+                         const Dato &dato, const Dato &hasta)
+    : _campo(campo), _dato(dato), _igual(operador == IGUAL),
+      _operador(operador), _hasta(operador == ENTRE ? hasta : dato){};
 
 const string &Restriccion::campo() const { return _campo; }
 
@@ -10,14 +16,42 @@ const Dato &Restriccion::dato() const { return _dato; }
 
 const bool &Restriccion::igual() const { return _igual; }
 
+Restriccion::Operador Restriccion::operador() const { return _operador; }
+
+const Dato &Restriccion::hasta() const { return _hasta; }
+
+bool Restriccion::esRango() const {
+  return _operador != IGUAL and _operador != DISTINTO;
+}
+
+bool Restriccion::cumple(const Dato &d) const {
+  switch (_operador) {
+  case IGUAL:
+    return d == _dato;
+  case DISTINTO:
+    return not(d == _dato);
+  case MENOR:
+    return d < _dato;
+  case MAYOR:
+    return _dato < d;
+  case ENTRE:
+    return not(d < _dato) and not(_hasta < d);
+  case PREFIJO:
+    return d.esString() and
+           d.valorStr().compare(0, _dato.valorStr().size(), _dato.valorStr()) ==
+               0;
+  }
+  return false;
+}
+
 bool operator==(const Restriccion &r1, const Restriccion &r2) {
   return (r1.campo() == r2.campo() and r1.dato() == r2.dato() and
-          r1.igual() == r2.igual());
+          r1.operador() == r2.operador() and r1.hasta() == r2.hasta());
 }
 
 bool operator<(const Restriccion &r1, const Restriccion &r2) {
-  return (make_tuple(r1.campo(), r1.dato(), r1.igual()) <
-          make_tuple(r2.campo(), r2.dato(), r2.igual()));
+  return (make_tuple(r1.campo(), r1.dato(), r1.operador(), r1.hasta()) <
+          make_tuple(r2.campo(), r2.dato(), r2.operador(), r2.hasta()));
 }
 
 Restriccion Rig(const string &campo, const string &valor) {
@@ -32,3 +66,32 @@ Restriccion Rdif(const string &campo, const string &valor) {
 Restriccion Rdif(const string &campo, const int &valor) {
   return Restriccion(campo, datoNat(valor), false);
 }
+Restriccion Rmenor(const string &campo, const string &valor) {
+  return Restriccion(campo, Restriccion::MENOR, datoStr(valor),
+                     datoStr(valor));
+}
+Restriccion Rmenor(const string &campo, const int &valor) {
+  return Restriccion(campo, Restriccion::MENOR, datoNat(valor),
+                     datoNat(valor));
+}
+Restriccion Rmayor(const string &campo, const string &valor) {
+  return Restriccion(campo, Restriccion::MAYOR, datoStr(valor),
+                     datoStr(valor));
+}
+Restriccion Rmayor(const string &campo, const int &valor) {
+  return Restriccion(campo, Restriccion::MAYOR, datoNat(valor),
+                     datoNat(valor));
+}
+Restriccion Rentre(const string &campo, const string &desde,
+                   const string &hasta) {
+  return Restriccion(campo, Restriccion::ENTRE, datoStr(desde),
+                     datoStr(hasta));
+}
+Restriccion Rentre(const string &campo, const int &desde, const int &hasta) {
+  return Restriccion(campo, Restriccion::ENTRE, datoNat(desde),
+                     datoNat(hasta));
+}
+Restriccion Rprefijo(const string &campo, const string &prefijo) {
+  return Restriccion(campo, Restriccion::PREFIJO, datoStr(prefijo),
+                     datoStr(prefijo));
+}
@@ -13,6 +13,14 @@ class Restriccion {
 
 public:
 
+    /**
+     * @brief Comparación que la restricción pide entre el dato de un campo y
+     * el dato de la restricción.
+     *
+     * ENTRE incluye ambos extremos. PREFIJO solo se aplica a strings.
+     */
+    enum Operador {IGUAL, DISTINTO, MENOR, MAYOR, ENTRE, PREFIJO};
+
     /**
      * @brief Constructor de Restricción
      *
@@ -23,6 +31,20 @@ public:
      */
     Restriccion(const string& campo, const Dato& dato, bool igual);
 
+    /**
+     * @brief Constructor de Restricción con un operador cualquiera
+     *
+     * \P{hasta} solo se usa si el operador es ENTRE.
+     *
+     * \pre Nat?(dato) = Nat?(hasta) \LAND (operador = PREFIJO \IMPLIES
+     *      \LNOT Nat?(dato))
+     * \post \P{this} == nueva(campo, operador, dato, hasta)
+     *
+     * \complexity{\O(L)}
+     */
+    Restriccion(const string& campo, Operador operador, const Dato& dato,
+                const Dato& hasta);
+
     /**
      * @brief Observador campo
      *
@@ -59,23 +81,71 @@ public:
      */
     const bool& igual() const;
 
+    /**
+     * @brief Observador operador
+     *
+     * \pre true
+     * \post \P{res} == operador(\P{this})
+     *
+     * \complexity{\O(1)}
+     */
+    Operador operador() const;
+
+    /**
+     * @brief Extremo superior de una restricción ENTRE
+     *
+     * En los demás operadores es igual a dato(\P{this}).
+     *
+     * \pre true
+     * \post \P{res} == hasta(\P{this})
+     *
+     * \complexity{\O(1)}
+     */
+    const Dato& hasta() const;
+
+    /**
+     * @brief Indica si la restricción pide un rango de valores (MENOR, MAYOR,
+     * ENTRE o PREFIJO), que un índice ordenado puede recorrer en orden.
+     *
+     * \complexity{\O(1)}
+     */
+    bool esRango() const;
+
+    /**
+     * @brief Indica si \P{d} cumple la restricción.
+     *
+     * \pre Nat?(d) = Nat?(dato(\P{this}))
+     * \post \P{res} \IFF d cumple la comparación del operador con dato (y
+     *       hasta) de \P{this}
+     *
+     * \complexity{\O(cmp(dato))}
+     */
+    bool cumple(const Dato& d) const;
+
 private:
     ///////////////////////////////////////////////////////////////////////////////////////////////////
     /** \name Representación
      * rep: restricción \TO bool\n
-     * rep(r) \EQUIV true
+     * rep(r) \EQUIV (_igual \IFF _operador = IGUAL) \LAND
+     *  Nat?(_dato) = Nat?(_hasta) \LAND
+     *  (_operador = PREFIJO \IMPLIES \LNOT Nat?(_dato)) \LAND
+     *  (_operador != ENTRE \IMPLIES _hasta = _dato)
      *
      * abs: restricción \TO Restricción \n
      * abs(r) \EQUIV r' \|
      *  * campo(r') = _campo \LAND
      *  * dato(r') = _dato \LAND
-     *  * porIgual(r') = _igual
+     *  * porIgual(r') = _igual \LAND
+     *  * operador(r') = _operador \LAND
+     *  * hasta(r') = _hasta
      */
     //////////////////////////////////////////////////////////////////////////////////////////////////////
     /** @{ */
     string _campo;
     Dato _dato;
     bool _igual;
+    Operador _operador;
+    Dato _hasta;
     /** @} */
    
 };
@@ -87,5 +157,13 @@ Restriccion Rig(const string& campo, const string& valor);
 Restriccion Rig(const string& campo, const int& valor);
 Restriccion Rdif(const string& campo, const string& valor);
 Restriccion Rdif(const string& campo, const int& valor);
+Restriccion Rmenor(const string& campo, const string& valor);
+Restriccion Rmenor(const string& campo, const int& valor);
+Restriccion Rmayor(const string& campo, const string& valor);
+Restriccion Rmayor(const string& campo, const int& valor);
+Restriccion Rentre(const string& campo, const string& desde,
+                   const string& hasta);
+Restriccion Rentre(const string& campo, const int& desde, const int& hasta);
+Restriccion Rprefijo(const string& campo, const string& prefijo);
 
 #endif 
@@ -0,0 +1,70 @@
+#include "Schema.h"
+
+FieldId::FieldId() : _schema(nullptr), _ordinal(-1) {}
+
+FieldId::FieldId(const Schema& schema, int ordinal) :
+        _schema(&schema), _ordinal(ordinal) {}
+
+const Schema* FieldId::schema() const {
+    return _schema;
+}
+
+int FieldId::ordinal() const {
+    return _ordinal;
+}
+
+const string& FieldId::campo() const {
+    return _schema->campo(_ordinal);
+}
+
+Schema::Schema(const vector<string>& campos) {
+    for (const string& c : campos) {
+        if (ordinal(c) == -1) {
+            _campos.push_back(c);
+        }
+    }
+}
+
+int Schema::cantCampos() const {
+    return _campos.size();
+}
+
+const string& Schema::campo(int ordinal) const {
+    return _campos[ordinal];
+}
+
+int Schema::ordinal(const string& campo) const {
+    for (size_t i = 0; i < _campos.size(); ++i) {
+        if (_campos[i].size() == campo.size() and _campos[i] == campo) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+FieldId Schema::id(const string& campo) const {
+    return FieldId(*this, ordinal(campo));
+}
+
+linear_set<string> Schema::campos() const {
+    linear_set<string> res;
+    for (const string& c : _campos) {
+        res.fast_insert(c);
+    }
+    return res;
+}
+
+bool Schema::mismosCampos(const Schema& otro) const {
+    if (this == &otro) {
+        return true;
+    }
+    if (cantCampos() != otro.cantCampos()) {
+        return false;
+    }
+    for (const string& c : _campos) {
+        if (otro.ordinal(c) == -1) {
+            return false;
+        }
+    }
+    return true;
+}
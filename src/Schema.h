@@ -0,0 +1,192 @@
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "linear_set.h"
+
+using namespace std;
+
+class Schema;
+
+/**
+ * @brief Campo resuelto contra un schema.
+ *
+ * Se obtiene una sola vez, al empezar una consulta (por ejemplo con
+ * Tabla::campoId), y permite acceder al dato de los registros con ese schema
+ * sin volver a buscar el campo por nombre.
+ *
+ * **se explica con** Tupla(Schema, nat)
+ */
+class FieldId {
+
+public:
+
+    /**
+     * @brief Campo inválido, que no corresponde a ningún schema.
+     *
+     * \complexity{\O(1)}
+     */
+    FieldId();
+
+    /**
+     * @brief Campo de ordinal \P{ordinal} del schema parámetro.
+     *
+     * \pre 0 \LEQ ordinal \LT cantCampos(schema)
+     *
+     * \complexity{\O(1)}
+     */
+    FieldId(const Schema& schema, int ordinal);
+
+    /**
+     * @brief Schema contra el que se resolvió el campo.
+     *
+     * \complexity{\O(1)}
+     */
+    const Schema* schema() const;
+
+    /**
+     * @brief Ordinal del campo en su schema.
+     *
+     * \complexity{\O(1)}
+     */
+    int ordinal() const;
+
+    /**
+     * @brief Nombre del campo.
+     *
+     * Se devuelve por referencia no modificable.
+     *
+     * \pre schema(\P{this}) != NULL
+     *
+     * \complexity{\O(1)}
+     */
+    const string& campo() const;
+
+private:
+    /** @{ */
+    /** @brief Schema al que pertenece el campo. No es dueño del schema. */
+    const Schema* _schema;
+    /** @brief Ordinal del campo en _schema. */
+    int _ordinal;
+    /** @} */
+};
+
+/**
+ * @brief Describe los campos de un conjunto de registros.
+ *
+ * Un schema asigna a cada nombre de campo un ordinal entre 0 y la cantidad de
+ * campos. Los registros guardan sus datos en un arreglo indexado por esos
+ * ordinales y comparten el schema (normalmente el de su tabla), de forma que
+ * los nombres de los campos se guardan una sola vez.
+ *
+ * Los schemas siempre se crean con make_shared, para que los registros
+ * construidos a partir de una referencia puedan compartirlos.
+ *
+ * **se explica con** Secu(string) sin repetidos
+ */
+class Schema : public enable_shared_from_this<Schema> {
+
+public:
+
+    /**
+     * @brief Genera un schema con los campos designados.
+     *
+     * Si un campo aparece repetido se considera solo su primera aparición.
+     *
+     * \pre true
+     * \post los campos de \P{res} son los de campos, sin repetidos y en el
+     * mismo orden
+     *
+     * \complexity{\O(long(campos)^2 * L)}
+     */
+    explicit Schema(const vector<string>& campos);
+
+    /**
+     * @brief Cantidad de campos del schema.
+     *
+     * \pre true
+     * \post \P{res} = long(\P{this})
+     *
+     * \complexity{\O(1)}
+     */
+    int cantCampos() const;
+
+    /**
+     * @brief Nombre del campo con el ordinal parámetro.
+     *
+     * Se devuelve por referencia no modificable.
+     *
+     * \pre 0 \LEQ ordinal \LT cantCampos(\P{this})
+     * \post \P{res} = \P{this}[ordinal]
+     *
+     * \complexity{\O(1)}
+     */
+    const string& campo(int ordinal) const;
+
+    /**
+     * @brief Ordinal del campo parámetro, o -1 si el campo no está.
+     *
+     * Los schemas tienen pocos campos, por lo que recorrerlos comparando
+     * primero la longitud resulta más barato que mantener un diccionario.
+     *
+     * \pre true
+     * \post (esta?(campo, \P{this}) \LAND \P{this}[\P{res}] = campo) \LOR
+     * (\LNOT esta?(campo, \P{this}) \LAND \P{res} = -1)
+     *
+     * \complexity{\O(C * L)}
+     */
+    int ordinal(const string& campo) const;
+
+    /**
+     * @brief Campo resuelto para acceder a los registros de este schema.
+     *
+     * El resultado es válido mientras viva el schema.
+     *
+     * \pre ordinal(campo) != -1
+     * \post schema(\P{res}) = \P{this} \LAND ordinal(\P{res}) = ordinal(campo)
+     *
+     * \complexity{\O(C * L)}
+     */
+    FieldId id(const string& campo) const;
+
+    /**
+     * @brief Conjunto de los campos del schema.
+     *
+     * \pre true
+     * \post \P{res} = los elementos de \P{this}
+     *
+     * \complexity{\O(C * copy(campo))}
+     */
+    linear_set<string> campos() const;
+
+    /**
+     * @brief Indica si ambos schemas tienen los mismos campos, en cualquier
+     * orden.
+     *
+     * \pre true
+     * \post \P{res} = (campos(\P{this}) = campos(otro))
+     *
+     * \complexity{\O(C^2 * L)}
+     */
+    bool mismosCampos(const Schema& otro) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: schema \TO bool\n
+     * rep(s) \EQUIV sinRepetidos(_campos)
+     *
+     * abs: schema \TO Secu(string)\n
+     * abs(s) \EQUIV _campos
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    /** @brief Nombres de los campos, indexados por ordinal. */
+    vector<string> _campos;
+    /** @} */
+};
+
+#endif // SCHEMA_H
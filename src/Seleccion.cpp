@@ -0,0 +1,90 @@
+#include "Seleccion.h"
+
+Seleccion::Seleccion(const Tabla &tabla, vector<int> ids) :
+        _tabla(&tabla), _ids(move(ids)),
+        _compactaciones(tabla.compactaciones()) {}
+
+const Tabla &Seleccion::tabla() const {
+    return *_tabla;
+}
+
+const vector<int> &Seleccion::ids() const {
+    return _ids;
+}
+
+bool Seleccion::idsVigentes() const {
+    return _compactaciones == _tabla->compactaciones();
+}
+
+const linear_set<string> Seleccion::campos() const {
+    return _tabla->campos();
+}
+
+const linear_set<string> Seleccion::claves() const {
+    return _tabla->claves();
+}
+
+int Seleccion::cant_registros() const {
+    return _ids.size();
+}
+
+Seleccion::const_iterador_registros Seleccion::registros_begin() const {
+    return const_iterador_registros(this, 0);
+}
+
+Seleccion::const_iterador_registros Seleccion::registros_end() const {
+    return const_iterador_registros(this, _ids.size());
+}
+
+Tabla Seleccion::materializar() const {
+    vector<string> campos;
+    vector<Dato> tipos;
+    for (const string &c : _tabla->campos()) {
+        campos.push_back(c);
+        tipos.push_back(_tabla->tipoCampo(c));
+    }
+    Tabla res(_tabla->claves(), campos, tipos, _tabla->almacenamiento(),
+              _tabla->particionado());
+    for (auto it = registros_begin(); it != registros_end(); ++it) {
+        res.agregarRegistro(*it);
+    }
+    return res;
+}
+
+Seleccion::const_iterador_registros::const_iterador_registros(
+        const Seleccion *seleccion, int pos) :
+        seleccion(seleccion), pos(pos),
+        actual(pos < (int) seleccion->_ids.size() ?
+               seleccion->_tabla->iterador(seleccion->_ids[pos]) :
+               seleccion->_tabla->registros_end()) {}
+
+const Registro &Seleccion::const_iterador_registros::operator*() const {
+    return *actual;
+}
+
+const Registro *Seleccion::const_iterador_registros::operator->() const {
+    return &*actual;
+}
+
+Seleccion::const_iterador_registros &
+Seleccion::const_iterador_registros::operator++() {
+    pos++;
+    actual = pos < (int) seleccion->_ids.size() ?
+             seleccion->_tabla->iterador(seleccion->_ids[pos]) :
+             seleccion->_tabla->registros_end();
+    return *this;
+}
+
+int Seleccion::const_iterador_registros::id() const {
+    return seleccion->_ids[pos];
+}
+
+bool Seleccion::const_iterador_registros::operator==(
+        const const_iterador_registros &o_it) const {
+    return seleccion == o_it.seleccion and pos == o_it.pos;
+}
+
+bool Seleccion::const_iterador_registros::operator!=(
+        const const_iterador_registros &o_it) const {
+    return not (*this == o_it);
+}
@@ -0,0 +1,220 @@
+#ifndef SELECCION_H
+#define SELECCION_H
+
+#include <vector>
+#include "Tabla.h"
+
+using namespace std;
+
+/**
+ * @brief Resultado de una búsqueda: los ids de los registros de una tabla que
+ * cumplen un criterio.
+ *
+ * No copia los registros: guarda un id de 4 bytes por registro seleccionado y
+ * los lee de la tabla de origen al recorrerla. Se recorre como una tabla y
+ * solo se convierte en una tabla propia al pedirlo con materializar().
+ *
+ * Los ids son los de la tabla de origen, así que la selección se invalida si
+ * la tabla se modifica o deja de existir. Borrar registros no renumera los
+ * ids, pero compactar la tabla sí: idsVigentes() indica si eso pasó.
+ *
+ * **se explica con** TAD Tabla
+ */
+class Seleccion {
+
+public:
+
+    class const_iterador_registros;
+
+    /**
+     * @brief Selección de los registros de \P{tabla} con los ids dados.
+     *
+     * \pre ids ordenados de forma estrictamente creciente \LAND
+     *      \FORALL (id \IN ids) id es un registro no borrado de tabla
+     * \post registros(\P{res}) = {registro(tabla, id) : id \IN ids}
+     *
+     * \complexity{\O(1)}
+     */
+    Seleccion(const Tabla &tabla, vector<int> ids);
+
+    /**
+     * @brief Tabla de la que se seleccionaron los registros.
+     *
+     * \complexity{\O(1)}
+     */
+    const Tabla &tabla() const;
+
+    /**
+     * @brief Ids de los registros seleccionados, de menor a mayor. Se
+     * devuelven por referencia no-modificable.
+     *
+     * \complexity{\O(1)}
+     */
+    const vector<int> &ids() const;
+
+    /**
+     * @brief Indica si los ids de la selección siguen numerando los
+     * registros de la tabla de origen, es decir, si la tabla no se compactó
+     * desde que se hizo la selección.
+     *
+     * \complexity{\O(1)}
+     */
+    bool idsVigentes() const;
+
+    /**
+     * @brief Campos de la tabla de origen.
+     *
+     * \complexity{\O(C * copy(campo))}
+     */
+    const linear_set<string> campos() const;
+
+    /**
+     * @brief Claves de la tabla de origen.
+     *
+     * \complexity{\O(c * copy(campo))}
+     */
+    const linear_set<string> claves() const;
+
+    /**
+     * @brief Cantidad de registros seleccionados.
+     *
+     * \complexity{\O(1)}
+     */
+    int cant_registros() const;
+
+    /**
+     * @brief Iterador al primer registro seleccionado.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador_registros registros_begin() const;
+
+    /**
+     * @brief Iterador a la posición pasando-el-último de la selección.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador_registros registros_end() const;
+
+    /**
+     * @brief Copia los registros seleccionados a una tabla nueva con las
+     * claves, campos, almacenamiento y particionado de la de origen.
+     *
+     * \pre true
+     * \post registros(\P{res}) = registros(\P{this}) \LAND
+     *       campos(\P{res}) = campos(tabla(\P{this})) \LAND
+     *       claves(\P{res}) = claves(tabla(\P{this}))
+     *
+     * \complexity{\O(C * L + n * (C + L + copy(reg)))}
+     */
+    Tabla materializar() const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: seleccion \TO bool\n
+     * rep(s) \EQUIV
+     *  * _tabla != NULL \LAND
+     *  * _ids ordenados de forma estrictamente creciente \LAND
+     *  * \FORALL (id \IN _ids) id es un registro no borrado de *_tabla
+     *    (mientras _compactaciones = compactaciones(*_tabla))
+     *
+     * abs: seleccion \TO Tabla\n
+     * abs(s) \EQUIV t \| campos(t) = campos(*_tabla) \LAND
+     *   claves(t) = claves(*_tabla) \LAND
+     *   registros(t) = {registro(*_tabla, id) : id \IN _ids}
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    const Tabla *_tabla;
+    vector<int> _ids;
+    /** @brief Compactaciones de la tabla al hacer la selección. */
+    int _compactaciones;
+    /** @} */
+};
+
+/**
+ * @brief Iterador de los registros de una selección, en orden de id.
+ *
+ * El registro apuntado vive mientras el iterador no avance.
+ */
+class Seleccion::const_iterador_registros {
+
+public:
+    using iterator_category = forward_iterator_tag;
+    using value_type = Registro;
+    using difference_type = ptrdiff_t;
+    using pointer = const Registro*;
+    using reference = const Registro&;
+
+    /**
+     * @brief Desreferencia el iterador.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    const Registro &operator*() const;
+
+    /**
+     * @brief Operador flechita.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    const Registro *operator->() const;
+
+    /**
+     * @brief Avanza el iterador al siguiente registro seleccionado.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    const_iterador_registros &operator++();
+
+    /**
+     * @brief Id en la tabla de origen del registro apuntado.
+     *
+     * \pre El iterador no debe estar en la posición pasando-el-último.
+     *
+     * \complexity{\O(1)}
+     */
+    int id() const;
+
+    /**
+     * @brief Comparación entre iteradores.
+     *
+     * \pre ambos iteradores refieren a la misma selección
+     *
+     * \complexity{\O(1)}
+     */
+    bool operator==(const const_iterador_registros &o_it) const;
+
+    /**
+     * @brief Comparación entre iteradores.
+     *
+     * \pre ambos iteradores refieren a la misma selección
+     *
+     * \complexity{\O(1)}
+     */
+    bool operator!=(const const_iterador_registros &o_it) const;
+
+private:
+    friend class Seleccion;
+
+    const_iterador_registros(const Seleccion *seleccion, int pos);
+
+    /** @brief Selección recorrida. */
+    const Seleccion *seleccion;
+
+    /** @brief Posición del registro apuntado en los ids de la selección. */
+    int pos;
+
+    /** @brief Iterador de la tabla de origen al registro apuntado. */
+    Tabla::const_iterador_registros actual;
+};
+
+#endif // SELECCION_H
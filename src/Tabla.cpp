@@ -1,31 +1,615 @@
 #include "Tabla.h"
+#include <limits>
 #include "utils.h"
+#include <unordered_set>
+#include <algorithm>
 
 using namespace std;
 
+const int Tabla::REGISTROS_POR_TRAMO;
+
 Tabla::Tabla(const linear_set<string> &claves, 
              const vector<string> &campos, 
-             const vector<Dato> &tipos) 
-      {
-    //QUE ONDAAA??
+             const vector<Dato> &tipos,
+             Almacenamiento almacenamiento,
+             const Particionado &particionado) :
+      Tabla(claves, make_shared<const Schema>(campos), campos, tipos,
+            almacenamiento, particionado) {}
+
+Tabla::Tabla(const linear_set<string> &claves,
+             const shared_ptr<const Schema> &schema,
+             const vector<string> &campos,
+             const vector<Dato> &tipos,
+             Almacenamiento almacenamiento,
+             const Particionado &particionado) :
+      _schema(schema),
+      _almacenamiento(almacenamiento), _conjuntoValido(false),
+      _particionado(particionado), _compactaciones(0) {
         for (auto it = claves.begin(); it != claves.end(); ++it) {
             _claves.insert(make_pair(*it, true));
+            if (_schema->ordinal(*it) != -1) {
+                _camposClave.push_back(_schema->id(*it));
+            }
         }
 
-        for (int i = 0; i < campos.size(); i++) {
-            _camposYtipos.insert(make_pair(campos[i], tipos[i]));
+        _tipos.resize(_schema->cantCampos(), tipoNat);
+        for (size_t i = 0; i < campos.size(); i++) {
+            _tipos[_schema->ordinal(campos[i])] = tipos[i];
+        }
+        if (_almacenamiento == POR_COLUMNAS) {
+            _columnas = ColumnasRegistros(_tipos);
+        }
+        _zonas = ZonasRegistros(_tipos);
+        for (const Dato &tipo : _tipos) {
+            _estadisticas.push_back(EstadisticasCampo(tipo));
+        }
+        if (_particionado.tipo() != Particionado::NINGUNO) {
+            _campoParticion = _schema->id(_particionado.campo());
+            _idsPorParticion.resize(_particionado.cantParticiones());
         }
 }
 
 
 Tabla::const_iterador_registros Tabla::agregarRegistro(const Registro& r) {
-    return Tabla::const_iterador_registros(
-            linear_set<Registro>::const_iterator(_registros.insert(r).first));
+    size_t h = _hashClave(r);
+    int existente = _buscarRegistro(r, h);
+    if (existente != -1) {
+        return iterador(existente);
+    }
+    // Si el registro tiene los campos de la tabla se reacomodan sus datos
+    // según el schema de la tabla
+    if (_almacenamiento == POR_COLUMNAS or
+        (r.schema()->mismosCampos(*_schema) and
+         _camposClave.size() == _claves.size())) {
+        return iterador(_agregar(r, h));
+    }
+
+    // Registros por fuera de la descripción de la tabla conservan su propio
+    // schema
+    const Schema &schema = *r.schema();
+    vector<Dato> datos;
+    datos.reserve(schema.cantCampos());
+    for (int i = 0; i < schema.cantCampos(); ++i) {
+        datos.push_back(_heap.guardar(r.dato(schema.campo(i))));
+    }
+    int id = _registros.agregar(Registro(schema, datos));
+    _idsPorClave.insert(make_pair(h, id));
+    _zonas.invalidar(id);
+    _asignarParticion(id, r);
+    _anotarEnConjunto(id);
+    return iterador(id);
+}
+
+Tabla::const_iterador_registros
+Tabla::agregarRegistros(const vector<Registro> &regs) {
+    int primero = _tamIds();
+    if (regs.empty()) {
+        return registros_end();
+    }
+    _idsPorClave.reserve(_idsPorClave.size() + regs.size());
+    for (const Registro &r : regs) {
+        _agregar(r, _hashClave(r));
+    }
+    return iterador(primero);
+}
+
+bool Tabla::clavesLibres(const vector<Registro> &regs) const {
+    for (const Registro &r : regs) {
+        if (existeClave(r)) {
+            return false;
+        }
+    }
+    return _clavesDistintas(regs);
+}
+
+bool Tabla::_clavesDistintas(const vector<Registro> &regs) const {
+    unordered_multimap<size_t, int> vistos;
+    vistos.reserve(regs.size());
+    for (size_t i = 0; i < regs.size(); ++i) {
+        const Registro &r = regs[i];
+        size_t h = _hashClave(r);
+        auto rango = vistos.equal_range(h);
+        for (auto it = rango.first; it != rango.second; ++it) {
+            const Registro &otro = regs[it->second];
+            bool igual = true;
+            for (size_t j = 0; j < _camposClave.size() and igual; ++j) {
+                igual = otro.dato(_camposClave[j]) == r.dato(_camposClave[j]);
+            }
+            if (igual) {
+                return false;
+            }
+        }
+        vistos.insert(make_pair(h, i));
+    }
+    return true;
+}
+
+void Tabla::borrarRegistros(const vector<int> &ids) {
+    for (int id : ids) {
+        Registro r = registro(id);
+        _olvidarClave(id, _hashClave(r));
+        _quitarEstadisticas(r);
+        if (_almacenamiento == POR_COLUMNAS) {
+            _columnas.borrar(id);
+        } else {
+            _registros.borrar(id);
+        }
+    }
+    if (not ids.empty()) {
+        _conjuntoValido = false;
+        _revisarEstadisticas();
+    }
+}
+
+bool Tabla::puedeActualizar(const vector<int> &ids,
+                            const Registro &cambios) const {
+    bool cambiaClaves = false;
+    for (const FieldId &campo : _camposClave) {
+        cambiaClaves |= cambios.schema()->ordinal(campo.campo()) != -1;
+    }
+    if (not cambiaClaves) {
+        return true;
+    }
+    // Un registro actualizado puede tomar las claves de otro registro
+    // actualizado, pero no las de uno que queda igual
+    unordered_set<int> actualizados(ids.begin(), ids.end());
+    vector<Registro> nuevos;
+    nuevos.reserve(ids.size());
+    for (int id : ids) {
+        nuevos.push_back(Registro(*_schema, _actualizados(id, cambios)));
+        const Registro &nuevo = nuevos.back();
+        int otro = _buscarClave(nuevo, _hashClave(nuevo));
+        if (otro != -1 and not actualizados.count(otro)) {
+            return false;
+        }
+    }
+    return _clavesDistintas(nuevos);
+}
+
+void Tabla::actualizarRegistros(const vector<int> &ids,
+                                const Registro &cambios) {
+    // Por columnas, los datos nuevos se escriben todos juntos al final, para
+    // recomprimir cada bloque una sola vez
+    vector<vector<Dato> > porColumnas;
+    for (int id : ids) {
+        vector<Dato> datos = _actualizados(id, cambios);
+        Registro anterior = registro(id);
+        _olvidarClave(id, _hashClave(anterior));
+        _quitarEstadisticas(anterior);
+        if (_almacenamiento == POR_COLUMNAS) {
+            porColumnas.push_back(datos);
+        } else {
+            for (Dato &d : datos) {
+                d = _heap.guardar(d);
+            }
+            _registros.reemplazar(id, Registro(*_schema, datos));
+        }
+        _zonas.agregar(id, datos);
+        _agregarEstadisticas(datos);
+        Registro nuevo(*_schema, datos);
+        _idsPorClave.insert(make_pair(_hashClave(nuevo), id));
+        if (not _idsPorParticion.empty()) {
+            int desde = _particion(anterior);
+            int hasta = _particion(nuevo);
+            if (desde != hasta) {
+                // El registro cambia de partición: se mantienen ambas listas
+                // ordenadas
+                vector<int> &viejos = _idsPorParticion[desde];
+                viejos.erase(lower_bound(viejos.begin(), viejos.end(), id));
+                vector<int> &nuevos = _idsPorParticion[hasta];
+                nuevos.insert(lower_bound(nuevos.begin(), nuevos.end(), id), id);
+            }
+        }
+    }
+    if (_almacenamiento == POR_COLUMNAS) {
+        _columnas.reemplazar(ids, porColumnas);
+    }
+    if (not ids.empty()) {
+        _conjuntoValido = false;
+        _revisarEstadisticas();
+    }
+}
+
+const Particionado &Tabla::particionado() const {
+    return _particionado;
+}
+
+vector<int> Tabla::ids(int particion) const {
+    if (_idsPorParticion.empty()) {
+        return ids();
+    }
+    vector<int> res;
+    res.reserve(_idsPorParticion[particion].size());
+    for (int id : _idsPorParticion[particion]) {
+        if (not _borrado(id)) {
+            res.push_back(id);
+        }
+    }
+    return res;
+}
+
+bool Tabla::hayRegistros(int particion) const {
+    if (_idsPorParticion.empty()) {
+        return cant_registros() > 0;
+    }
+    for (int id : _idsPorParticion[particion]) {
+        if (not _borrado(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int Tabla::_particion(const Registro &r) const {
+    if (r.schema()->ordinal(_particionado.campo()) == -1) {
+        return 0;
+    }
+    return _particionado.particion(r.dato(_campoParticion));
+}
+
+void Tabla::_asignarParticion(int id, const Registro &r) {
+    if (not _idsPorParticion.empty()) {
+        _idsPorParticion[_particion(r)].push_back(id);
+    }
+}
+
+bool Tabla::_borrado(int id) const {
+    return _almacenamiento == POR_COLUMNAS ? _columnas.borrado(id)
+                                           : _registros.borrado(id);
+}
+
+const ZonasRegistros &Tabla::zonas() const {
+    return _zonas;
+}
+
+const EstadisticasCampo &Tabla::estadisticas(const string &campo) const {
+    return _estadisticas[_schema->ordinal(campo)];
 }
 
+const EstadisticasCampo &Tabla::estadisticas(const FieldId &id) const {
+    return _estadisticas[id.ordinal()];
+}
+
+void Tabla::_agregarEstadisticas(const vector<Dato> &datos) {
+    for (size_t i = 0; i < _estadisticas.size(); ++i) {
+        _estadisticas[i].agregar(datos[i]);
+    }
+}
+
+void Tabla::_quitarEstadisticas(const Registro &r) {
+    // Los registros por fuera de la descripción de la tabla no aportan a las
+    // estadísticas
+    if (r.schema() != _schema) {
+        return;
+    }
+    for (size_t i = 0; i < _estadisticas.size(); ++i) {
+        _estadisticas[i].quitar(r.dato(FieldId(*_schema, i)));
+    }
+}
+
+void Tabla::_revisarEstadisticas() {
+    // Todos los campos pierden un valor por registro, así que se
+    // desactualizan a la vez
+    if (not _estadisticas.front().desactualizadas()) {
+        return;
+    }
+    for (size_t i = 0; i < _tipos.size(); ++i) {
+        _estadisticas[i] = EstadisticasCampo(_tipos[i]);
+    }
+    for (auto it = registros_begin(); it != registros_end(); ++it) {
+        if (it->schema() == _schema) {
+            vector<Dato> datos;
+            datos.reserve(_schema->cantCampos());
+            for (int i = 0; i < _schema->cantCampos(); ++i) {
+                datos.push_back(it->dato(FieldId(*_schema, i)));
+            }
+            _agregarEstadisticas(datos);
+        }
+    }
+}
+
+int Tabla::cant_borrados() const {
+    return _tamIds() - cant_registros();
+}
+
+int Tabla::compactaciones() const {
+    return _compactaciones;
+}
+
+void Tabla::compactar() {
+    _compactaciones++;
+    _idsPorClave.clear();
+    for (vector<int> &particion : _idsPorParticion) {
+        particion.clear();
+    }
+    ZonasRegistros zonas(_tipos);
+    for (size_t i = 0; i < _tipos.size(); ++i) {
+        _estadisticas[i] = EstadisticasCampo(_tipos[i]);
+    }
+    if (_almacenamiento == POR_COLUMNAS) {
+        ColumnasRegistros compactas(_tipos);
+        for (int id : ids()) {
+            vector<Dato> datos = _columnas.datos(id);
+            int nuevoId = compactas.agregar(datos);
+            zonas.agregar(nuevoId, datos);
+            _agregarEstadisticas(datos);
+            Registro r(*_schema, datos);
+            _idsPorClave.insert(make_pair(_hashClave(r), nuevoId));
+            _asignarParticion(nuevoId, r);
+        }
+        _columnas = move(compactas);
+    } else {
+        ArenaRegistros compactos;
+        for (int id : ids()) {
+            const Registro &r = _registros[id];
+            int nuevoId = compactos.agregar(r);
+            _idsPorClave.insert(make_pair(_hashClave(r), nuevoId));
+            _asignarParticion(nuevoId, r);
+            if (r.schema() == _schema) {
+                vector<Dato> datos;
+                for (int i = 0; i < _schema->cantCampos(); ++i) {
+                    datos.push_back(r.dato(FieldId(*_schema, i)));
+                }
+                zonas.agregar(nuevoId, datos);
+                _agregarEstadisticas(datos);
+            } else {
+                zonas.invalidar(nuevoId);
+            }
+        }
+        _registros = move(compactos);
+    }
+    _zonas = move(zonas);
+}
+
+Tabla Tabla::vacia() const {
+    vector<string> campos;
+    for (int i = 0; i < _schema->cantCampos(); ++i) {
+        campos.push_back(_schema->campo(i));
+    }
+    return Tabla(_claves.claves(), _schema, campos, _tipos, _almacenamiento,
+                 _particionado);
+}
+
+vector<int> Tabla::copiarPorTramos(const Tabla &origen, const vector<int> &ids,
+                                   mutex &cerrojo) {
+    vector<int> nuevos;
+    nuevos.reserve(ids.size());
+    for (size_t desde = 0; desde < ids.size(); desde += REGISTROS_POR_TRAMO) {
+        size_t hasta = min(ids.size(), desde + REGISTROS_POR_TRAMO);
+        lock_guard<mutex> lectura(cerrojo);
+        for (size_t i = desde; i < hasta; ++i) {
+            // Los borrados desde que se tomaron los ids no se copian
+            if (origen._borrado(ids[i])) {
+                nuevos.push_back(-1);
+            } else {
+                nuevos.push_back(agregarRegistro(origen.registro(ids[i])).id());
+            }
+        }
+    }
+    return nuevos;
+}
+
+void Tabla::instalarCompacta(Tabla &compacta) {
+    int compactaciones = _compactaciones + 1;
+    *this = move(compacta);
+    _compactaciones = compactaciones;
+}
+
+vector<Dato> Tabla::_actualizados(int id, const Registro &cambios) const {
+    Registro actual = registro(id);
+    vector<Dato> datos;
+    datos.reserve(_schema->cantCampos());
+    for (int i = 0; i < _schema->cantCampos(); ++i) {
+        const string &campo = _schema->campo(i);
+        if (cambios.schema()->ordinal(campo) != -1) {
+            datos.push_back(cambios.dato(campo));
+        } else {
+            datos.push_back(actual.dato(FieldId(*_schema, i)));
+        }
+    }
+    return datos;
+}
+
+void Tabla::_olvidarClave(int id, size_t h) {
+    auto rango = _idsPorClave.equal_range(h);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        if (it->second == id) {
+            _idsPorClave.erase(it);
+            return;
+        }
+    }
+}
+
+int Tabla::_tamIds() const {
+    if (_almacenamiento == POR_COLUMNAS) {
+        return _columnas.tam();
+    }
+    return _registros.tam();
+}
+
+int Tabla::_agregar(const Registro &r, size_t h) {
+    vector<Dato> datos;
+    datos.reserve(_schema->cantCampos());
+    int id;
+    if (_almacenamiento == POR_COLUMNAS) {
+        // Los strings quedan en el diccionario de cada columna
+        for (int i = 0; i < _schema->cantCampos(); ++i) {
+            datos.push_back(r.dato(_schema->campo(i)));
+        }
+        id = _columnas.agregar(datos);
+    } else {
+        for (int i = 0; i < _schema->cantCampos(); ++i) {
+            datos.push_back(_heap.guardar(r.dato(_schema->campo(i))));
+        }
+        id = _registros.agregar(Registro(*_schema, datos));
+    }
+    _idsPorClave.insert(make_pair(h, id));
+    _zonas.agregar(id, datos);
+    _agregarEstadisticas(datos);
+    _asignarParticion(id, r);
+    _anotarEnConjunto(id);
+    return id;
+}
+
+void Tabla::_anotarEnConjunto(int id) {
+    if (_conjuntoValido) {
+        _conjuntoRegistros.fast_insert(registro(id));
+    }
+}
+
+bool Tabla::existeClave(const Registro &r) const {
+    return _buscarClave(r, _hashClave(r)) != -1;
+}
+
+const Dato *Tabla::_datoClave(const Registro &r, const FieldId &campo) {
+    if (r.schema().get() != campo.schema() and
+        r.schema()->ordinal(campo.campo()) == -1) {
+        return nullptr;
+    }
+    return &r.dato(campo);
+}
+
+size_t Tabla::_hashClave(const Registro &r) const {
+    size_t h = 0;
+    for (const FieldId &campo : _camposClave) {
+        const Dato *d = _datoClave(r, campo);
+        h = h * 31 + (d == nullptr ? 0 : hashDato(*d));
+    }
+    return h;
+}
+
+int Tabla::_buscarClave(const Registro &r, size_t h) const {
+    auto rango = _idsPorClave.equal_range(h);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        int id = it->second;
+        bool igual = true;
+        for (size_t i = 0; i < _camposClave.size() and igual; ++i) {
+            const FieldId &campo = _camposClave[i];
+            const Dato *d = _datoClave(r, campo);
+            if (_almacenamiento == POR_COLUMNAS) {
+                igual = d != nullptr and _columnas.dato(id, campo.ordinal()) == *d;
+            } else {
+                const Dato *otro = _datoClave(_registros[id], campo);
+                igual = d == nullptr ? otro == nullptr
+                                     : (otro != nullptr and *otro == *d);
+            }
+        }
+        if (igual) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+int Tabla::_buscarRegistro(const Registro &r, size_t h) const {
+    auto rango = _idsPorClave.equal_range(h);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        int id = it->second;
+        bool igual = _almacenamiento == POR_COLUMNAS ? registro(id) == r
+                                                     : _registros[id] == r;
+        if (igual) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+Tabla::const_iterador_registros Tabla::iterador(int id) const {
+    if (_almacenamiento == POR_COLUMNAS) {
+        return Tabla::const_iterador_registros(this, id);
+    }
+    const ArenaRegistros::Grupo *grupo = _registros.grupo(id);
+    return Tabla::const_iterador_registros(grupo, id - grupo->primerId);
+}
+
+vector<int> Tabla::ids() const {
+    vector<int> ids;
+    ids.reserve(cant_registros());
+    int tam = _tamIds();
+    for (int id = 0; id < tam; ++id) {
+        if (not _borrado(id)) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+Tabla::Almacenamiento Tabla::almacenamiento() const {
+    return _almacenamiento;
+}
+
+Registro Tabla::registro(int id) const {
+    if (_almacenamiento == POR_COLUMNAS) {
+        return Registro(*_schema, _columnas.datos(id));
+    }
+    return _registros[id];
+}
+
+Dato Tabla::dato(int id, const FieldId &campo) const {
+    if (_almacenamiento == POR_COLUMNAS) {
+        return _columnas.dato(id, campo.ordinal());
+    }
+    return _registros[id].dato(campo);
+}
+
+void Tabla::filtrar(vector<int> &ids, const FieldId &campo, const Dato &valor,
+                    bool igualdad) const {
+    if (igualdad) {
+        // Primero se descartan los grupos que no pueden tener el valor
+        _zonas.descartar(ids, campo.ordinal(), valor);
+    }
+    if (_almacenamiento == POR_COLUMNAS) {
+        _columnas.filtrar(ids, campo.ordinal(), valor, igualdad);
+        return;
+    }
+    int quedan = 0;
+    for (int id : ids) {
+        if ((_registros[id].dato(campo) == valor) == igualdad) {
+            ids[quedan++] = id;
+        }
+    }
+    ids.resize(quedan);
+}
+
+void Tabla::filtrar(vector<int> &ids, const FieldId &campo,
+                    const Restriccion &r) const {
+    if (not r.esRango()) {
+        filtrar(ids, campo, r.dato(), r.igual());
+        return;
+    }
+    if (r.dato().esNat()) {
+        int desde = numeric_limits<int>::min();
+        int hasta = numeric_limits<int>::max();
+        int valor = r.dato().valorNat();
+        if (r.operador() == Restriccion::MENOR) {
+            if (valor == desde) {
+                ids.clear();
+                return;
+            }
+            hasta = valor - 1;
+        } else if (r.operador() == Restriccion::MAYOR) {
+            if (valor == hasta) {
+                ids.clear();
+                return;
+            }
+            desde = valor + 1;
+        } else {
+            desde = valor;
+            hasta = r.hasta().valorNat();
+        }
+        _zonas.descartarFuera(ids, campo.ordinal(), desde, hasta);
+    }
+    int quedan = 0;
+    for (int id : ids) {
+        if (r.cumple(dato(id, campo))) {
+            ids[quedan++] = id;
+        }
+    }
+    ids.resize(quedan);
+}
 
 const linear_set<string> Tabla::campos() const {
-    return _camposYtipos.claves();
+    return _schema->campos();
 }
 
 const linear_set<string> Tabla::claves() const {
@@ -33,25 +617,54 @@ const linear_set<string> Tabla::claves() const {
 }
 
 const Dato& Tabla::tipoCampo(const string& campo) const {
-    return _camposYtipos.at(campo);
+    return _tipos[_schema->ordinal(campo)];
+}
+
+const Dato& Tabla::tipoCampo(const FieldId& id) const {
+    return _tipos[id.ordinal()];
+}
+
+FieldId Tabla::campoId(const string& campo) const {
+    return _schema->id(campo);
+}
+
+const shared_ptr<const Schema> &Tabla::schema() const {
+    return _schema;
 }
 
 const linear_set<Registro> &Tabla::registros() const {
-    return _registros;
+    if (not _conjuntoValido) {
+        _conjuntoRegistros = linear_set<Registro>();
+        for (auto it = registros_begin(); it != registros_end(); ++it) {
+            _conjuntoRegistros.fast_insert(*it);
+        }
+        _conjuntoValido = true;
+    }
+    return _conjuntoRegistros;
 }
 
 
 Tabla::const_iterador_registros Tabla::registros_begin() const {
-  return Tabla::const_iterador_registros(_registros.begin());
+  Tabla::const_iterador_registros it =
+      _almacenamiento == POR_COLUMNAS
+          ? Tabla::const_iterador_registros(this, 0)
+          : Tabla::const_iterador_registros(_registros.primerGrupo(), 0);
+  it.saltarBorrados();
+  return it;
 }
 
-//QUE ONDAAAAAAA??
 Tabla::const_iterador_registros Tabla::registros_end() const {
-  return Tabla::const_iterador_registros(_registros.end());
+  if (_almacenamiento == POR_COLUMNAS) {
+    return Tabla::const_iterador_registros(this, _columnas.tam());
+  }
+  return Tabla::const_iterador_registros((const ArenaRegistros::Grupo *) nullptr, 0);
 }
 
 int Tabla::cant_registros() const {
-  return _registros.size();
+  if (_almacenamiento == POR_COLUMNAS) {
+    return _columnas.vivos();
+  }
+  return _registros.vivos();
 }
 
 bool operator==(const Tabla& t1, const Tabla& t2) {
@@ -1,12 +1,23 @@
 #ifndef TABLA_H
 #define TABLA_H
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "linear_map.h"
 #include "linear_set.h"
+#include "string_map.h"
 #include "Dato.h"
 #include "Registro.h"
+#include "Restriccion.h"
+#include "Schema.h"
+#include "HeapStrings.h"
+#include "ArenaRegistros.h"
+#include "ColumnasRegistros.h"
+#include "ZonasRegistros.h"
+#include "EstadisticasCampo.h"
+#include "Particionado.h"
 
 using namespace std;
 
@@ -31,6 +42,21 @@ public:
   // Forward declaration
   class const_iterador_registros;
 
+  /**
+   * @brief Forma en que la tabla guarda sus registros.
+   *
+   * POR_FILAS guarda cada registro completo, en grupos contiguos.
+   * POR_COLUMNAS guarda cada campo en su propia columna y reconstruye los
+   * registros al accederlos; conviene cuando las búsquedas miran pocos campos.
+   */
+  enum Almacenamiento { POR_FILAS, POR_COLUMNAS };
+
+  /**
+   * @brief Cantidad de registros que copiarPorTramos lee de la tabla de
+   * origen cada vez que toma el cerrojo.
+   */
+  static const int REGISTROS_POR_TRAMO = 1 << 12;
+
   /**
    * @brief Inicializa una tabla sin registros y con la descripción parámetro.
    *
@@ -39,16 +65,24 @@ public:
    * el de datos
    * @param tipos  Conjunto de datos cuyo tipo define el tipo admisible en cada
    * campo. El valor de los datos se ignora.
+   * @param almacenamiento Forma en que se guardan los registros.
+   * @param particionado Forma en que se reparten los registros en
+   * particiones.
    * 
    * \pre \LNOT \EMPTYSET ?(c) \LAND 
    *      \FORALL (c: campo) c \in claves \IMPLIES esta?(c, campos) \LAND
-   *      long(campos) = long(tipos) \LAND sinRepetidos(campos)
+   *      long(campos) = long(tipos) \LAND sinRepetidos(campos) \LAND
+   *      (tipo(particionado) != NINGUNO \IMPLIES
+   *       esta?(campo(particionado), campos)) \LAND
+   *      (tipo(particionado) = RANGOS \IMPLIES
+   *       Nat?(tipo del campo de particionado))
    * \post \P{res} = nuevaTabla(claves, nuevoRegistro(campos, tipos))
    *
    * \complexity{\O(long(campos) * (copy(campo) + copy(dato)))}
    */
   Tabla(const linear_set<string> &claves, const vector<string> &campos,
-        const vector<Dato> &tipos);
+        const vector<Dato> &tipos, Almacenamiento almacenamiento = POR_FILAS,
+        const Particionado &particionado = Particionado());
 
   /**
    * @brief Inserta un nuevo registro en la tabla.
@@ -59,10 +93,57 @@ public:
    * \post \P{this} = agregarRegistro(r, t) \LAND \P{res} apunta al registro
    * recién agregado.
    *
-   * \complexity{\O(copy(registro))}
+   * Los strings del registro se copian al heap de strings de la tabla y el
+   * registro guardado comparte el schema de la tabla. Si la tabla guarda sus
+   * registros por columnas, se agrega un dato a cada columna. Si ya hay un
+   * registro igual, no se agrega y \P{res} apunta a ése; para saber si
+   * otro registro usa las mismas claves está existeClave().
+   *
+   * \complexity{\O(copy(registro)) esperado}
    */
   const_iterador_registros agregarRegistro(const Registro &r);
 
+  /**
+   * @brief Indica si la tabla tiene un registro con las claves de \P{r}
+   *
+   * Se resuelve con el índice por hash de las claves, sin recorrer los
+   * registros.
+   *
+   * \pre claves(\P{this}) \SUBSETEQ campos(r)
+   * \post \P{res} \IFF hayCoincidencia(r, claves(\P{this}), \P{this})
+   *
+   * \complexity{\O(c * cmp(dato)) esperado}
+   */
+  bool existeClave(const Registro &r) const;
+
+  /**
+   * @brief Inserta un lote de registros en la tabla.
+   *
+   * Los registros se agregan en orden, sin buscar claves repetidas; los
+   * registros del lote quedan desde \P{res} hasta registros_end().
+   *
+   * \pre t = \P{this} \LAND
+   *      \FORALL (r : Registro) está?(r, regs) \IMPLIES campos(r) = campos(t)
+   *      \LAND clavesLibres(regs)
+   * \post \P{this} = agregar cada registro de regs a t \LAND \P{res} apunta
+   * al primero de ellos, o a registros_end() si regs es vacío.
+   *
+   * \complexity{\O(long(regs) * copy(registro)) esperado}
+   */
+  const_iterador_registros agregarRegistros(const vector<Registro> &regs);
+
+  /**
+   * @brief Indica si un lote de registros se puede agregar sin repetir claves
+   *
+   * Ningún registro del lote puede tener las claves de un registro de la
+   * tabla ni de otro registro del lote.
+   *
+   * \pre claves(\P{this}) \SUBSETEQ campos(r) para cada r en regs
+   *
+   * \complexity{\O(long(regs) * c * cmp(dato)) esperado}
+   */
+  bool clavesLibres(const vector<Registro> &regs) const;
+
   /**
    * @brief Campos de la tabla
    *
@@ -84,10 +165,45 @@ public:
    * \pre campo \IN campos(\P{this})
    * \post tipoCampo(campo, \P{this})
    *
-   * \complexity{\O(1)}
+   * \complexity{\O(C * L)}
    */
   const Dato &tipoCampo(const string &campo) const;
 
+  /**
+   * @brief Tipo de un campo ya resuelto con campoId
+   *
+   * \pre schema(id) = schema(\P{this})
+   * \post tipoCampo(campo(id), \P{this})
+   *
+   * \complexity{\O(1)}
+   */
+  const Dato &tipoCampo(const FieldId &id) const;
+
+  /**
+   * @brief Resuelve un campo de la tabla para accederlo en O(1)
+   *
+   * El resultado se usa con Registro::dato(FieldId) sobre los registros de la
+   * tabla y es válido mientras viva la tabla.
+   *
+   * \pre campo \IN campos(\P{this})
+   * \post campo(\P{res}) = campo \LAND schema(\P{res}) = schema(\P{this})
+   *
+   * \complexity{\O(C * L)}
+   */
+  FieldId campoId(const string &campo) const;
+
+  /**
+   * @brief Schema compartido por los registros de la tabla
+   *
+   * Se devuelve por referencia no-modificable.
+   *
+   * \pre true
+   * \post campos(*\P{res}) = campos(\P{this})
+   *
+   * \complexity{\O(1)}
+   */
+  const shared_ptr<const Schema> &schema() const;
+
   /**
    * @brief Subconjunto de campos que son clave
    *
@@ -101,18 +217,294 @@ public:
   const linear_set<string> claves() const;
 
   /**
-   * @brief Los registros de la tabla
+   * @brief Borra los registros con los ids parámetro.
+   *
+   * Los registros solo se marcan como borrados: los ids y los iteradores de
+   * los demás registros siguen siendo válidos hasta que se compacte la tabla.
+   *
+   * \pre los ids son de registros de \P{this} y no se repiten
+   * \post \P{this} = la tabla sin los registros de ids
+   *
+   * \complexity{\O(long(ids) * c * cmp(dato)) esperado}
+   */
+  void borrarRegistros(const vector<int> &ids);
+
+  /**
+   * @brief Indica si los registros con los ids parámetro pueden tomar los
+   * valores de \P{cambios} sin repetir claves.
+   *
+   * \pre los ids son de registros de \P{this} y no se repiten \LAND
+   *      campos(cambios) \SUBSETEQ campos(\P{this})
+   *
+   * \complexity{\O(1) si cambios no tiene claves, \O(long(ids) * C * L)
+   * esperado sino}
+   */
+  bool puedeActualizar(const vector<int> &ids, const Registro &cambios) const;
+
+  /**
+   * @brief Reemplaza, en los registros con los ids parámetro, los datos de
+   * los campos de \P{cambios}.
+   *
+   * Los registros se modifican en su lugar: sus ids y sus iteradores siguen
+   * siendo válidos.
+   *
+   * \pre puedeActualizar(ids, cambios) \LAND cada dato de cambios tiene el
+   *      tipo de su campo en \P{this}
+   * \post cada registro de ids tiene los datos de cambios en sus campos y
+   *       los demás datos sin cambiar
+   *
+   * \complexity{\O(long(ids) * copy(registro)) esperado}
+   */
+  void actualizarRegistros(const vector<int> &ids, const Registro &cambios);
+
+  /**
+   * @brief Cantidad de registros borrados que todavía ocupan lugar.
+   *
+   * \pre true
+   * \complexity{\O(1)}
+   */
+  int cant_borrados() const;
+
+  /**
+   * @brief Libera el lugar de los registros borrados.
+   *
+   * Los registros que quedan se renumeran en orden, por lo que se invalidan
+   * todos los ids e iteradores anteriores.
+   *
+   * \pre true
+   * \post registros(\P{this}) no cambia \LAND cant_borrados(\P{this}) = 0
+   *       \LAND compactaciones(\P{this}) = compactaciones(t) + 1
+   *
+   * \complexity{\O(n * copy(registro))}
+   */
+  void compactar();
+
+  /**
+   * @brief Cantidad de veces que se compactó la tabla. Los ids de la tabla
+   * solo cambian cuando cambia este número.
+   *
+   * \pre true
+   * \complexity{\O(1)}
+   */
+  int compactaciones() const;
+
+  /**
+   * @brief Tabla sin registros con la misma descripción que \P{this}, que
+   * comparte su schema.
+   *
+   * Sirve para armar la versión compactada de la tabla aparte, con
+   * copiarPorTramos, e instalarla después con instalarCompacta.
+   *
+   * \pre true
+   * \post \P{res} = nuevaTabla(claves(\P{this}), campos y tipos de \P{this})
+   *
+   * \complexity{\O(C * (copy(campo) + copy(dato)))}
+   */
+  Tabla vacia() const;
+
+  /**
+   * @brief Agrega los registros \P{ids} de \P{origen}, en ese orden.
+   *
+   * Lee \P{origen} de a REGISTROS_POR_TRAMO registros, con \P{cerrojo} tomado
+   * solo mientras lee cada tramo, así que \P{origen} puede modificarse entre
+   * tramos desde otro hilo que tome el mismo cerrojo. Los registros que ya
+   * están borrados al leerlos no se copian.
+   *
+   * \pre \P{this} se armó con vacia() de \P{origen} \LAND \P{ids} son ids
+   *      de \P{origen}
+   * \post \P{res}[i] es el id en \P{this} del registro \P{ids}[i] de \P{origen},
+   *       o -1 si estaba borrado
+   *
+   * \complexity{\O(long(ids) * copy(registro)) esperado}
+   */
+  vector<int> copiarPorTramos(const Tabla &origen, const vector<int> &ids,
+                              mutex &cerrojo);
+
+  /**
+   * @brief Toma los registros de \P{compacta}, que queda sin especificar.
+   *
+   * Como compactar(), cambia los ids de los registros e invalida los
+   * iteradores anteriores.
+   *
+   * \pre \P{compacta} se armó con vacia() de \P{this} \LAND
+   *      registros(compacta) = registros(\P{this})
+   * \post registros(\P{this}) no cambia \LAND
+   *       compactaciones(\P{this}) = compactaciones(t) + 1
+   *
+   * \complexity{\O(1)}
+   */
+  void instalarCompacta(Tabla &compacta);
+
+  /**
+   * @brief Sinopsis de los grupos de registros de la tabla
    *
    * Se devuelve por referencia no-modificable.
    *
    * \pre true
-   * \post \P{res} = Registros(\P{this})
+   * \complexity{\O(1)}
+   */
+  const ZonasRegistros &zonas() const;
+
+  /**
+   * @brief Forma en que se reparten los registros en particiones
    *
+   * Se devuelve por referencia no-modificable.
+   *
+   * \pre true
    * \complexity{\O(1)}
    */
+  const Particionado &particionado() const;
+
+  /**
+   * @brief Ids de los registros de una partición, en orden.
+   *
+   * Cada partición lleva su propia lista de ids, así que no se recorren los
+   * registros de las demás.
+   *
+   * \pre 0 \LEQ particion \LT cantParticiones(particionado(\P{this}))
+   * \post \P{res} son los ids de los registros r de la tabla con
+   *       particion(valor(campo(particionado), r)) = particion
+   *
+   * \complexity{\O(n_p + borrados de la partición)}
+   */
+  vector<int> ids(int particion) const;
+
+  /**
+   * @brief Indica si una partición tiene algún registro.
+   *
+   * \pre 0 \LEQ particion \LT cantParticiones(particionado(\P{this}))
+   * \post \P{res} \IFF \LNOT vacía?(ids(particion))
+   *
+   * \complexity{\O(1) si la partición no empieza con registros borrados}
+   */
+  bool hayRegistros(int particion) const;
+
+  /**
+   * @brief Estadísticas de los valores de un campo de la tabla
+   *
+   * Se devuelven por referencia no-modificable. Se mantienen al agregar,
+   * borrar y modificar registros, y se recalculan de cero al compactar la
+   * tabla o cuando EstadisticasCampo::desactualizadas().
+   *
+   * \pre campo \IN campos(\P{this})
+   * \complexity{\O(C * L)}
+   */
+  const EstadisticasCampo &estadisticas(const string &campo) const;
+
+  /**
+   * @brief Estadísticas de un campo ya resuelto con campoId
+   *
+   * \pre schema(id) = schema(\P{this})
+   * \complexity{\O(1)}
+   */
+  const EstadisticasCampo &estadisticas(const FieldId &id) const;
+
+  /**
+   * @brief Los registros de la tabla
+   *
+   * Se devuelve por referencia no-modificable. Una vez armado, el conjunto
+   * acompaña los registros que se agregan; se vuelve a armar la primera vez
+   * que se pide después de borrar o actualizar registros. Para recorrer los
+   * registros sin copiarlos usar registros_begin() y registros_end().
+   *
+   * \pre true
+   * \post \P{res} = Registros(\P{this})
+   *
+   * \complexity{\O(n * copy(registro)) si se borraron o actualizaron
+   * registros desde la última llamada, \O(1) sino}
+   */
   const linear_set<Registro>& registros() const;
 
 
+  /**
+   * @brief Forma en que la tabla guarda sus registros
+   *
+   * \pre true
+   * \complexity{\O(1)}
+   */
+  Almacenamiento almacenamiento() const;
+
+  /**
+   * @brief Registro con el id parámetro
+   *
+   * Los ids de los registros son su posición en el orden de inserción,
+   * contando los borrados. El registro se devuelve por copia; si la tabla
+   * guarda sus registros por columnas, se reconstruye.
+   *
+   * \pre id \IN ids(\P{this})
+   * \post \P{res} es el registro insertado en la posición id
+   *
+   * \complexity{\O(copy(registro))}
+   */
+  Registro registro(int id) const;
+
+  /**
+   * @brief Dato en \P{campo} del registro con el id parámetro.
+   *
+   * Si la tabla guarda sus registros por columnas, solo se lee la columna
+   * del campo.
+   *
+   * \pre id \IN ids(\P{this}) \LAND schema(campo) = schema(\P{this})
+   * \post \P{res} = valor(campo, registro(id, \P{this}))
+   *
+   * \complexity{\O(copy(dato))}
+   */
+  Dato dato(int id, const FieldId &campo) const;
+
+  /**
+   * @brief Iterador al registro con el id parámetro.
+   *
+   * \pre el registro id no está borrado
+   *
+   * \complexity{\O(1)}
+   */
+  const_iterador_registros iterador(int id) const;
+
+  /**
+   * @brief Ids de los registros de la tabla, en orden.
+   *
+   * \pre true
+   * \complexity{\O(n + cant_borrados(\P{this}))}
+   */
+  vector<int> ids() const;
+
+  /**
+   * @brief Filtra ids de registros según una restricción
+   *
+   * Deja en \P{ids} solo los registros cuyo dato en \P{campo} es igual (o
+   * distinto, según \P{igualdad}) a \P{valor}. Si la tabla guarda sus
+   * registros por columnas, solo se lee la columna del campo. En las
+   * igualdades, los registros de grupos cuya sinopsis descarta el valor se
+   * sacan sin leerlos.
+   *
+   * \pre schema(campo) = schema(\P{this}) \LAND los ids son válidos y
+   *      están ordenados \LAND
+   *      Nat?(valor) = Nat?(tipoCampo(campo, \P{this}))
+   * \post \P{ids} = ids' filtrados, en el mismo orden
+   *
+   * \complexity{\O(long(ids) * cmp(dato))}
+   */
+  void filtrar(vector<int> &ids, const FieldId &campo, const Dato &valor,
+               bool igualdad) const;
+
+  /**
+   * @brief Filtra ids de registros según una restricción con cualquier
+   * operador
+   *
+   * Las igualdades y desigualdades se resuelven con la versión anterior. En
+   * los rangos sobre nats, los registros de grupos cuyo mínimo y máximo
+   * quedan fuera del rango se sacan sin leerlos.
+   *
+   * \pre schema(campo) = schema(\P{this}) \LAND los ids son válidos y
+   *      están ordenados \LAND campo(r) es el campo \P{campo} \LAND
+   *      Nat?(dato(r)) = Nat?(tipoCampo(campo, \P{this}))
+   * \post \P{ids} = ids' filtrados por cumple(r), en el mismo orden
+   *
+   * \complexity{\O(long(ids) * cmp(dato))}
+   */
+  void filtrar(vector<int> &ids, const FieldId &campo,
+               const Restriccion &r) const;
+
   /**
    * @brief Cantidad de registros de la tabla
    *
@@ -158,31 +550,219 @@ private:
      * rep: tabla \TO bool\n
      * rep(t) \EQUIV 
      *  * \LNOT \EMPTYSET?(claves(_claves)) \LAND
-     *  * claves(_claves) \SUBSETEQ claves(_camposYtipos) \LAND
+     *  * _almacenamiento = POR_FILAS \IMPLIES tam(_columnas) = 0 \LAND
+     *  * _almacenamiento = POR_COLUMNAS \IMPLIES tam(_registros) = 0 \LAND
+     *  * _conjuntoValido \IMPLIES _conjuntoRegistros = registros de la tabla \LAND
+     *  * cada registro no borrado está incorporado a la zona de su grupo en
+     *    _zonas (o la zona está invalidada) \LAND
+     *  * long(_estadisticas) = cantCampos(*_schema) \LAND
+     *  * (tipo(_particionado) = NINGUNO \IFF vacía?(_idsPorParticion)) \LAND
+     *  * cada id de un registro está, en orden, en la lista de su partición
+     *    en _idsPorParticion, si no está vacía \LAND
+     *  * _camposClave tiene un FieldId de _schema por cada clave \LAND
+     *  * (id, h) \IN _idsPorClave \IFF id es de un registro no borrado \LAND
+     *    h = hash de los datos del registro id en _camposClave \LAND
+     *  * claves(_claves) \SUBSETEQ campos(*_schema) \LAND
+     *  * long(_tipos) = cantCampos(*_schema) \LAND
      *  * \FORALL (r : registro) r \IN _registros \IMPLIES (
-     *    * campos(r) = claves(_camposYtipos)
-     *    * \FORALL (c : campo) def?(c, _camposYtipos) \IMPLIES
-     *        Nat?(valor(c, r)) = Nat?(obtener(c, _camposYtipos))
+     *    * schema(r) = _schema
+     *    * \FORALL (i : nat) 0 \LEQ i \LT long(_tipos) \IMPLIES
+     *        Nat?(valor(campo(i, *_schema), r)) = Nat?(_tipos[i])
      *    * no se repiten claves \EQUIV
      *      \LNOT hayCoincidencia(r, claves(_claves), _registros)
      *  * )
      *
      * abs: tabla \TO Tabla\n
      * abs(t) \EQUIV t' \|
-     *  * campos(t') = claves(_camposYtipos) \LAND
+     *  * campos(t') = campos(*_schema) \LAND
      *  * claves(t') = claves(_claves) \LAND
-     *  * \FORALL (c : string) def?(c, _camposYtipos) \IMPLIES tipoCampo(c, t') =
-     *    Nat?(obtener(c, _campostYtipos)) \LAND
-     *  * registros(t') = _registros
+     *  * \FORALL (i : nat) 0 \LEQ i \LT long(_tipos) \IMPLIES
+     *    tipoCampo(campo(i, *_schema), t') = Nat?(_tipos[i]) \LAND
+     *  * registros(t') = conjunto de los registros de _registros o de
+     *    _columnas, según _almacenamiento
      */
     //////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /** @{ */
     string_map<bool> _claves;
-    string_map<Dato> _camposYtipos;
-    linear_set<Registro> _registros;
+    /** @brief Campos de la tabla, compartidos con sus registros. */
+    shared_ptr<const Schema> _schema;
+    /** @brief Tipo de cada campo, indexado por ordinal. */
+    vector<Dato> _tipos;
+    /** @brief Forma en que se guardan los registros. */
+    Almacenamiento _almacenamiento;
+    /** @brief Registros de la tabla, en grupos contiguos (modo POR_FILAS). */
+    ArenaRegistros _registros;
+    /** @brief Registros de la tabla, por columnas (modo POR_COLUMNAS). */
+    ColumnasRegistros _columnas;
+    /** @brief Caracteres de los datos string de los registros de la tabla. */
+    HeapStrings _heap;
+    /** @brief Conjunto de registros que devuelve registros(). */
+    mutable linear_set<Registro> _conjuntoRegistros;
+    /** @brief Indica si _conjuntoRegistros refleja a _registros. */
+    mutable bool _conjuntoValido;
+    /** @brief Claves de la tabla, resueltas contra _schema. */
+    vector<FieldId> _camposClave;
+    /** @brief Ids de los registros, por hash de sus datos clave. */
+    unordered_multimap<size_t, int> _idsPorClave;
+    /** @brief Sinopsis de cada grupo de registros, para saltear grupos. */
+    ZonasRegistros _zonas;
+    /** @brief Estadísticas de cada campo, indexadas por ordinal. */
+    vector<EstadisticasCampo> _estadisticas;
+    /** @brief Forma en que se reparten los registros en particiones. */
+    Particionado _particionado;
+    /** @brief Cantidad de veces que se compactó la tabla. */
+    int _compactaciones;
+    /** @brief Campo de particionado, resuelto contra _schema. */
+    FieldId _campoParticion;
+    /** @brief Ids de cada partición, en orden. Vacío si no hay particiones. */
+    vector<vector<int> > _idsPorParticion;
     /** }@ */
 
+    /**
+     * @brief Dato de \P{r} en el campo clave \P{campo}, o NULL si \P{r} no
+     * tiene ese campo (un registro por fuera de la descripción de la tabla).
+     *
+     * \complexity{\O(1) si schema(campo) = schema(r), \O(C * L) sino}
+     */
+    static const Dato *_datoClave(const Registro &r, const FieldId &campo);
+
+    /**
+     * @brief Inicializa una tabla sin registros cuyo schema es \P{schema}.
+     *
+     * \pre campos(*schema) = campos \LAND las de Tabla(claves, campos, tipos,
+     *      almacenamiento, particionado)
+     *
+     * \complexity{\O(long(campos) * (copy(campo) + copy(dato)))}
+     */
+    Tabla(const linear_set<string> &claves,
+          const shared_ptr<const Schema> &schema,
+          const vector<string> &campos, const vector<Dato> &tipos,
+          Almacenamiento almacenamiento, const Particionado &particionado);
+
+    /**
+     * @brief Hash de los datos de \P{r} en los campos clave. Los campos
+     * clave que \P{r} no tiene no aportan al hash.
+     *
+     * \complexity{\O(c)}
+     */
+    size_t _hashClave(const Registro &r) const;
+
+    /**
+     * @brief Id del registro con las claves de \P{r}, o -1 si no hay.
+     *
+     * \pre h = _hashClave(r)
+     *
+     * \complexity{\O(c * cmp(dato)) esperado}
+     */
+    int _buscarClave(const Registro &r, size_t h) const;
+
+    /**
+     * @brief Id de un registro igual a \P{r}, o -1 si no hay.
+     *
+     * \pre h = _hashClave(r)
+     *
+     * \complexity{\O(copy(registro)) esperado}
+     */
+    int _buscarRegistro(const Registro &r, size_t h) const;
+
+    /**
+     * @brief Agrega el registro sin buscar claves repetidas y devuelve su id.
+     *
+     * \pre campos(r) = campos(\P{this}) \LAND h = _hashClave(r) \LAND
+     *      _buscarClave(r, h) = -1
+     *
+     * \complexity{\O(copy(registro)) esperado}
+     */
+    int _agregar(const Registro &r, size_t h);
+
+    /**
+     * @brief Agrega el registro \P{id}, recién incorporado a la tabla, a
+     * _conjuntoRegistros si está armado, para no tener que rearmarlo.
+     *
+     * \complexity{\O(copy(registro))}
+     */
+    void _anotarEnConjunto(int id);
+
+    /**
+     * @brief Indica si ningún par de registros de \P{regs} comparte claves.
+     *
+     * \complexity{\O(long(regs) * c * cmp(dato)) esperado}
+     */
+    bool _clavesDistintas(const vector<Registro> &regs) const;
+
+    /**
+     * @brief Datos del registro \P{id} con los cambios aplicados, indexados
+     * por ordinal.
+     *
+     * \complexity{\O(C * L)}
+     */
+    vector<Dato> _actualizados(int id, const Registro &cambios) const;
+
+    /**
+     * @brief Incorpora los datos de un registro, indexados por ordinal, a las
+     * estadísticas de cada campo.
+     *
+     * \complexity{\O(C * (L + EstadisticasCampo::CANT_FRECUENTES * cmp(dato)))}
+     */
+    void _agregarEstadisticas(const vector<Dato> &datos);
+
+    /**
+     * @brief Quita los datos de \P{r} de las estadísticas de cada campo, si
+     * \P{r} tiene el schema de la tabla.
+     *
+     * \complexity{\O(C * (CANT_FRECUENTES * cmp(dato) + TAM_MUESTRA))}
+     */
+    void _quitarEstadisticas(const Registro &r);
+
+    /**
+     * @brief Recalcula de cero las estadísticas si están desactualizadas.
+     *
+     * \complexity{\O(PROPORCION_QUITADOS * C * (L + CANT_FRECUENTES *
+     * cmp(dato))) amortizado por registro quitado}
+     */
+    void _revisarEstadisticas();
+
+    /**
+     * @brief Partición de un registro. Si no tiene el campo de particionado,
+     * la 0.
+     *
+     * \complexity{\O(C * L)}
+     */
+    int _particion(const Registro &r) const;
+
+    /**
+     * @brief Agrega el id al final de la lista de la partición de \P{r}.
+     *
+     * \pre id es mayor a todos los ids de la tabla
+     *
+     * \complexity{\O(C * L) amortizado}
+     */
+    void _asignarParticion(int id, const Registro &r);
+
+    /**
+     * @brief Indica si el registro \P{id} está borrado.
+     *
+     * \complexity{\O(1)}
+     */
+    bool _borrado(int id) const;
+
+    /**
+     * @brief Saca el registro \P{id} del índice por hash de claves.
+     *
+     * \pre h = _hashClave(registro(id))
+     *
+     * \complexity{\O(1) esperado}
+     */
+    void _olvidarClave(int id, size_t h);
+
+    /**
+     * @brief Cantidad de ids usados, contando los registros borrados.
+     *
+     * \complexity{\O(1)}
+     */
+    int _tamIds() const;
+
 };
 
 bool operator==(const Tabla&, const Tabla&);
@@ -0,0 +1,129 @@
+#include "ZonasRegistros.h"
+
+const int ZonasRegistros::BITS_BLOOM;
+
+ZonasRegistros::ZonasRegistros() {}
+
+ZonasRegistros::ZonasRegistros(const vector<Dato> &tipos) {
+    for (const Dato &tipo : tipos) {
+        _esNat.push_back(tipo.esNat());
+    }
+}
+
+void ZonasRegistros::agregar(int id, const vector<Dato> &datos) {
+    Zona &zona = _zona(id);
+    for (size_t i = 0; i < _esNat.size(); ++i) {
+        Sinopsis &s = zona.campos[i];
+        if (_esNat[i]) {
+            int valor = datos[i].valorNat();
+            if (zona.vacia or valor < s.minimo) {
+                s.minimo = valor;
+            }
+            if (zona.vacia or valor > s.maximo) {
+                s.maximo = valor;
+            }
+        } else {
+            pair<int, int> bits = _bits(datos[i]);
+            s.bloom[bits.first / 64] |= uint64_t(1) << (bits.first % 64);
+            s.bloom[bits.second / 64] |= uint64_t(1) << (bits.second % 64);
+        }
+    }
+    zona.vacia = false;
+}
+
+void ZonasRegistros::invalidar(int id) {
+    _zona(id).invalida = true;
+}
+
+bool ZonasRegistros::puedeContener(int grupo, int ordinal,
+                                   const Dato &valor) const {
+    if (grupo >= (int) _zonas.size()) {
+        return false;
+    }
+    const Zona &zona = _zonas[grupo];
+    if (zona.invalida) {
+        return true;
+    }
+    if (zona.vacia) {
+        return false;
+    }
+    const Sinopsis &s = zona.campos[ordinal];
+    if (_esNat[ordinal]) {
+        return s.minimo <= valor.valorNat() and valor.valorNat() <= s.maximo;
+    }
+    pair<int, int> bits = _bits(valor);
+    return (s.bloom[bits.first / 64] >> (bits.first % 64) & 1) and
+           (s.bloom[bits.second / 64] >> (bits.second % 64) & 1);
+}
+
+void ZonasRegistros::descartar(vector<int> &ids, int ordinal,
+                               const Dato &valor) const {
+    int quedan = 0;
+    int grupoActual = -1;
+    bool puede = false;
+    for (int id : ids) {
+        int grupo = id / ArenaRegistros::TAM_GRUPO;
+        if (grupo != grupoActual) {
+            grupoActual = grupo;
+            puede = puedeContener(grupo, ordinal, valor);
+        }
+        if (puede) {
+            ids[quedan++] = id;
+        }
+    }
+    ids.resize(quedan);
+}
+
+void ZonasRegistros::descartarFuera(vector<int> &ids, int ordinal, int desde,
+                                    int hasta) const {
+    int quedan = 0;
+    int grupoActual = -1;
+    bool puede = false;
+    for (int id : ids) {
+        int grupo = id / ArenaRegistros::TAM_GRUPO;
+        if (grupo != grupoActual) {
+            grupoActual = grupo;
+            if (grupo >= (int) _zonas.size()) {
+                puede = false;
+            } else if (_zonas[grupo].invalida or _zonas[grupo].vacia) {
+                puede = _zonas[grupo].invalida;
+            } else {
+                const Sinopsis &s = _zonas[grupo].campos[ordinal];
+                puede = s.minimo <= hasta and desde <= s.maximo;
+            }
+        }
+        if (puede) {
+            ids[quedan++] = id;
+        }
+    }
+    ids.resize(quedan);
+}
+
+int ZonasRegistros::cantGrupos() const {
+    return _zonas.size();
+}
+
+ZonasRegistros::Zona &ZonasRegistros::_zona(int id) {
+    int grupo = id / ArenaRegistros::TAM_GRUPO;
+    while ((int) _zonas.size() <= grupo) {
+        Zona nueva;
+        nueva.vacia = true;
+        nueva.invalida = false;
+        nueva.campos.resize(_esNat.size());
+        for (size_t i = 0; i < _esNat.size(); ++i) {
+            nueva.campos[i].minimo = 0;
+            nueva.campos[i].maximo = 0;
+            if (not _esNat[i]) {
+                nueva.campos[i].bloom.resize(BITS_BLOOM / 64, 0);
+            }
+        }
+        _zonas.push_back(nueva);
+    }
+    return _zonas[grupo];
+}
+
+pair<int, int> ZonasRegistros::_bits(const Dato &valor) {
+    size_t h = hashDato(valor);
+    // Dos posiciones a partir de un solo hash
+    return make_pair(h % BITS_BLOOM, (uint64_t(h) >> 32) % BITS_BLOOM);
+}
@@ -0,0 +1,181 @@
+#ifndef ZONASREGISTROS_H
+#define ZONASREGISTROS_H
+
+#include <cstdint>
+#include <vector>
+#include "Dato.h"
+#include "ArenaRegistros.h"
+
+using namespace std;
+
+/**
+ * @brief Resumen de los datos de cada grupo de registros de una tabla.
+ *
+ * Los registros se agrupan por id, de a ArenaRegistros::TAM_GRUPO, igual que
+ * en el arena. Para cada grupo y cada campo se guarda una sinopsis: el mínimo
+ * y el máximo si el campo es nat, o un filtro de Bloom si es string. Con la
+ * sinopsis se puede saber, sin leer los registros, que ningún registro del
+ * grupo tiene un valor dado.
+ *
+ * Las sinopsis solo crecen: borrar o modificar un registro no las achica, así
+ * que pueden admitir valores que el grupo ya no tiene, pero nunca descartan
+ * un valor que sí tiene.
+ *
+ * **se explica con** Secu(Conjunto(Dato))
+ */
+class ZonasRegistros {
+
+public:
+
+    /** @brief Cantidad de bits del filtro de Bloom de cada campo string. */
+    static const int BITS_BLOOM = 2048;
+
+    /**
+     * @brief Inicializa un resumen sin campos ni grupos.
+     *
+     * \complexity{\O(1)}
+     */
+    ZonasRegistros();
+
+    /**
+     * @brief Inicializa un resumen sin grupos, con un campo por tipo.
+     *
+     * \pre true
+     * \post \P{res} no tiene grupos \LAND el campo i es del tipo de tipos[i]
+     *
+     * \complexity{\O(long(tipos))}
+     */
+    ZonasRegistros(const vector<Dato> &tipos);
+
+    /**
+     * @brief Incorpora los datos del registro \P{id} a la sinopsis de su
+     * grupo.
+     *
+     * Se usa al agregar un registro y al modificarlo.
+     *
+     * \pre long(datos) = cantidad de campos \LAND cada dato tiene el tipo de
+     * su campo
+     * \post puedeContener(grupo(id), i, datos[i]) para todo campo i
+     *
+     * \complexity{\O(C * L)}
+     */
+    void agregar(int id, const vector<Dato> &datos);
+
+    /**
+     * @brief Hace que el grupo del registro \P{id} admita cualquier valor.
+     *
+     * Se usa para registros cuyos datos no siguen los campos de la tabla.
+     *
+     * \pre id \GEQ 0
+     * \post puedeContener(grupo(id), i, d) para todo campo i y dato d
+     *
+     * \complexity{\O(1)}
+     */
+    void invalidar(int id);
+
+    /**
+     * @brief Indica si algún registro del grupo puede tener \P{valor} en el
+     * campo \P{ordinal}.
+     *
+     * Puede dar falsos positivos, nunca falsos negativos.
+     *
+     * \pre Nat?(valor) = tipo del campo ordinal
+     *
+     * \complexity{\O(1) si Nat?(valor), \O(L) sino}
+     */
+    bool puedeContener(int grupo, int ordinal, const Dato &valor) const;
+
+    /**
+     * @brief Saca de \P{ids} los registros cuyo grupo no puede tener
+     * \P{valor} en el campo \P{ordinal}.
+     *
+     * La sinopsis de cada grupo se consulta una sola vez.
+     *
+     * \pre ids ordenados \LAND Nat?(valor) = tipo del campo ordinal
+     * \post \P{ids} = ids' sin los de grupos descartados, en el mismo orden
+     *
+     * \complexity{\O(long(ids) + G * L), con G la cantidad de grupos}
+     */
+    void descartar(vector<int> &ids, int ordinal, const Dato &valor) const;
+
+    /**
+     * @brief Saca de \P{ids} los registros cuyo grupo no puede tener valores
+     * en [desde, hasta] en el campo nat \P{ordinal}.
+     *
+     * \pre ids ordenados \LAND el campo ordinal es nat
+     * \post \P{ids} = ids' sin los de grupos cuyo mínimo es mayor a hasta o
+     *       cuyo máximo es menor a desde, en el mismo orden
+     *
+     * \complexity{\O(long(ids))}
+     */
+    void descartarFuera(vector<int> &ids, int ordinal, int desde,
+                        int hasta) const;
+
+    /**
+     * @brief Cantidad de grupos resumidos.
+     *
+     * \complexity{\O(1)}
+     */
+    int cantGrupos() const;
+
+private:
+
+    /** @brief Sinopsis de un campo en un grupo. */
+    struct Sinopsis {
+        /** @brief Mínimo valor del campo, si es nat. */
+        int minimo;
+        /** @brief Máximo valor del campo, si es nat. */
+        int maximo;
+        /** @brief Filtro de Bloom de los valores del campo, si es string. */
+        vector<uint64_t> bloom;
+    };
+
+    /** @brief Sinopsis de todos los campos de un grupo. */
+    struct Zona {
+        /** @brief Indica si el grupo tiene algún registro resumido. */
+        bool vacia;
+        /** @brief Indica si el grupo admite cualquier valor. */
+        bool invalida;
+        /** @brief Sinopsis de cada campo, indexadas por ordinal. */
+        vector<Sinopsis> campos;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \name Representación
+     * rep: zonasregistros \TO bool\n
+     * rep(z) \EQUIV \FORALL (zona : Zona) zona \IN _zonas \IMPLIES (
+     *  * long(zona.campos) = long(_esNat) \LAND
+     *  * \FORALL (i : nat) i \LT long(_esNat) \IMPLIES (
+     *    * _esNat[i] \IMPLIES vacía?(zona.campos[i].bloom) \LAND
+     *    * \LNOT _esNat[i] \IMPLIES long(zona.campos[i].bloom) * 64 = BITS_BLOOM
+     *  * ))
+     *
+     * abs: zonasregistros \TO Secu(Conjunto(Dato))\n
+     * abs(z) \EQUIV s \| long(s) = long(_zonas) \LAND cada s[g] contiene los
+     * datos incorporados a _zonas[g]
+     */
+    //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /** @{ */
+    /** @brief Tipo de cada campo, indexado por ordinal. */
+    vector<bool> _esNat;
+    /** @brief Zonas, indexadas por grupo. */
+    vector<Zona> _zonas;
+    /** @} */
+
+    /**
+     * @brief Zona del grupo del registro \P{id}. Si no existe, la crea.
+     *
+     * \complexity{\O(C) amortizado}
+     */
+    Zona &_zona(int id);
+
+    /**
+     * @brief Posiciones del filtro de Bloom que marca un string.
+     *
+     * \complexity{\O(L)}
+     */
+    static pair<int, int> _bits(const Dato &valor);
+};
+
+#endif // ZONASREGISTROS_H
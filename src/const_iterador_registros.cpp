@@ -1,28 +1,83 @@
 #include "const_iterador_registros.h"
 
 Tabla::const_iterador_registros::const_iterador_registros(const const_iterador_registros& o_it) :
-  it_registro(o_it.it_registro) {}
+  grupo(o_it.grupo), pos(o_it.pos), tabla(o_it.tabla), idApuntado(o_it.idApuntado) {}
+
+Tabla::const_iterador_registros &
+Tabla::const_iterador_registros::operator=(const const_iterador_registros& o_it) {
+  grupo = o_it.grupo;
+  pos = o_it.pos;
+  tabla = o_it.tabla;
+  idApuntado = o_it.idApuntado;
+  reconstruido.reset();
+  return *this;
+}
 
 const Registro& Tabla::const_iterador_registros::operator*() const {
-  return *it_registro;
+  return registro();
 }
 
 const Registro *Tabla::const_iterador_registros::operator->() const {
-  return &(*it_registro);
+  return &registro();
 }
 
 Tabla::const_iterador_registros& Tabla::const_iterador_registros::operator++() {
-  ++it_registro;
+  avanzar();
+  saltarBorrados();
   return *this;
 }
 
+void Tabla::const_iterador_registros::avanzar() {
+  if (tabla != nullptr) {
+    ++idApuntado;
+    reconstruido.reset();
+    return;
+  }
+  ++pos;
+  if (pos == (int) grupo->registros.size()) {
+    // Si el grupo está completo sigo en el siguiente; si no, es el último
+    grupo = grupo->siguiente;
+    pos = 0;
+  }
+}
+
+void Tabla::const_iterador_registros::saltarBorrados() {
+  if (tabla != nullptr) {
+    while (idApuntado < tabla->_columnas.tam() and tabla->_columnas.borrado(idApuntado)) {
+      avanzar();
+    }
+    return;
+  }
+  while (grupo != nullptr and grupo->borrados[pos]) {
+    avanzar();
+  }
+}
+
+int Tabla::const_iterador_registros::id() const {
+  return tabla == nullptr ? grupo->primerId + pos : idApuntado;
+}
+
 bool Tabla::const_iterador_registros::operator==(const Tabla::const_iterador_registros& o_it) const {
-  return it_registro == o_it.it_registro;
+  return grupo == o_it.grupo and pos == o_it.pos and
+         tabla == o_it.tabla and idApuntado == o_it.idApuntado;
 }
 
 bool Tabla::const_iterador_registros::operator!=(const Tabla::const_iterador_registros& o_it) const {
-  return not (it_registro == o_it.it_registro);
+  return not (*this == o_it);
 }
 
-Tabla::const_iterador_registros::const_iterador_registros(const linear_set<Registro>::const_iterator _it_registro) :
-    it_registro(_it_registro) {}
+Tabla::const_iterador_registros::const_iterador_registros(const ArenaRegistros::Grupo *_grupo, int _pos) :
+    grupo(_grupo), pos(_pos), tabla(nullptr), idApuntado(0) {}
+
+Tabla::const_iterador_registros::const_iterador_registros(const Tabla *_tabla, int _id) :
+    grupo(nullptr), pos(0), tabla(_tabla), idApuntado(_id) {}
+
+const Registro &Tabla::const_iterador_registros::registro() const {
+  if (tabla == nullptr) {
+    return grupo->registros[pos];
+  }
+  if (not reconstruido) {
+    reconstruido = make_shared<const Registro>(tabla->registro(idApuntado));
+  }
+  return *reconstruido;
+}
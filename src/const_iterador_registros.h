@@ -3,10 +3,22 @@
 
 #include "Tabla.h"
 
-/** @brief Iterador de los registros de una tabla */
+/**
+ * @brief Iterador de los registros de una tabla
+ *
+ * Si la tabla guarda sus registros por columnas, el registro apuntado se
+ * reconstruye al desreferenciar el iterador y vive mientras el iterador no
+ * avance. En ese modo el iterador se invalida si la tabla se mueve.
+ */
 class Tabla::const_iterador_registros {
 
 public:
+  using iterator_category = forward_iterator_tag;
+  using value_type = Registro;
+  using difference_type = ptrdiff_t;
+  using pointer = const Registro*;
+  using reference = const Registro&;
+
   /**
    * @brief Constructor por copia del iterador.
    *
@@ -14,10 +26,18 @@ public:
    */
   const_iterador_registros(const const_iterador_registros& o_it);
 
+  /**
+   * @brief Asignación por copia del iterador.
+   *
+   * \complexity{\O(1)}
+   */
+  const_iterador_registros& operator=(const const_iterador_registros& o_it);
+
   /**
    * @brief Desreferencia el puntero
    *
-   * El valor devuelto tiene aliasing dentro de la colección.
+   * El valor devuelto tiene aliasing dentro de la colección (o dentro del
+   * iterador, si la tabla guarda sus registros por columnas).
    *
    * \pre El iterador no debe estar en la posición pasando-el-último.
    * \post El valor resultado es una referencia constante al valor apuntado.
@@ -41,14 +61,28 @@ public:
   /**
    * @brief Avanza el iterador una posición.
    *
+   * Los registros se recorren en orden de inserción, grupo por grupo,
+   * salteando los borrados.
+   *
    * \pre El iterador no debe estar en la posición pasando-el-último.
    * \post \P{res} es una referencia a \P{this}. \P{this} apunta a la posición
    * siguiente.
    *
-   * \complexity{\O(1)}
+   * \complexity{\O(1) amortizado, mientras la tabla no tenga más borrados
+   * que registros}
    */
   const_iterador_registros& operator++();
 
+  /**
+   * @brief Id en la tabla del registro apuntado.
+   *
+   * \pre El iterador no debe estar en la posición pasando-el-último.
+   * \post \P{res} es el id con el que Tabla::iterador devuelve este registro
+   *
+   * \complexity{\O(1)}
+   */
+  int id() const;
+
   /**
    * @brief Comparación entre iteradores 
    *
@@ -72,9 +106,36 @@ public:
 private:
   friend class Tabla;
 
-  const_iterador_registros(const linear_set<Registro>::const_iterator);
+  const_iterador_registros(const ArenaRegistros::Grupo *grupo, int pos);
+
+  const_iterador_registros(const Tabla *tabla, int id);
+
+  /**
+   * @brief Registro apuntado. Si la tabla guarda sus registros por columnas,
+   * lo reconstruye la primera vez.
+   */
+  const Registro &registro() const;
+
+  /** @brief Avanza una posición, aunque el registro esté borrado. */
+  void avanzar();
+
+  /** @brief Avanza hasta un registro no borrado o hasta pasando-el-último. */
+  void saltarBorrados();
+
+  /** @brief Grupo del registro apuntado, o NULL en pasando-el-último (modo POR_FILAS). */
+  const ArenaRegistros::Grupo *grupo;
+
+  /** @brief Posición del registro apuntado dentro del grupo (modo POR_FILAS). */
+  int pos;
+
+  /** @brief Tabla recorrida (modo POR_COLUMNAS), NULL en modo POR_FILAS. */
+  const Tabla *tabla;
+
+  /** @brief Id del registro apuntado (modo POR_COLUMNAS). */
+  int idApuntado;
 
-  linear_set<Registro>::const_iterator it_registro;
+  /** @brief Registro reconstruido (modo POR_COLUMNAS), NULL si todavía no se armó. */
+  mutable shared_ptr<const Registro> reconstruido;
 
 };
 
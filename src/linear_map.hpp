@@ -88,6 +88,7 @@ typename linear_map<K, S>::size_type linear_map<K, S>::erase(const K& key) {
       return 1;
     }
   }
+  return 0;
 }
 
 template<class K, class S>
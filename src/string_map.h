@@ -164,6 +164,15 @@ public:
      */
     const_iterator find(const key_type &key) const;
 
+    /** @brief busca la menor clave mayor o igual a una dada
+     *  @param key clave a buscar
+     *  @returns un iterador const al primer par (en orden lexicografico) cuya
+     *  clave no es menor a key, o end() si no hay
+     *
+     *  \complexity{\O(S)}
+     */
+    const_iterator lower_bound(const key_type &key) const;
+
     /** @brief insercion
      *
      * @param value par <clave,significado> a insertar
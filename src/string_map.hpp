@@ -203,6 +203,50 @@ typename string_map<T>::iterator string_map<T>::find(const key_type &key){
     return it;
 }
 
+//devuelve un iterador a la menor clave mayor o igual a key
+template <typename T>
+typename string_map<T>::const_iterator string_map<T>::lower_bound(const key_type &key) const{
+    string_map<T>::const_iterator it(NULL);
+    if(empty()){
+        return it;
+    }
+    //siguiente es el hermano mayor mas cercano de algun nodo del camino de
+    //key: el mas profundo tiene las claves mayores a key mas chicas
+    Nodo* seeker = raiz;
+    Nodo* siguiente = NULL;
+    u_int i = 0;
+    while(i < key.size()){
+        for(int j = int(key[i]) + 1; j < 256; j++){
+            if((seeker->hijos)[j] != NULL){
+                siguiente = (seeker->hijos)[j];
+                break;
+            }
+        }
+        if((seeker->hijos)[int(key[i])] == NULL){
+            break;
+        }
+        seeker = (seeker->hijos)[int(key[i])];
+        i++;
+    }
+    if(i == key.size()){
+        //todas las claves del subarbol de seeker empiezan con key
+        if(seeker->definicion != NULL){
+            it.nodo = seeker;
+            return it;
+        }
+        for(int j = 0; j < 256; j++){
+            if((seeker->hijos)[j] != NULL){
+                siguiente = (seeker->hijos)[j];
+                break;
+            }
+        }
+    }
+    if(siguiente != NULL){
+        it.nodo = siguiente->definicion != NULL ? siguiente : siguiente->minimo();
+    }
+    return it;
+}
+
 //devuelve un iterador a la clave
 template <typename T>
 typename string_map<T>::const_iterator string_map<T>::find(const key_type &key) const{
@@ -285,7 +329,6 @@ typename string_map<T>::iterator& string_map<T>::iterator::operator=(const itera
 template <typename T>
 typename string_map<T>::iterator string_map<T>::erase(string_map<T>::iterator pos){
     Nodo* aux = pos.nodo;
-    Nodo* temp = aux->padre;
     typename string_map<T>::key_type key = pos.nodo->definicion->first;
     typename string_map<T>::iterator res = ++pos;
     int tam = key.size()-1;
@@ -425,6 +468,7 @@ typename string_map<T>::Nodo* string_map<T>::Nodo::minimo(){
             i =0;
         }
     }
+    return NULL;
 }
 
 template <typename T>
@@ -493,25 +537,20 @@ void string_map<T>::eliminarRec(string_map<T>::Nodo* n){
 template <typename T>
 void string_map<T>::restablecerCadena(typename string_map<T>::Nodo* n, string_map<T>::key_type key, int posicion){
     //entro sabiendo que n no tiene hijos y no soy raiz
-    typename string_map<T>::Nodo* aux = n->padre;
     delete n->definicion;
     n->definicion = NULL;
+    //subo descontando la definicion en cada ancestro, y borro los nodos que
+    //quedan sin definicion propia ni definiciones debajo
     bool borrar = true;
     while(n->padre != n){
-        if(aux->cant_hijos == 1){
+        typename string_map<T>::Nodo* aux = n->padre;
+        if(borrar){
             delete aux->hijos[int(key[posicion])];
             aux->hijos[int(key[posicion])] = NULL;
-            borrar = true;
-        }else if(aux->cant_hijos > 1 && borrar){
-            delete aux->hijos[int(key[posicion])];
-            aux->hijos[int(key[posicion])] = NULL;
-            borrar = false;
-        }else{
-            aux->cant_hijos --;
-            borrar = false;
         }
+        aux->cant_hijos--;
+        borrar = borrar && aux->cant_hijos == 0 && aux->definicion == NULL;
         n = aux;
-        aux = n->padre;
         posicion--;
     }
 }
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+
+#include <map>
+#include "../src/ArbolBMas.h"
+
+TEST(arbol_b_mas_test, vacio) {
+    ArbolBMas a;
+    EXPECT_EQ(a.tam(), 0);
+    EXPECT_EQ(a.buscar(3), nullptr);
+    EXPECT_TRUE(a.begin() == a.end());
+    EXPECT_TRUE(a.lower_bound(0) == a.end());
+}
+
+TEST(arbol_b_mas_test, definir_y_buscar) {
+    ArbolBMas a;
+    map<int, vector<int> > esperado;
+    // Claves desordenadas, suficientes para varios niveles
+    for (int i = 0; i < 5000; i++) {
+        int clave = (i * 7919) % 10007;
+        a[clave].push_back(i);
+        esperado[clave].push_back(i);
+        a[clave / 2].push_back(-i);
+        esperado[clave / 2].push_back(-i);
+    }
+    EXPECT_EQ(a.tam(), esperado.size());
+    for (const auto &p : esperado) {
+        ASSERT_NE(a.buscar(p.first), nullptr);
+        EXPECT_EQ(*a.buscar(p.first), p.second);
+    }
+    EXPECT_EQ(a.buscar(-1), nullptr);
+    EXPECT_EQ(a.buscar(20000), nullptr);
+
+    // Recorrido hacia adelante en orden
+    auto itEsperado = esperado.begin();
+    for (auto it = a.begin(); it != a.end(); ++it, ++itEsperado) {
+        EXPECT_EQ(it.clave(), itEsperado->first);
+        EXPECT_EQ(it.significado(), itEsperado->second);
+    }
+    EXPECT_TRUE(itEsperado == esperado.end());
+
+    // Recorrido hacia atrás desde el final
+    auto it = a.end();
+    for (auto r = esperado.rbegin(); r != esperado.rend(); ++r) {
+        --it;
+        EXPECT_EQ(it.clave(), r->first);
+    }
+    EXPECT_TRUE(it == a.begin());
+}
+
+TEST(arbol_b_mas_test, rangos) {
+    ArbolBMas a;
+    for (int i = 0; i < 1000; i++) {
+        a[3 * i].push_back(i);
+    }
+    EXPECT_EQ(a.lower_bound(30).clave(), 30);
+    EXPECT_EQ(a.upper_bound(30).clave(), 33);
+    EXPECT_EQ(a.lower_bound(31).clave(), 33);
+    EXPECT_EQ(a.lower_bound(-5).clave(), 0);
+    EXPECT_TRUE(a.lower_bound(2998) == a.end());
+    EXPECT_TRUE(a.upper_bound(2997) == a.end());
+
+    // [100, 200): claves 102, 105, ..., 198
+    int cant = 0;
+    for (auto it = a.lower_bound(100); it != a.lower_bound(200); ++it) {
+        EXPECT_EQ(it.clave() % 3, 0);
+        cant++;
+    }
+    EXPECT_EQ(cant, 33);
+
+    // Hacia atrás desde una cota superior
+    auto it = a.upper_bound(200);
+    --it;
+    EXPECT_EQ(it.clave(), 198);
+    --it;
+    EXPECT_EQ(it.clave(), 195);
+}
+
+TEST(arbol_b_mas_test, copia) {
+    ArbolBMas a;
+    for (int i = 0; i < 200; i++) {
+        a[i].push_back(i);
+    }
+    ArbolBMas b = a;
+    b[500].push_back(1);
+    b[3].push_back(4);
+    EXPECT_EQ(a.tam(), 200);
+    EXPECT_EQ(b.tam(), 201);
+    EXPECT_EQ(*a.buscar(3), vector<int>({3}));
+    EXPECT_EQ(*b.buscar(3), vector<int>({3, 4}));
+}
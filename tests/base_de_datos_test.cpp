@@ -2,6 +2,9 @@
 #include "../src/Dato.h"
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
 #include <vector>
 #include <string>
 
@@ -218,6 +221,7 @@ protected:
 // * Criterio simple, inválido por tipo (✓)
 // * Criterio doble, inválido por nombre (✓)
 // * Criterio doble, inválido por tipo (✓)
+// * Criterio de rango y prefijo (✓)
 // ## Uso Criterio
 // * Uso un criterio (✓)
 // * Uso criterio perm (✓)
@@ -252,16 +256,16 @@ TEST_F(DBAlumnos, agregar_registro) {
 
   vector<Registro> regs = {alu1, alu2, alu3};
 
-  for (int i = 0; i < regs.size(); i++) { // Voy agregando de a uno
+  for (size_t i = 0; i < regs.size(); i++) { // Voy agregando de a uno
     EXPECT_EQ(db.dameTabla("libretas").registros().size(), cant_libretas + i);
-    for (int j = i; j < regs.size(); j++) { // Antes de agregar faltan el resto
+    for (size_t j = i; j < regs.size(); j++) { // Antes de agregar faltan el resto
       EXPECT_FALSE(db.dameTabla("libretas").registros().count(regs[j]));
     }
     db.agregarRegistro(regs[i], "libretas");
     // Ahora no falta el agregado
     EXPECT_TRUE(db.dameTabla("libretas").registros().count(regs[i]));
     // Pero siguen faltando los otros
-    for (int j = i + 1; j < regs.size(); j++) {
+    for (size_t j = i + 1; j < regs.size(); j++) {
       EXPECT_FALSE(db.dameTabla("libretas").registros().count(regs[j]));
     }
     // Se actualizó la cantidad de registros
@@ -336,10 +340,767 @@ TEST_F(DBAlumnos, validar_registro) {
           "alumnos"));
 }
 
+TEST_F(DBAlumnos, agregar_registros) {
+  db.crearIndice("libretas", "LU");
+  int cant_libretas = db.dameTabla("libretas").cant_registros();
+  Registro alu1 = registro(def_libretas,
+                           {datoNat(10), datoNat(10), datoStr("10/10")});
+  Registro alu2 = registro(def_libretas,
+                           {datoNat(11), datoNat(10), datoStr("11/10")});
+  Registro repetido = registro(def_libretas,
+                               {datoNat(1), datoNat(90), datoStr("1/90")});
+  Registro malTipo = Registro({"LU_N", "LU_A", "LU"},
+                              {datoNat(12), datoStr("10"), datoStr("12/10")});
+
+  // Si algún registro no es válido no se agrega ninguno
+  EXPECT_FALSE(db.agregarRegistros({alu1, alu2, repetido}, "libretas"));
+  EXPECT_FALSE(db.agregarRegistros({alu1, malTipo}, "libretas"));
+  EXPECT_FALSE(db.agregarRegistros({alu1, alu2, alu1}, "libretas"));
+  EXPECT_EQ(db.dameTabla("libretas").cant_registros(), cant_libretas);
+  EXPECT_TRUE(db.dameIndice("libretas", "LU")->noTieneRegistros(datoStr("10/10")));
+
+  EXPECT_TRUE(db.agregarRegistros({alu1, alu2}, "libretas"));
+  EXPECT_EQ(db.dameTabla("libretas").cant_registros(), cant_libretas + 2);
+  EXPECT_TRUE(db.dameTabla("libretas").registros().count(alu1));
+  EXPECT_TRUE(db.dameTabla("libretas").registros().count(alu2));
+  EXPECT_FALSE(db.registroValido(alu1, "libretas"));
+  const Indice *ind = db.dameIndice("libretas", "LU");
+  EXPECT_EQ(**ind->dameRegistros_begin(datoStr("11/10")), alu2);
+  EXPECT_TRUE(db.agregarRegistros({}, "libretas"));
+}
+
+TEST_F(DBAlumnos, borrar_registros) {
+  db.crearIndice("alumnos", "Editor");
+  int cant = db.dameTabla("alumnos").cant_registros();
+  BaseDeDatos::Criterio c = {Rig("Editor", "Vim"), Rdif("OS", "Linux")};
+  int borrados = db.busqueda(c, "alumnos").cant_registros();
+
+  EXPECT_EQ(db.borrarRegistros(c, "alumnos"), borrados);
+  EXPECT_EQ(db.dameTabla("alumnos").cant_registros(), cant - borrados);
+  EXPECT_EQ(db.busqueda(c, "alumnos").cant_registros(), 0);
+  const Indice *ind = db.dameIndice("alumnos", "Editor");
+  for (auto it = ind->dameRegistros_begin(datoStr("Vim"));
+       it != ind->dameRegistros_end(datoStr("Vim")); ++it) {
+    EXPECT_EQ((*it)->dato("OS"), datoStr("Linux"));
+  }
+  // Borrar no renumera los registros: las selecciones siguen vigentes
+  Seleccion antes = db.busqueda({}, "alumnos");
+  EXPECT_EQ(db.borrarRegistros({}, "alumnos"), cant - borrados);
+  EXPECT_EQ(db.dameTabla("alumnos").cant_registros(), 0);
+  EXPECT_EQ(db.dameTabla("alumnos").cant_borrados(), cant);
+  EXPECT_TRUE(antes.idsVigentes());
+  // Compactar libera el lugar, rearma los índices e invalida las selecciones
+  db.compactar("alumnos");
+  EXPECT_EQ(db.dameTabla("alumnos").cant_borrados(), 0);
+  EXPECT_FALSE(antes.idsVigentes());
+  EXPECT_TRUE(db.busqueda({}, "alumnos").idsVigentes());
+  EXPECT_TRUE(db.dameIndice("alumnos", "Editor")->noTieneRegistros(datoStr("Vim")));
+  // Las claves borradas se pueden volver a usar
+  Registro gerva = registro(def_alumnos, {datoStr("1/90"), datoStr("Gerva"),
+                                          datoStr("Vim"), datoStr("Win")});
+  EXPECT_TRUE(db.registroValido(gerva, "alumnos"));
+  db.agregarRegistro(gerva, "alumnos");
+  EXPECT_FALSE(db.dameIndice("alumnos", "Editor")->noTieneRegistros(datoStr("Vim")));
+}
+
+TEST_F(DBAlumnos, actualizar_registros) {
+  db.crearIndice("alumnos", "Editor");
+  BaseDeDatos::Criterio c = {Rig("Editor", "Vim")};
+  int vims = db.busqueda(c, "alumnos").cant_registros();
+  int cant = db.dameTabla("alumnos").cant_registros();
+
+  // Cambios inválidos: campo inexistente, tipo distinto, claves repetidas
+  EXPECT_FALSE(db.actualizarRegistros(c, Registro({"Materia"}, {datoStr("X")}), "alumnos"));
+  EXPECT_FALSE(db.actualizarRegistros(c, Registro({"Editor"}, {datoNat(1)}), "alumnos"));
+  EXPECT_FALSE(db.actualizarRegistros(c, Registro({"LU"}, {datoStr("1/90")}), "alumnos"));
+  EXPECT_EQ(db.busqueda(c, "alumnos").cant_registros(), vims);
+
+  EXPECT_TRUE(db.actualizarRegistros(c, Registro({"Editor"}, {datoStr("Emacs")}), "alumnos"));
+  EXPECT_EQ(db.dameTabla("alumnos").cant_registros(), cant);
+  EXPECT_EQ(db.busqueda(c, "alumnos").cant_registros(), 0);
+  EXPECT_TRUE(db.dameIndice("alumnos", "Editor")->noTieneRegistros(datoStr("Vim")));
+  EXPECT_FALSE(db.dameIndice("alumnos", "Editor")->noTieneRegistros(datoStr("Emacs")));
+
+  BaseDeDatos::Criterio unLU = {Rig("LU", "1/90")};
+  EXPECT_TRUE(db.actualizarRegistros(unLU, Registro({"LU", "OS"}, {datoStr("99/99"), datoStr("BSD")}), "alumnos"));
+  Tabla res = db.busqueda({Rig("LU", "99/99")}, "alumnos").materializar();
+  EXPECT_EQ(res.cant_registros(), 1);
+  EXPECT_EQ(res.registros_begin()->dato("OS"), datoStr("BSD"));
+  EXPECT_EQ(db.busqueda(unLU, "alumnos").cant_registros(), 0);
+}
+
+TEST_F(DBAlumnos, selectividad) {
+  int cant = db.dameTabla("alumnos").cant_registros();
+  BaseDeDatos::Criterio c = {Rig("Editor", "Vim")};
+  double estimada = db.selectividad(c, "alumnos") * cant;
+  EXPECT_NEAR(estimada, db.busqueda(c, "alumnos").cant_registros(), 1);
+  EXPECT_NEAR(db.selectividad({Rdif("Editor", "Vim")}, "alumnos") * cant,
+              cant - db.busqueda(c, "alumnos").cant_registros(), 1);
+  EXPECT_EQ(db.selectividad({}, "alumnos"), 1);
+  EXPECT_LT(db.selectividad({Rig("LU", "no existe")}, "alumnos"), 0.5);
+
+  // Cada libreta tiene un alumno
+  EXPECT_NEAR(db.estimarJoin("libretas", "alumnos", "LU"),
+              db.dameTabla("libretas").cant_registros(), 1);
+}
+
+TEST_F(DBAlumnos, indice_ids) {
+  db.crearIndice("alumnos", "Editor");
+  db.crearIndice("alumnos", "OS");
+  const Indice *editor = db.dameIndice("alumnos", "Editor");
+  const Indice *os = db.dameIndice("alumnos", "OS");
+  const Tabla &t = db.dameTabla("alumnos");
+
+  const vector<int> &vims = editor->ids(datoStr("Vim"));
+  EXPECT_TRUE(is_sorted(vims.begin(), vims.end()));
+  EXPECT_EQ(editor->cantRegistros(datoStr("Vim")),
+            db.busqueda({Rig("Editor", "Vim")}, "alumnos").cant_registros());
+  EXPECT_EQ(editor->cantRegistros(datoStr("Notepad")), 0);
+  auto it = editor->dameRegistros_begin(datoStr("Vim"));
+  for (int id : vims) {
+    EXPECT_EQ(it.id(), id);
+    EXPECT_EQ(*it, t.iterador(id));
+    EXPECT_EQ((*it)->dato("Editor"), datoStr("Vim"));
+    ++it;
+  }
+  EXPECT_EQ(it, editor->dameRegistros_end(datoStr("Vim")));
+
+  // Las listas de ids se combinan sin leer los registros
+  EXPECT_EQ(Indice::intersecar(vims, os->ids(datoStr("Linux"))),
+            db.busqueda({Rig("Editor", "Vim"), Rig("OS", "Linux")}, "alumnos").ids());
+  vector<int> todos = Indice::unir(vims, editor->ids(datoStr("CLion")));
+  EXPECT_EQ(todos.size(), vims.size() + editor->cantRegistros(datoStr("CLion")));
+  EXPECT_TRUE(is_sorted(todos.begin(), todos.end()));
+}
+
+TEST(indice_test, vacio) {
+  // Un índice vacío se puede copiar y consultar
+  Indice vacio;
+  Indice copia = vacio;
+  EXPECT_EQ(copia.tipo(), Indice::ORDENADO);
+  EXPECT_TRUE(copia.noTieneRegistros(datoNat(1)));
+  EXPECT_TRUE(copia.idsQueCumplen(Rig("A", 1)).empty());
+}
+
+TEST(indice_test, intersecar) {
+  // Tamaños parecidos (recorrido conjunto) y muy distintos (galloping)
+  vector<pair<int, int> > pasos = {{2, 3}, {3, 3}, {1, 1}, {500, 1},
+                                   {1, 997}, {64, 2}};
+  for (const pair<int, int> &p : pasos) {
+    vector<int> a;
+    vector<int> b;
+    for (int i = 0; i < 100000; i += p.first) {
+      a.push_back(i);
+    }
+    for (int i = 7; i < 100000; i += p.second) {
+      b.push_back(i);
+    }
+    vector<int> esperado;
+    set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                     back_inserter(esperado));
+    EXPECT_EQ(Indice::intersecar(a, b), esperado);
+    EXPECT_EQ(Indice::intersecar(b, a), esperado);
+  }
+  vector<int> a = {1, 5, 9, 12, 40};
+  vector<int> b = {5, 9, 40, 41};
+  vector<int> c = {0, 9, 40};
+  EXPECT_EQ(Indice::intersecar({&a, &b, &c}), vector<int>({9, 40}));
+  vector<int> vacia;
+  EXPECT_EQ(Indice::intersecar(a, vacia), vacia);
+  EXPECT_EQ(Indice::intersecar({&a, &vacia, &c}), vacia);
+}
+
+TEST_F(DBAlumnos, busqueda_varios_indices) {
+  db.crearTabla("eventos", {"Id"}, {"Id", "Cliente", "Estado", "Dia"},
+                {datoNat(0), datoNat(0), datoNat(0), datoNat(0)});
+  vector<Registro> nuevos;
+  for (int i = 0; i < 5000; i++) {
+    nuevos.push_back(Registro({"Id", "Cliente", "Estado", "Dia"},
+        {datoNat(i), datoNat(i % 200), datoNat(i % 3), datoNat(i % 31)}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(nuevos, "eventos"));
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rig("Cliente", 17), Rig("Estado", 2), Rig("Dia", 17)},
+      {Rig("Cliente", 17), Rig("Estado", 2)},
+      {Rig("Estado", 1), Rig("Dia", 4), Rdif("Cliente", 10)},
+      {Rig("Cliente", 17), Rig("Estado", 0), Rig("Dia", 30)}};
+  vector<vector<int> > sinIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    sinIndice.push_back(db.busqueda(c, "eventos").ids());
+  }
+  EXPECT_FALSE(sinIndice[0].empty());
+  db.crearIndice("eventos", "Cliente");
+  db.crearIndice("eventos", "Estado", Indice::HASH);
+  db.crearIndice("eventos", "Dia");
+  for (size_t i = 0; i < criterios.size(); i++) {
+    EXPECT_EQ(db.busqueda(criterios[i], "eventos").ids(), sinIndice[i]);
+  }
+}
+
+TEST_F(DBAlumnos, indice_paralelo) {
+  // Suficientes registros para que el índice se arme con varios hilos
+  int cant = 5 * Indice::MIN_REGISTROS_POR_HILO;
+  db.crearTabla("grande", {"Id"}, {"Id", "K", "S"},
+                {datoNat(0), datoNat(0), datoStr("")});
+  vector<Registro> nuevos;
+  for (int i = 0; i < cant; i++) {
+    nuevos.push_back(Registro({"Id", "K", "S"},
+        {datoNat(i), datoNat((i * 7919) % 5000),
+         datoStr("s" + to_string(i % 300))}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(nuevos, "grande"));
+  EXPECT_GT(db.borrarRegistros({Rig("S", "s7")}, "grande"), 0);
+
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rig("K", 0)}, {Rig("K", 4999)}, {Rig("S", "s12")}, {Rig("S", "s7")},
+      {Rig("K", 12), Rig("S", "s12")}};
+  vector<vector<int> > sinIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    sinIndice.push_back(db.busqueda(c, "grande").ids());
+  }
+  vector<Indice::Tipo> tipos = {Indice::ORDENADO, Indice::HASH, Indice::BITMAP};
+  Indice::fijarHilos(4);
+  for (Indice::Tipo tipo : tipos) {
+    db.crearIndice("grande", "K", tipo);
+    db.crearIndice("grande", "S", tipo);
+    db.crearIndice("grande", vector<string>({"K", "S"}), tipo);
+    EXPECT_EQ(db.dameIndice("grande", "K")->cantRegistros(datoNat(0)),
+              sinIndice[0].size());
+    for (size_t i = 0; i < criterios.size(); i++) {
+      EXPECT_EQ(db.busqueda(criterios[i], "grande").ids(), sinIndice[i]);
+    }
+  }
+  Indice::fijarHilos(0);
+}
+
+TEST(base_de_datos_test, no_copiable) {
+  EXPECT_FALSE(is_copy_constructible<BaseDeDatos>::value);
+  EXPECT_FALSE(is_copy_assignable<BaseDeDatos>::value);
+}
+
+TEST_F(DBAlumnos, indice_en_segundo_plano) {
+  int cant = 20 * Indice::REGISTROS_POR_TRAMO;
+  db.crearTabla("vivo", {"Id"}, {"Id", "K", "S"},
+                {datoNat(0), datoNat(0), datoStr("")});
+  vector<Registro> iniciales;
+  for (int i = 0; i < cant; i++) {
+    iniciales.push_back(Registro({"Id", "K", "S"},
+        {datoNat(i), datoNat(i % 97), datoStr("s" + to_string(i % 13))}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(iniciales, "vivo"));
+  vector<Indice::Tipo> tipos = {Indice::ORDENADO, Indice::HASH, Indice::BITMAP};
+  int siguiente = cant;
+  for (Indice::Tipo tipo : tipos) {
+    db.crearIndice("vivo", "K", tipo, true);
+    db.crearIndice("vivo", vector<string>({"S", "K"}), tipo, {}, true);
+
+    // La tabla sigue cambiando mientras se construyen
+    for (int i = 0; i < 500; i++, siguiente++) {
+      db.agregarRegistro(Registro({"Id", "K", "S"},
+          {datoNat(siguiente), datoNat(siguiente % 97), datoStr("s1")}), "vivo");
+    }
+    db.borrarRegistros({Rig("K", 5 + (int) tipo)}, "vivo");
+    EXPECT_TRUE(db.actualizarRegistros({Rig("K", 40 + (int) tipo)},
+                                       Registro({"K"}, {datoNat(96)}), "vivo"));
+    db.esperarIndices("vivo");
+    EXPECT_TRUE(db.indiceListo("vivo", {"K"}));
+    EXPECT_TRUE(db.indiceListo("vivo", {"S", "K"}));
+
+    // Queda igual que uno construido de una vez sobre la tabla final
+    const Tabla &t = db.dameTabla("vivo");
+    Indice esperado(t, vector<string>({"K"}), tipo);
+    const Indice *k = db.dameIndice("vivo", "K");
+    EXPECT_EQ(k->tipo(), tipo);
+    for (int v = 0; v < 97; v++) {
+      EXPECT_EQ(k->cantRegistros(datoNat(v)),
+                esperado.cantRegistros(datoNat(v)));
+      if (k->cantRegistros(datoNat(v)) > 0) {
+        EXPECT_EQ(k->ids(datoNat(v)), esperado.ids(datoNat(v)));
+      }
+    }
+    EXPECT_EQ(db.busqueda({Rig("S", "s1"), Rig("K", 96)}, "vivo").ids(),
+              Indice(t, vector<string>({"S", "K"}), tipo)
+                  .idsConPrefijo({datoStr("s1"), datoNat(96)}));
+  }
+}
+
+TEST_F(DBAlumnos, compactacion_en_segundo_plano) {
+  int cant = 8 * Tabla::REGISTROS_POR_TRAMO;
+  db.crearTabla("vivo", {"Id"}, {"Id", "K"}, {datoNat(0), datoNat(0)});
+  vector<Registro> iniciales;
+  // K de cada Id vigente
+  map<int, int> vigentes;
+  for (int i = 0; i < cant; i++) {
+    iniciales.push_back(Registro({"Id", "K"}, {datoNat(i), datoNat(i % 97)}));
+    vigentes[i] = i % 97;
+  }
+  EXPECT_TRUE(db.agregarRegistros(iniciales, "vivo"));
+  db.crearIndice("vivo", "K");
+  db.crearIndice("vivo", vector<string>({"K", "Id"}), Indice::HASH, {});
+  Seleccion antes = db.busqueda({}, "vivo");
+
+  // Quedan más borrados que vigentes: la tabla empieza a compactarse sola,
+  // pero los ids no cambian hasta que se instala la copia
+  db.borrarRegistros({Rmenor("K", 60)}, "vivo");
+  EXPECT_TRUE(antes.idsVigentes());
+  for (auto it = vigentes.begin(); it != vigentes.end();) {
+    it = it->second < 60 ? vigentes.erase(it) : next(it);
+  }
+
+  // La tabla sigue cambiando mientras se compacta
+  for (int i = cant; i < cant + 500; i++) {
+    db.agregarRegistro(Registro({"Id", "K"}, {datoNat(i), datoNat(i % 97)}),
+                       "vivo");
+    vigentes[i] = i % 97;
+  }
+  EXPECT_TRUE(db.actualizarRegistros({Rig("K", 70)},
+                                     Registro({"K"}, {datoNat(96)}), "vivo"));
+  db.borrarRegistros({Rig("K", 80)}, "vivo");
+  for (auto it = vigentes.begin(); it != vigentes.end();) {
+    if (it->second == 80) {
+      it = vigentes.erase(it);
+    } else {
+      if (it->second == 70) {
+        it->second = 96;
+      }
+      ++it;
+    }
+  }
+
+  // Una operación posterior instala la copia, sin llamar a compactar
+  for (int i = 0; i < 10000 and db.dameTabla("vivo").compactaciones() == 0;
+       i++) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+    db.busqueda({Rig("K", 96)}, "vivo");
+  }
+  const Tabla &t = db.dameTabla("vivo");
+  EXPECT_EQ(t.compactaciones(), 1);
+  EXPECT_FALSE(antes.idsVigentes());
+  EXPECT_EQ(t.cant_registros(), (int) vigentes.size());
+  EXPECT_LT(t.cant_borrados(), t.cant_registros());
+
+  // Quedan los mismos registros, con índices como los armados de una vez
+  map<int, int> guardados;
+  for (auto it = t.registros_begin(); it != t.registros_end(); ++it) {
+    guardados[it->dato("Id").valorNat()] = it->dato("K").valorNat();
+  }
+  EXPECT_EQ(guardados, vigentes);
+  Indice esperado(t, vector<string>({"K"}));
+  const Indice *k = db.dameIndice("vivo", "K");
+  for (int v = 0; v < 97; v++) {
+    EXPECT_EQ(k->cantRegistros(datoNat(v)),
+              esperado.cantRegistros(datoNat(v)));
+    if (k->cantRegistros(datoNat(v)) > 0) {
+      EXPECT_EQ(k->ids(datoNat(v)), esperado.ids(datoNat(v)));
+    }
+  }
+  EXPECT_EQ(db.busqueda({Rig("K", 96), Rig("Id", 70)}, "vivo").cant_registros(), 1);
+  EXPECT_EQ(db.busqueda({Rig("K", 80)}, "vivo").cant_registros(), 0);
+}
+
+TEST_F(DBAlumnos, indice_cubriente) {
+  db.crearTabla("cubre", {"Id"}, {"Id", "K", "S", "X"},
+                {datoNat(0), datoNat(0), datoStr(""), datoNat(0)});
+  vector<Registro> regs;
+  for (int i = 0; i < 600; i++) {
+    regs.push_back(Registro({"Id", "K", "S", "X"},
+        {datoNat(i), datoNat(i % 31), datoStr("s" + to_string(i % 7)),
+         datoNat((i * 37) % 101)}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(regs, "cubre"));
+
+  // Lo mismo que devuelve la búsqueda, leído de la tabla
+  auto esperado = [this](const BaseDeDatos::Criterio &c,
+                         const vector<string> &campos) {
+    const Tabla &t = db.dameTabla("cubre");
+    vector<Registro> res;
+    Seleccion seleccion = db.busqueda(c, "cubre");
+    for (int id : seleccion.ids()) {
+      vector<Dato> datos;
+      for (const string &campo : campos) {
+        datos.push_back(t.dato(id, t.campoId(campo)));
+      }
+      res.push_back(Registro(campos, datos));
+    }
+    return res;
+  };
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rig("K", 3)}, {Rig("K", 3), Rmayor("X", 50)}, {Rentre("K", 10, 12)},
+      {Rig("S", "s2"), Rig("K", 5)}, {Rig("S", "s2"), Rdif("X", 7)},
+      {Rig("X", 9)}};
+  vector<string> proyectados = {"X", "K"};
+
+  vector<Indice::Tipo> tipos = {Indice::ORDENADO, Indice::HASH, Indice::BITMAP};
+  for (Indice::Tipo tipo : tipos) {
+    db.crearIndice("cubre", vector<string>({"K"}), tipo, {"X"});
+    db.crearIndice("cubre", vector<string>({"S", "K"}), tipo, {"X"});
+    const Indice *k = db.dameIndice("cubre", "K");
+    EXPECT_EQ(k->incluidos(), vector<string>({"X"}));
+    EXPECT_EQ(k->cubierto("K"), 0);
+    EXPECT_EQ(k->cubierto("X"), 1);
+    EXPECT_EQ(k->cubierto("S"), -1);
+    EXPECT_EQ(k->valor(40, 1), datoNat((40 * 37) % 101));
+
+    for (const BaseDeDatos::Criterio &c : criterios) {
+      EXPECT_EQ(db.proyeccion(c, "cubre", proyectados),
+                esperado(c, proyectados));
+    }
+    // Un campo que ningún índice guarda se lee de la tabla
+    EXPECT_EQ(db.proyeccion({Rig("K", 3)}, "cubre", {"Id"}),
+              esperado({Rig("K", 3)}, {"Id"}));
+
+    // Los valores guardados siguen a los cambios de la tabla
+    EXPECT_TRUE(db.actualizarRegistros({Rig("K", 3)},
+                                       Registro({"X"}, {datoNat(1000)}), "cubre"));
+    EXPECT_EQ(db.proyeccion({Rig("K", 3), Rig("X", 1000)}, "cubre",
+                            proyectados).size(),
+              db.busqueda({Rig("K", 3)}, "cubre").cant_registros());
+    db.borrarRegistros({Rig("K", 4)}, "cubre");
+    EXPECT_TRUE(db.proyeccion({Rig("K", 4)}, "cubre", proyectados).empty());
+    db.agregarRegistro(Registro({"Id", "K", "S", "X"},
+        {datoNat(1000 + tipo), datoNat(4), datoStr("s2"), datoNat(5)}), "cubre");
+    EXPECT_EQ(db.proyeccion({Rig("K", 4)}, "cubre", proyectados),
+              vector<Registro>({Registro(proyectados,
+                                         {datoNat(5), datoNat(4)})}));
+  }
+}
+
+TEST_F(DBAlumnos, asesor_indices) {
+  db.crearTabla("asesor", {"Id"}, {"Id", "K", "C", "S"},
+                {datoNat(0), datoNat(0), datoNat(0), datoStr("")});
+  vector<Registro> regs;
+  for (int i = 0; i < 5000; i++) {
+    regs.push_back(Registro({"Id", "K", "C", "S"},
+        {datoNat(i), datoNat(i % 500), datoNat(i % 4),
+         datoStr("s" + to_string(i % 50))}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(regs, "asesor"));
+  db.crearIndice("asesor", "S");
+  auto recomendado = [](const vector<BaseDeDatos::RecomendacionIndice> &recs,
+                        const vector<string> &campos) {
+    for (const BaseDeDatos::RecomendacionIndice &rec : recs) {
+      if (rec.tabla == "asesor" and rec.campos == campos) {
+        return &rec;
+      }
+    }
+    return (const BaseDeDatos::RecomendacionIndice *) nullptr;
+  };
+
+  for (int i = 0; i < 10; i++) {
+    db.busqueda({Rig("K", 7)}, "asesor");
+    db.busqueda({Rig("C", 1)}, "asesor");
+    db.busqueda({Rig("K", 8), Rig("C", 0)}, "asesor");
+    db.busqueda({Rig("S", "s3")}, "asesor");
+  }
+  db.busqueda({Rdif("K", 7)}, "asesor");
+  vector<BaseDeDatos::RecomendacionIndice> recs =
+      db.recomendarIndices(1 << 30);
+  ASSERT_NE(recomendado(recs, {"K"}), nullptr);
+  EXPECT_EQ(recomendado(recs, {"K"})->tipo, Indice::HASH);
+  ASSERT_NE(recomendado(recs, {"C"}), nullptr);
+  EXPECT_EQ(recomendado(recs, {"C"})->tipo, Indice::BITMAP);
+  // Compuesto del campo más selectivo al menos
+  ASSERT_NE(recomendado(recs, {"K", "C"}), nullptr);
+  // El campo ya indexado no se recomienda
+  EXPECT_EQ(recomendado(recs, {"S"}), nullptr);
+  EXPECT_GT(recomendado(recs, {"K"})->beneficio,
+            recomendado(recs, {"C"})->beneficio);
+  for (size_t i = 1; i < recs.size(); i++) {
+    EXPECT_GE(recs[i - 1].beneficio / recs[i - 1].bytes,
+              recs[i].beneficio / recs[i].bytes);
+  }
+  // El presupuesto limita la memoria de los recomendados
+  EXPECT_TRUE(db.recomendarIndices(0).empty());
+  EXPECT_EQ(db.recomendarIndices(recs[0].bytes).size(), 1);
+
+  db.ajustarIndices(1 << 30);
+  db.esperarIndices("asesor");
+  EXPECT_TRUE(db.indiceListo("asesor", {"K"}));
+  EXPECT_TRUE(db.indiceListo("asesor", {"C"}));
+  EXPECT_EQ(db.dameIndice("asesor", "K")->tipo(), Indice::HASH);
+  // Los usos se cuentan de nuevo desde el ajuste
+  EXPECT_TRUE(db.recomendarIndices(1 << 30).empty());
+  EXPECT_EQ(db.usoIndice("asesor", {"K"}), 0);
+  EXPECT_EQ(db.busqueda({Rig("K", 7)}, "asesor").cant_registros(), 10);
+  EXPECT_EQ(db.usoIndice("asesor", {"K"}), 1);
+  EXPECT_EQ(db.uso_criterio({Rig("K", 7)}), 11);
+
+  // Un rango sobre un campo con muchos datos distintos pide un índice
+  // ordenado; C no se usó y se saca, S es del usuario y queda
+  db.busqueda({Rentre("K", 10, 20)}, "asesor");
+  db.ajustarIndices(1 << 30, false);
+  EXPECT_TRUE(db.indiceListo("asesor", {"K"}));
+  EXPECT_EQ(db.dameIndice("asesor", "K")->tipo(), Indice::HASH);
+  EXPECT_FALSE(db.indiceListo("asesor", {"C"}));
+  EXPECT_TRUE(db.indiceListo("asesor", {"S"}));
+  db.ajustarIndices(1 << 30, false);
+  EXPECT_FALSE(db.indiceListo("asesor", {"K"}));
+  EXPECT_FALSE(db.indiceListo("asesor", {"K", "C"}));
+  EXPECT_TRUE(db.indiceListo("asesor", {"S"}));
+  db.busqueda({Rentre("K", 10, 20)}, "asesor");
+  recs = db.recomendarIndices(1 << 30);
+  ASSERT_NE(recomendado(recs, {"K"}), nullptr);
+  EXPECT_EQ(recomendado(recs, {"K"})->tipo, Indice::ORDENADO);
+}
+
+TEST_F(DBAlumnos, uso_de_indices_elegidos) {
+  db.crearTabla("usos", {"Id"}, {"Id", "K", "C"},
+                {datoNat(0), datoNat(0), datoNat(0)});
+  vector<Registro> regs;
+  for (int i = 0; i < 2000; i++) {
+    regs.push_back(Registro({"Id", "K", "C"},
+        {datoNat(i), datoNat(i % 200), datoNat(i % 3)}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(regs, "usos"));
+  db.crearIndice("usos", "K", Indice::HASH);
+  db.crearIndice("usos", "C", Indice::BITMAP);
+  db.crearIndice("usos", vector<string>({"K", "C"}), Indice::HASH, {});
+
+  // El compuesto deja menos registros que la lista de K y que el mapa de C:
+  // solo él cuenta como usado
+  EXPECT_EQ(db.busqueda({Rig("K", 7), Rig("C", 1)}, "usos").cant_registros(), 4);
+  EXPECT_EQ(db.usoIndice("usos", {"K", "C"}), 1);
+  EXPECT_EQ(db.usoIndice("usos", {"K"}), 0);
+  EXPECT_EQ(db.usoIndice("usos", {"C"}), 0);
+
+  EXPECT_EQ(db.busqueda({Rig("K", 7)}, "usos").cant_registros(), 10);
+  EXPECT_EQ(db.usoIndice("usos", {"K"}), 1);
+  EXPECT_EQ(db.busqueda({Rig("C", 1)}, "usos").cant_registros(), 667);
+  EXPECT_EQ(db.usoIndice("usos", {"C"}), 1);
+  EXPECT_EQ(db.usoIndice("usos", {"K", "C"}), 1);
+}
+
+TEST_F(DBAlumnos, asesor_indices_por_tabla) {
+  // Dos tablas con los mismos campos: solo se recomienda en la buscada
+  for (const char *nombre : {"usada", "ajena"}) {
+    db.crearTabla(nombre, {"Id"}, {"Id", "K"}, {datoNat(0), datoNat(0)});
+    vector<Registro> regs;
+    for (int i = 0; i < 2000; i++) {
+      regs.push_back(Registro({"Id", "K"}, {datoNat(i), datoNat(i % 200)}));
+    }
+    EXPECT_TRUE(db.agregarRegistros(regs, nombre));
+  }
+  for (int i = 0; i < 10; i++) {
+    db.busqueda({Rig("K", 7)}, "usada");
+  }
+  vector<BaseDeDatos::RecomendacionIndice> recs =
+      db.recomendarIndices(1 << 30);
+  ASSERT_EQ(recs.size(), 1);
+  EXPECT_EQ(recs[0].tabla, "usada");
+  EXPECT_EQ(recs[0].campos, vector<string>({"K"}));
+}
+
+TEST_F(DBAlumnos, indice_hash) {
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rig("Editor", "Vim")},
+      {Rig("Editor", "Vim"), Rdif("OS", "Linux")},
+      {Rig("Editor", "Vim"), Rig("OS", "Win")},
+      {Rig("Editor", "Notepad")},
+      {Rdif("Editor", "Vim")}};
+  vector<vector<int> > sinIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    sinIndice.push_back(db.busqueda(c, "alumnos").ids());
+  }
+  db.crearIndice("alumnos", "Editor", Indice::HASH);
+  db.crearIndice("alumnos", "OS");
+  const Indice *editor = db.dameIndice("alumnos", "Editor");
+  EXPECT_EQ(editor->tipo(), Indice::HASH);
+  EXPECT_EQ(db.dameIndice("alumnos", "OS")->tipo(), Indice::ORDENADO);
+  EXPECT_EQ(editor->buscar(datoStr("Notepad")), nullptr);
+  EXPECT_EQ(*editor->buscar(datoStr("Vim")), editor->ids(datoStr("Vim")));
+  EXPECT_EQ(editor->cantRegistros(datoStr("CLion")), 1);
+
+  // Las búsquedas que parten del índice dan lo mismo que sin índices
+  for (size_t i = 0; i < criterios.size(); i++) {
+    EXPECT_EQ(db.busqueda(criterios[i], "alumnos").ids(), sinIndice[i]);
+  }
+
+  // El índice se mantiene al agregar muchos valores distintos, actualizar
+  // y borrar
+  vector<Registro> nuevos;
+  for (int i = 0; i < 100; i++) {
+    nuevos.push_back(registro(def_alumnos,
+        {datoStr(to_string(i) + "/20"), datoStr("N"),
+         datoStr("Editor" + to_string(i)), datoStr("Linux")}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(nuevos, "alumnos"));
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(editor->cantRegistros(datoStr("Editor" + to_string(i))), 1);
+  }
+  EXPECT_TRUE(db.actualizarRegistros({Rig("Editor", "CLion")},
+      Registro({"Editor"}, {datoStr("Vim")}), "alumnos"));
+  EXPECT_EQ(editor->buscar(datoStr("CLion")), nullptr);
+  EXPECT_EQ(db.borrarRegistros({Rig("Editor", "Vim")}, "alumnos"),
+            sinIndice[0].size() + 1);
+  EXPECT_TRUE(editor->noTieneRegistros(datoStr("Vim")));
+  EXPECT_EQ(db.busqueda({Rig("Editor", "Editor7")}, "alumnos").cant_registros(), 1);
+}
+
+TEST_F(DBAlumnos, indice_compuesto) {
+  db.crearTabla("pedidos", {"Id"}, {"Id", "Cliente", "Estado", "Dia"},
+                {datoNat(0), datoNat(0), datoStr(""), datoNat(0)});
+  vector<string> estados = {"abierto", "cerrado", "pago", ""};
+  vector<Registro> nuevos;
+  for (int i = 0; i < 400; i++) {
+    nuevos.push_back(Registro({"Id", "Cliente", "Estado", "Dia"},
+        {datoNat(i), datoNat(i % 7), datoStr(estados[i % 4]),
+         datoNat(i % 13)}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(nuevos, "pedidos"));
+
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rig("Cliente", 3), Rig("Estado", "pago"), Rig("Dia", 10)},
+      {Rig("Cliente", 3), Rig("Estado", "pago")},
+      {Rig("Cliente", 3), Rig("Estado", "")},
+      {Rig("Cliente", 3)},
+      {Rig("Cliente", 3), Rig("Dia", 10)},
+      {Rig("Cliente", 3), Rig("Estado", "pago"), Rdif("Dia", 10)},
+      {Rig("Cliente", 3), Rig("Estado", "nada")},
+      {Rig("Estado", "pago"), Rig("Dia", 10)}};
+  vector<vector<int> > sinIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    sinIndice.push_back(db.busqueda(c, "pedidos").ids());
+  }
+  EXPECT_FALSE(sinIndice[0].empty());
+  EXPECT_TRUE(sinIndice[6].empty());
+
+  vector<string> campos = {"Cliente", "Estado", "Dia"};
+  db.crearIndice("pedidos", campos);
+  const Indice *ind = db.dameIndice("pedidos", campos);
+  EXPECT_EQ(ind->campos(), campos);
+  EXPECT_EQ(ind->idsConPrefijo({datoNat(3), datoStr("pago")}), sinIndice[1]);
+  for (size_t i = 0; i < criterios.size(); i++) {
+    EXPECT_EQ(db.busqueda(criterios[i], "pedidos").ids(), sinIndice[i]);
+  }
+
+  // El índice se mantiene al modificar uno de sus campos y al borrar
+  EXPECT_TRUE(db.actualizarRegistros({Rig("Cliente", 3), Rig("Dia", 10)},
+      Registro({"Estado"}, {datoStr("pago")}), "pedidos"));
+  db.agregarRegistro(Registro({"Id", "Cliente", "Estado", "Dia"},
+      {datoNat(1000), datoNat(3), datoStr("pago"), datoNat(11)}), "pedidos");
+  EXPECT_GT(db.borrarRegistros({Rig("Cliente", 5)}, "pedidos"), 0);
+  vector<vector<int> > conIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    conIndice.push_back(db.busqueda(c, "pedidos").ids());
+  }
+  db.crearIndice("pedidos", campos, Indice::HASH);
+  EXPECT_EQ(db.dameIndice("pedidos", campos)->tipo(), Indice::HASH);
+  for (size_t i = 0; i < criterios.size(); i++) {
+    EXPECT_EQ(db.busqueda(criterios[i], "pedidos").ids(), conIndice[i]);
+  }
+}
+
+TEST_F(DBAlumnos, indice_bitmap) {
+  db.crearTabla("tickets", {"Id"}, {"Id", "Estado", "Prioridad", "Zona"},
+                {datoNat(0), datoStr(""), datoNat(0), datoStr("")});
+  vector<string> estados = {"abierto", "cerrado", "espera", "nuevo"};
+  vector<Registro> nuevos;
+  for (int i = 0; i < 3000; i++) {
+    nuevos.push_back(Registro({"Id", "Estado", "Prioridad", "Zona"},
+        {datoNat(i), datoStr(estados[(i * 7) % 4]), datoNat(i % 5),
+         datoStr("z" + to_string(i % 11))}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(nuevos, "tickets"));
+
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rig("Estado", "abierto")},
+      {Rig("Estado", "abierto"), Rig("Prioridad", 3)},
+      {Rig("Estado", "abierto"), Rdif("Prioridad", 3)},
+      {Rdif("Estado", "cerrado"), Rdif("Estado", "nuevo")},
+      {Rdif("Prioridad", 0), Rig("Zona", "z4")},
+      {Rmenor("Prioridad", 2), Rprefijo("Estado", "e")},
+      {Rig("Estado", "otro")},
+      {Rdif("Estado", "otro"), Rentre("Prioridad", 1, 2)}};
+  vector<vector<int> > sinIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    sinIndice.push_back(db.busqueda(c, "tickets").ids());
+  }
+
+  db.crearIndice("tickets", "Estado", Indice::BITMAP);
+  db.crearIndice("tickets", "Prioridad", Indice::BITMAP);
+  const Indice *estado = db.dameIndice("tickets", "Estado");
+  EXPECT_EQ(estado->tipo(), Indice::BITMAP);
+  EXPECT_EQ(estado->cantRegistros(datoStr("abierto")), 750);
+  EXPECT_EQ(estado->buscar(datoStr("otro")), nullptr);
+  EXPECT_EQ(estado->mapaQueCumple(Rig("Estado", "abierto")).ids(),
+            sinIndice[0]);
+  for (size_t i = 0; i < criterios.size(); i++) {
+    EXPECT_EQ(db.busqueda(criterios[i], "tickets").ids(), sinIndice[i]);
+  }
+
+  // Los mapas se mantienen al agregar, actualizar y borrar
+  db.agregarRegistro(Registro({"Id", "Estado", "Prioridad", "Zona"},
+      {datoNat(5000), datoStr("abierto"), datoNat(3), datoStr("z1")}),
+      "tickets");
+  EXPECT_TRUE(db.actualizarRegistros({Rig("Prioridad", 4)},
+      Registro({"Estado"}, {datoStr("cerrado")}), "tickets"));
+  EXPECT_GT(db.borrarRegistros({Rig("Zona", "z2")}, "tickets"), 0);
+  EXPECT_EQ(*estado->buscar(datoStr("abierto")),
+            db.busqueda({Rig("Estado", "abierto")}, "tickets").ids());
+  vector<vector<int> > conIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    conIndice.push_back(db.busqueda(c, "tickets").ids());
+  }
+  db.crearIndice("tickets", "Estado");
+  db.crearIndice("tickets", "Prioridad");
+  for (size_t i = 0; i < criterios.size(); i++) {
+    EXPECT_EQ(db.busqueda(criterios[i], "tickets").ids(), conIndice[i]);
+  }
+}
+
+TEST(indice_test, codificar_preserva_orden) {
+  vector<vector<Dato> > tuplas;
+  vector<string> strings = {"", "a", "ab", "b", string(1, '\0'),
+                            string("a\x01", 2), string("a\x7f", 2),
+                            string("a\xc8", 2), "a~"};
+  vector<int> nats = {0, 1, 63, 64, 4096, 1 << 30, -5};
+  for (const string &str : strings) {
+    for (int n : nats) {
+      tuplas.push_back({datoStr(str), datoNat(n)});
+    }
+  }
+  for (const vector<Dato> &a : tuplas) {
+    string ca = Indice::codificar(a);
+    for (char c : ca) {
+      EXPECT_GT((int) c, 0);
+    }
+    // El prefijo de la tupla codifica a un prefijo
+    string prefijo = Indice::codificar({a[0]});
+    EXPECT_EQ(ca.compare(0, prefijo.size(), prefijo), 0);
+    for (const vector<Dato> &b : tuplas) {
+      string cb = Indice::codificar(b);
+      EXPECT_EQ(ca < cb, a < b);
+      EXPECT_EQ(ca == cb, a == b);
+    }
+  }
+}
+
+TEST_F(DBAlumnos, busqueda_particionada) {
+  db.crearTabla("alumnos_part", def_alumnos.claves, def_alumnos.campos,
+                def_alumnos.tipos, Tabla::POR_FILAS,
+                Particionado::porHash("Editor", 3));
+  for (auto it = alumnos.registros_begin(); it != alumnos.registros_end(); ++it) {
+    db.agregarRegistro(*it, "alumnos_part");
+  }
+  EXPECT_EQ(db.dameTabla("alumnos_part"), alumnos);
+
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rig("Editor", "Vim")},
+      {Rig("Editor", "Vim"), Rdif("OS", "Linux")},
+      {Rig("Editor", "Vim"), Rig("Editor", "Emacs")},
+      {Rdif("Editor", "Vim")},
+      {Rig("OS", "Linux")}};
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    Tabla res = db.busqueda(c, "alumnos_part").materializar();
+    EXPECT_EQ(res, db.busqueda(c, "alumnos").materializar());
+    EXPECT_EQ(res.particionado().tipo(), Particionado::HASH);
+  }
+}
+
 // ## Búsqueda
 TEST_F(DBAlumnos, busqueda_base) {
   // Incluye búsqueda igual simple
-  Tabla res = db.busqueda({Rig("LU", "1/90")}, "alumnos");
+  Tabla res = db.busqueda({Rig("LU", "1/90")}, "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 1);
   EXPECT_EQ(res.campos(), alumnos.campos());
   EXPECT_EQ(res.claves(), alumnos.claves());
@@ -348,7 +1109,7 @@ TEST_F(DBAlumnos, busqueda_base) {
                       res.registros().begin(),
                       res.registros().end()));
 
-  res = db.busqueda({Rig("LU_A", 90)}, "libretas");
+  res = db.busqueda({Rig("LU_A", 90)}, "libretas").materializar();
   EXPECT_EQ(res.registros().size(), 2);
   EXPECT_EQ(res.campos(), libretas.campos());
   EXPECT_EQ(res.claves(), libretas.claves());
@@ -357,7 +1118,7 @@ TEST_F(DBAlumnos, busqueda_base) {
                        res.registros().begin(),
                        res.registros().end()));
 
-  res = db.busqueda({Rig("Materia", "AED2")}, "materias");
+  res = db.busqueda({Rig("Materia", "AED2")}, "materias").materializar();
   EXPECT_EQ(res.registros().size(), 3);
   EXPECT_EQ(res.campos(), materias.campos());
   EXPECT_EQ(res.claves(), materias.claves());
@@ -368,14 +1129,14 @@ TEST_F(DBAlumnos, busqueda_base) {
 }
 
 TEST_F(DBAlumnos, busqueda_distinto_simple) {
-  Tabla res = db.busqueda({Rdif("LU_A", 80)}, "libretas");
+  Tabla res = db.busqueda({Rdif("LU_A", 80)}, "libretas").materializar();
   EXPECT_EQ(res.registros().size(), 4);
   EXPECT_TRUE(incluye(libretas.registros().begin(),
                        libretas.registros().end(),
                        res.registros().begin(),
                        res.registros().end()));
 
-  res = db.busqueda({Rdif("Editor", "Vim")}, "alumnos");
+  res = db.busqueda({Rdif("Editor", "Vim")}, "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 2);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -385,7 +1146,7 @@ TEST_F(DBAlumnos, busqueda_distinto_simple) {
 
 TEST_F(DBAlumnos, busqueda_igual_doble) {
   Tabla res = db.busqueda({Rig("LU_N", 1), Rig("LU_A", 90)},
-                          "libretas");
+                          "libretas").materializar();
   EXPECT_EQ(res.registros().size(), 1);
   EXPECT_TRUE(incluye(libretas.registros().begin(),
                        libretas.registros().end(),
@@ -394,7 +1155,7 @@ TEST_F(DBAlumnos, busqueda_igual_doble) {
 
   // Otro orden
   res = db.busqueda({Rig("LU_A", 90), Rig("LU_N", 1)},
-                    "libretas");
+                    "libretas").materializar();
   EXPECT_EQ(res.registros().size(), 1);
   EXPECT_TRUE(incluye(libretas.registros().begin(),
                        libretas.registros().end(),
@@ -402,7 +1163,7 @@ TEST_F(DBAlumnos, busqueda_igual_doble) {
                        res.registros().end()));
 
   res = db.busqueda({Rig("Editor", "Vim"), Rig("OS", "Linux")},
-                    "alumnos");
+                    "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 2);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -410,7 +1171,7 @@ TEST_F(DBAlumnos, busqueda_igual_doble) {
                        res.registros().end()));
 
   res = db.busqueda({Rig("OS", "macOS"), Rig("Editor", "Vim")},
-                    "alumnos");
+                    "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 3);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -420,7 +1181,7 @@ TEST_F(DBAlumnos, busqueda_igual_doble) {
 
 TEST_F(DBAlumnos, busqueda_distinto_doble) {
   Tabla res = db.busqueda({Rdif("LU_N", 1), Rdif("LU_A", 90)},
-                          "libretas");
+                          "libretas").materializar();
   EXPECT_EQ(res.registros().size(), 5);
   EXPECT_TRUE(incluye(libretas.registros().begin(),
                        libretas.registros().end(),
@@ -429,7 +1190,7 @@ TEST_F(DBAlumnos, busqueda_distinto_doble) {
 
   // Otro orden
   res = db.busqueda({Rdif("LU_A", 90), Rdif("LU_N", 1)},
-                    "libretas");
+                    "libretas").materializar();
   EXPECT_EQ(res.registros().size(), 5);
   EXPECT_TRUE(incluye(libretas.registros().begin(),
                        libretas.registros().end(),
@@ -437,7 +1198,7 @@ TEST_F(DBAlumnos, busqueda_distinto_doble) {
                        res.registros().end()));
 
   res = db.busqueda({Rdif("Editor", "Vim"), Rdif("OS", "Linux")},
-                    "alumnos");
+                    "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 2);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -445,7 +1206,7 @@ TEST_F(DBAlumnos, busqueda_distinto_doble) {
                        res.registros().end()));
 
   res = db.busqueda({Rdif("OS", "Win"), Rdif("Editor", "Vim")},
-                    "alumnos");
+                    "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 0);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -453,7 +1214,7 @@ TEST_F(DBAlumnos, busqueda_distinto_doble) {
                        res.registros().end()));
 
   res = db.busqueda({Rdif("OS", "macOS"), Rdif("Editor", "Vim")},
-                    "alumnos");
+                    "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 2);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -463,7 +1224,7 @@ TEST_F(DBAlumnos, busqueda_distinto_doble) {
 
 TEST_F(DBAlumnos, busqueda_igual_distinto) {
   Tabla res = db.busqueda({Rig("Editor", "Vim"), Rdif("OS", "macOS")},
-                          "alumnos");
+                          "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 2);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -471,7 +1232,7 @@ TEST_F(DBAlumnos, busqueda_igual_distinto) {
                        res.registros().end()));
 
   res = db.busqueda({Rig("OS", "Linux"), Rdif("Nombre", "March")},
-                          "alumnos");
+                          "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 1);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -479,7 +1240,7 @@ TEST_F(DBAlumnos, busqueda_igual_distinto) {
                        res.registros().end()));
 
   res = db.busqueda({Rdif("OS", "Linux"), Rig("Nombre", "March")},
-                          "alumnos");
+                          "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 0);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -487,7 +1248,7 @@ TEST_F(DBAlumnos, busqueda_igual_distinto) {
                        res.registros().end()));
 
   res = db.busqueda({Rdif("OS", "macOS"), Rig("Editor", "Vim")},
-                          "alumnos");
+                          "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 2);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -498,7 +1259,7 @@ TEST_F(DBAlumnos, busqueda_igual_distinto) {
 TEST_F(DBAlumnos, busqueda_igual_distinto_doble) {
   Tabla res = db.busqueda({Rig("Editor", "Vim"), Rdif("OS", "macOS"),
                            Rig("Nombre", "March")},
-                          "alumnos");
+                          "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 1);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -507,7 +1268,7 @@ TEST_F(DBAlumnos, busqueda_igual_distinto_doble) {
 
   res = db.busqueda({Rig("OS", "Win"), Rdif("Nombre", "March"),
                      Rig("Editor", "CLion")},
-                          "alumnos");
+                          "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 1);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -516,7 +1277,7 @@ TEST_F(DBAlumnos, busqueda_igual_distinto_doble) {
 
   res = db.busqueda({Rdif("Nombre", "Crack"), Rig("OS", "macOS"),
                      Rig("Editor", "Vim")},
-                     "alumnos");
+                     "alumnos").materializar();
   EXPECT_EQ(res.registros().size(), 3);
   EXPECT_TRUE(incluye(alumnos.registros().begin(),
                        alumnos.registros().end(),
@@ -524,7 +1285,111 @@ TEST_F(DBAlumnos, busqueda_igual_distinto_doble) {
                        res.registros().end()));
 }
 
+TEST_F(DBAlumnos, busqueda_seleccion) {
+  BaseDeDatos::Criterio c = {Rig("Editor", "Vim"), Rdif("OS", "Linux")};
+  for (const string &nombre : {string("alumnos"), string("alumnos_col")}) {
+    if (nombre == "alumnos_col") {
+      db.crearTabla(nombre, def_alumnos.claves, def_alumnos.campos,
+                    def_alumnos.tipos, Tabla::POR_COLUMNAS);
+      for (auto it = alumnos.registros_begin(); it != alumnos.registros_end(); ++it) {
+        db.agregarRegistro(*it, nombre);
+      }
+    }
+    Seleccion sel = db.busqueda(c, nombre);
+    EXPECT_EQ(&sel.tabla(), &db.dameTabla(nombre));
+    EXPECT_EQ(sel.campos(), alumnos.campos());
+    EXPECT_EQ(sel.cant_registros(), 3);
+
+    // Se recorre sin copiar los registros, en orden de id
+    Tabla res = sel.materializar();
+    int cant = 0;
+    int anterior = -1;
+    for (auto it = sel.registros_begin(); it != sel.registros_end(); ++it) {
+      EXPECT_LT(anterior, it.id());
+      EXPECT_EQ(it->dato("Editor"), datoStr("Vim"));
+      EXPECT_TRUE(res.registros().count(*it));
+      anterior = it.id();
+      cant++;
+    }
+    EXPECT_EQ(cant, 3);
+    EXPECT_EQ(res.cant_registros(), 3);
+    EXPECT_EQ(res.almacenamiento(), db.dameTabla(nombre).almacenamiento());
+  }
+  Seleccion vacia = db.busqueda({Rig("LU", "no existe")}, "alumnos");
+  EXPECT_TRUE(vacia.registros_begin() == vacia.registros_end());
+  EXPECT_EQ(vacia.materializar().cant_registros(), 0);
+}
+
+TEST_F(DBAlumnos, busqueda_rangos) {
+  db.crearTabla("numeros", {"N"}, {"N", "S"}, {datoNat(0), datoStr("")});
+  vector<Registro> nuevos;
+  for (int i = 0; i < 300; i++) {
+    nuevos.push_back(Registro({"N", "S"}, {datoNat((i * 37) % 300),
+                                           datoStr("k" + to_string(i % 40))}));
+  }
+  EXPECT_TRUE(db.agregarRegistros(nuevos, "numeros"));
+  EXPECT_EQ(db.borrarRegistros({Rentre("N", 100, 109)}, "numeros"), 10);
+
+  vector<BaseDeDatos::Criterio> criterios = {
+      {Rmenor("N", 20)},
+      {Rmayor("N", 290)},
+      {Rentre("N", 95, 120)},
+      {Rentre("N", 50, 40)},
+      {Rmenor("N", 0)},
+      {Rprefijo("S", "k1")},
+      {Rprefijo("S", "x")},
+      {Rmenor("S", "k12")},
+      {Rmayor("S", "k5")},
+      {Rentre("S", "k2", "k3")},
+      {Rprefijo("S", "k2"), Rmenor("N", 150)},
+      {Rentre("N", 10, 200), Rig("S", "k7")}};
+  const Tabla &t = db.dameTabla("numeros");
+  vector<vector<int> > sinIndice;
+  for (const BaseDeDatos::Criterio &c : criterios) {
+    // Se compara contra revisar cada registro
+    vector<int> esperado;
+    for (int id : t.ids()) {
+      bool cumple = true;
+      for (const Restriccion &r : c) {
+        cumple = cumple and r.cumple(t.dato(id, t.campoId(r.campo())));
+      }
+      if (cumple) {
+        esperado.push_back(id);
+      }
+    }
+    sinIndice.push_back(db.busqueda(c, "numeros").ids());
+    EXPECT_EQ(sinIndice.back(), esperado);
+  }
+  EXPECT_EQ(sinIndice[0].size(), 20);
+  EXPECT_EQ(sinIndice[2].size(), 16);
+  EXPECT_TRUE(sinIndice[3].empty());
+
+  // Con índices ordenados se recorren solo las claves del rango
+  db.crearIndice("numeros", "N");
+  db.crearIndice("numeros", "S");
+  for (size_t i = 0; i < criterios.size(); i++) {
+    EXPECT_EQ(db.busqueda(criterios[i], "numeros").ids(), sinIndice[i]);
+  }
+  EXPECT_EQ(db.dameIndice("numeros", "N")->idsQueCumplen(Rentre("N", 95, 120)),
+            sinIndice[2]);
+}
+
 // ## Criterio Válido
+TEST_F(DBAlumnos, busqueda_por_columnas) {
+  db.crearTabla("alumnos_col", def_alumnos.claves, def_alumnos.campos,
+                def_alumnos.tipos, Tabla::POR_COLUMNAS);
+  for (auto it = alumnos.registros_begin(); it != alumnos.registros_end(); ++it) {
+    db.agregarRegistro(*it, "alumnos_col");
+  }
+  EXPECT_EQ(db.dameTabla("alumnos_col"), alumnos);
+
+  BaseDeDatos::Criterio c = {Rig("Editor", "Vim"), Rdif("OS", "Linux")};
+  Tabla res = db.busqueda(c, "alumnos_col").materializar();
+  EXPECT_EQ(res.almacenamiento(), Tabla::POR_COLUMNAS);
+  EXPECT_EQ(res.cant_registros(), 3);
+  EXPECT_EQ(res, db.busqueda(c, "alumnos").materializar());
+}
+
 TEST_F(DBAlumnos, crit_simple_nombre) {
   // ==
   EXPECT_FALSE(db.criterioValido({{Rig("LU_X", 1)}}, "libretas"));
@@ -601,28 +1466,44 @@ TEST_F(DBAlumnos, crit_doble_tipo) {
                                  "alumnos"));
 }
 
+TEST_F(DBAlumnos, crit_rango_tipo) {
+  EXPECT_TRUE(db.criterioValido({{Rmenor("LU_A", 5)}}, "libretas"));
+  EXPECT_TRUE(db.criterioValido({{Rentre("LU_A", 1, 5)}}, "libretas"));
+  EXPECT_FALSE(db.criterioValido({{Rmayor("LU_A", "")}}, "libretas"));
+  EXPECT_TRUE(db.criterioValido({{Rprefijo("OS", "Li")}}, "alumnos"));
+  EXPECT_FALSE(db.criterioValido({{Rprefijo("LU_A", "1")}}, "libretas"));
+  EXPECT_FALSE(db.criterioValido({{Restriccion("LU_A", Restriccion::ENTRE,
+                                               datoNat(1), datoStr("5"))}},
+                                 "libretas"));
+
+  // Los operadores distinguen criterios con el mismo dato
+  EXPECT_FALSE(Rmenor("LU_A", 5) == Rmayor("LU_A", 5));
+  EXPECT_FALSE(Rentre("LU_A", 1, 5) == Rentre("LU_A", 1, 6));
+  EXPECT_TRUE(Rig("LU_A", 5) == Restriccion("LU_A", datoNat(5), true));
+}
+
 // ## Uso Criterio
 TEST_F(DBAlumnos, uso_un_criterio) {
-  db.busqueda({Rig("OS", "A")}, "alumnos");
+  db.busqueda({Rig("OS", "A")}, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio({Rig("OS", "A")}), 1);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({{Rig("OS", "A")}}));
-  db.busqueda({Rig("OS", "A")}, "alumnos");
+  db.busqueda({Rig("OS", "A")}, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio({Rig("OS", "A")}), 2);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({{Rig("OS", "A")}}));
 
-  db.busqueda({Rig("LU_A", 1)}, "libretas");
+  db.busqueda({Rig("LU_A", 1)}, "libretas").materializar();
   EXPECT_EQ(db.uso_criterio({Rig("LU_A", 1)}), 1);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({{Rig("OS", "A")}}));
 
-  db.busqueda({Rig("LU_A", 1)}, "libretas");
+  db.busqueda({Rig("LU_A", 1)}, "libretas").materializar();
   EXPECT_EQ(db.uso_criterio({Rig("LU_A", 1)}), 2);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({{Rig("OS", "A")},
                                        {Rig("LU_A", 1)}}));
-  db.busqueda({Rig("LU_A", 1)}, "libretas");
+  db.busqueda({Rig("LU_A", 1)}, "libretas").materializar();
   EXPECT_EQ(db.uso_criterio({Rig("LU_A", 1)}), 3);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({{Rig("LU_A", 1)}}));
@@ -632,19 +1513,19 @@ TEST_F(DBAlumnos, uso_un_criterio_perm) {
   BaseDeDatos::Criterio c = {Rig("OS", "A"), Rig("Editor", "Vim")};
   BaseDeDatos::Criterio c_perm = {Rig("Editor", "Vim"), Rig("OS", "A")};
   BaseDeDatos::Criterio c_sim = {Rig("OS", "A")};
-  db.busqueda(c, "alumnos");
+  db.busqueda(c, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio(c), 1);
   EXPECT_EQ(db.uso_criterio(c_sim), 0);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({c}));
 
-  db.busqueda(c_perm, "alumnos");
+  db.busqueda(c_perm, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio(c), 2);
   EXPECT_EQ(db.uso_criterio(c_sim), 0);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({c}));
 
-  db.busqueda(c_sim, "alumnos");
+  db.busqueda(c_sim, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio(c_sim), 1);
   EXPECT_EQ(db.top_criterios(),
             linear_set<BaseDeDatos::Criterio>({c}));
@@ -657,11 +1538,11 @@ TEST_F(DBAlumnos, crit_otro_bool) {
   EXPECT_EQ(db.uso_criterio(c), 0);
   EXPECT_EQ(db.uso_criterio(c_inv), 0);
 
-  db.busqueda(c, "alumnos");
+  db.busqueda(c, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio(c), 1);
   EXPECT_EQ(db.uso_criterio(c_inv), 0);
 
-  db.busqueda(c_inv, "alumnos");
+  db.busqueda(c_inv, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio(c), 1);
   EXPECT_EQ(db.uso_criterio(c_inv), 1);
 }
@@ -673,11 +1554,11 @@ TEST_F(DBAlumnos, crit_doble_otro_bool) {
   EXPECT_EQ(db.uso_criterio(c), 0);
   EXPECT_EQ(db.uso_criterio(c_inv), 0);
 
-  db.busqueda(c, "alumnos");
+  db.busqueda(c, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio(c), 1);
   EXPECT_EQ(db.uso_criterio(c_inv), 0);
 
-  db.busqueda(c_inv, "alumnos");
+  db.busqueda(c_inv, "alumnos").materializar();
   EXPECT_EQ(db.uso_criterio(c), 1);
   EXPECT_EQ(db.uso_criterio(c_inv), 1);
 }
@@ -715,6 +1596,30 @@ TEST_F(DBAlumnos, join_sin_repetidos) {
   EXPECT_EQ(join, join_libretas_alumnos.registros());
 }
 
+TEST_F(DBAlumnos, join_indice_hash) {
+  db.crearIndice("alumnos", "LU", Indice::HASH);
+  linear_set<Registro> join(db.join("libretas", "alumnos", "LU"), db.join_end());
+  EXPECT_EQ(join, join_libretas_alumnos.registros());
+}
+
+TEST_F(DBAlumnos, join_particionado) {
+  Particionado porLU = Particionado::porHash("LU", 4);
+  db.crearTabla("libretas_part", def_libretas.claves, def_libretas.campos,
+                def_libretas.tipos, Tabla::POR_FILAS, porLU);
+  db.crearTabla("alumnos_part", def_alumnos.claves, def_alumnos.campos,
+                def_alumnos.tipos, Tabla::POR_COLUMNAS, porLU);
+  for (auto it = libretas.registros_begin(); it != libretas.registros_end(); ++it) {
+    db.agregarRegistro(*it, "libretas_part");
+  }
+  for (auto it = alumnos.registros_begin(); it != alumnos.registros_end(); ++it) {
+    db.agregarRegistro(*it, "alumnos_part");
+  }
+  db.crearIndice("alumnos_part", "LU");
+  linear_set<Registro> join(db.join("alumnos_part", "libretas_part", "LU"),
+                            db.join_end());
+  EXPECT_EQ(join, join_libretas_alumnos.registros());
+}
+
 TEST_F(DBAlumnos, join_repetidos_uno) {
   db.crearIndice("libretas", "LU");
   auto begin = db.join("libretas", "materias", "LU");
@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include "../src/BloqueEnteros.h"
+
+TEST(bloque_enteros_test, vacio) {
+    BloqueEnteros b;
+    EXPECT_EQ(b.tam(), 0);
+    EXPECT_EQ(b.valores(), vector<int>());
+    EXPECT_EQ(BloqueEnteros(vector<int>()).tam(), 0);
+}
+
+TEST(bloque_enteros_test, bits) {
+    vector<int> valores;
+    for (int i = 0; i < 1000; i++) {
+        valores.push_back(1000000 + (i * 7919) % 5000);
+    }
+    BloqueEnteros b(valores);
+    EXPECT_EQ(b.codificacion(), BloqueEnteros::BITS);
+    EXPECT_EQ(b.tam(), 1000);
+    EXPECT_EQ(b.valores(), valores);
+    for (size_t i = 0; i < valores.size(); i++) {
+        EXPECT_EQ(b.valor(i), valores[i]);
+    }
+    // 13 bits por valor en lugar de 32
+    EXPECT_LE(b.bytes(), 1000 * 13 / 8 + 8);
+}
+
+TEST(bloque_enteros_test, runs) {
+    vector<int> valores;
+    for (int i = 0; i < 1000; i++) {
+        valores.push_back(i / 100);
+    }
+    BloqueEnteros b(valores);
+    EXPECT_EQ(b.codificacion(), BloqueEnteros::RUNS);
+    EXPECT_EQ(b.valores(), valores);
+    EXPECT_EQ(b.valor(0), 0);
+    EXPECT_EQ(b.valor(99), 0);
+    EXPECT_EQ(b.valor(100), 1);
+    EXPECT_EQ(b.valor(999), 9);
+    EXPECT_EQ(b.bytes(), 10 * 8);
+
+    // Todos iguales: no hace falta ningún bit
+    BloqueEnteros iguales(vector<int>(500, 42));
+    EXPECT_EQ(iguales.valores(), vector<int>(500, 42));
+    EXPECT_LE(iguales.bytes(), 8);
+}
+
+TEST(bloque_enteros_test, extremos) {
+    vector<int> valores = {0, 2147483647, -5, 17, 2147483647, 0};
+    BloqueEnteros b(valores);
+    EXPECT_EQ(b.valores(), valores);
+}
+
+TEST(bloque_enteros_test, filtrar) {
+    for (int largoTramo : {1, 50}) {
+        vector<int> valores;
+        for (int i = 0; i < 1000; i++) {
+            valores.push_back(i / largoTramo % 7);
+        }
+        BloqueEnteros b(valores);
+        vector<int> ids;
+        for (int i = 0; i < 1000; i += 3) {
+            ids.push_back(5000 + i);
+        }
+        for (int buscado : {3, 9, -1}) {
+            for (bool igualdad : {true, false}) {
+                vector<int> esperados;
+                for (int id : ids) {
+                    if ((valores[id - 5000] == buscado) == igualdad) {
+                        esperados.push_back(id);
+                    }
+                }
+                vector<int> res = ids;
+                int cant = b.filtrar(res.data(), res.size(), 5000, buscado,
+                                     igualdad, res.data());
+                res.resize(cant);
+                EXPECT_EQ(res, esperados);
+            }
+        }
+    }
+}
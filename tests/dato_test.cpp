@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "../src/Dato.h"
+#include "../src/HeapStrings.h"
 
 TEST(dato_test, generadores) {
     Dato(5);
@@ -46,3 +47,51 @@ TEST(dato_test, shortcuts) {
 TEST(dato_test, implicit_cast) {
     EXPECT_EQ(datoStr("Hola"), (Dato)"Hola");
 }
+
+TEST(dato_test, igobs_prefijo) {
+    // Mismo prefijo, distinto resto
+    EXPECT_EQ(Dato("Computacion"), Dato("Computacion"));
+    EXPECT_NE(Dato("Computacion"), Dato("Computadora"));
+    // Mismo prefijo, distinta longitud
+    EXPECT_NE(Dato("Comp"), Dato("Compu"));
+    EXPECT_NE(Dato("Co"), Dato("Comp"));
+    // Strings que entran en el prefijo
+    EXPECT_EQ(Dato("ab"), Dato("ab"));
+    EXPECT_NE(Dato("ab"), Dato("ba"));
+    EXPECT_NE(Dato(""), Dato("a"));
+    EXPECT_EQ(Dato("Computacion").valorStr(), "Computacion");
+}
+
+TEST(dato_test, orden) {
+    EXPECT_LT(Dato("a"), Dato("b"));
+    EXPECT_LT(Dato("ab"), Dato("abc"));
+    EXPECT_LT(Dato("abcd"), Dato("abcde"));
+    EXPECT_LT(Dato("Computacion"), Dato("Computadora"));
+    EXPECT_LT(Dato("Compu"), Dato("Computacion"));
+    EXPECT_FALSE(Dato("Computacion") < Dato("Computacion"));
+    EXPECT_LT(Dato("zzzz"), Dato(0));
+    EXPECT_LT(Dato(3), Dato(5));
+}
+
+TEST(dato_test, heap_strings) {
+    HeapStrings heap;
+    Dato d = heap.guardar(Dato("Computacion"));
+    EXPECT_EQ(d, Dato("Computacion"));
+    EXPECT_EQ(d.valorStr(), "Computacion");
+    EXPECT_EQ(heap.guardar(Dato("Mate")), Dato("Mate"));
+    EXPECT_EQ(heap.guardar(Dato(5)), Dato(5));
+
+    // La copia no pisa los strings del original
+    HeapStrings copia(heap);
+    Dato d1 = heap.guardar(Dato("Biologia"));
+    Dato d2 = copia.guardar(Dato("Quimica!"));
+    EXPECT_EQ(d1.valorStr(), "Biologia");
+    EXPECT_EQ(d2.valorStr(), "Quimica!");
+    EXPECT_EQ(d.valorStr(), "Computacion");
+
+    // Los strings largos se comparten y siguen vivos sin el original
+    string largo(2 * HeapStrings::LONGITUD_COMPARTIDA, 'x');
+    Dato compartido = heap.guardar(Dato(largo + "y"));
+    EXPECT_EQ(compartido.valorStr(), largo + "y");
+    EXPECT_EQ(copia.guardar(compartido), compartido);
+}
@@ -32,7 +32,7 @@ class MapTest : public testing::Test {
     vector<string> string_keys = {
       "Haciendo", "palmas", "arriba"
     };
-    for (int i = 0; i < string_keys.size(); i++) {
+    for (size_t i = 0; i < string_keys.size(); i++) {
       string_map.insert(make_pair(string_keys[i], i));
       datos.insert(make_pair(string_keys[i], Dato(string_keys[i])));
     }
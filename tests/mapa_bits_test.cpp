@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+#include "../src/MapaBits.h"
+
+namespace {
+
+MapaBits mapaDe(const set<int> &ids) {
+    MapaBits res;
+    for (int id : ids) {
+        res.agregar(id);
+    }
+    return res;
+}
+
+vector<int> idsDe(const set<int> &ids) {
+    return vector<int>(ids.begin(), ids.end());
+}
+
+}
+
+TEST(mapa_bits_test, vacio) {
+    MapaBits m;
+    EXPECT_TRUE(m.vacio());
+    EXPECT_EQ(m.cardinal(), 0);
+    EXPECT_EQ(m.ids(), vector<int>());
+    EXPECT_FALSE(m.contiene(0));
+    m.sacar(5);
+    EXPECT_TRUE(m.vacio());
+}
+
+TEST(mapa_bits_test, agregar_y_sacar) {
+    set<int> esperado;
+    MapaBits m;
+    // Contenedores chicos, uno denso y uno en el límite entre formas
+    for (int i = 0; i < 20000; i++) {
+        int id = (i * 7919) % 20000;
+        if (id % 3 != 0) {
+            m.agregar(id);
+            esperado.insert(id);
+        }
+    }
+    for (int i = 0; i < MapaBits::MAX_ARREGLO + 1; i++) {
+        m.agregar(200000 + i * 2);
+        esperado.insert(200000 + i * 2);
+    }
+    m.agregar(5000000);
+    esperado.insert(5000000);
+    m.agregar(5000000);
+    EXPECT_EQ(m.cardinal(), esperado.size());
+    EXPECT_EQ(m.ids(), idsDe(esperado));
+    EXPECT_TRUE(m.contiene(5000000));
+    EXPECT_FALSE(m.contiene(3));
+    EXPECT_TRUE(m.contiene(200002));
+
+    // El contenedor en el límite vuelve a arreglo al sacar un id
+    m.sacar(200002);
+    esperado.erase(200002);
+    m.sacar(200003);
+    m.sacar(5000000);
+    esperado.erase(5000000);
+    EXPECT_EQ(m.ids(), idsDe(esperado));
+    EXPECT_EQ(m, mapaDe(esperado));
+
+    // Un mapa denso ocupa un bit por id posible
+    EXPECT_LE(m.bytes(), 8192 + MapaBits::MAX_ARREGLO * 2 + 64);
+}
+
+TEST(mapa_bits_test, operaciones) {
+    // Combinaciones de contenedores arreglo y mapa
+    set<int> a;
+    set<int> b;
+    for (int i = 0; i < 65536; i++) {
+        if (i % 2 == 0) {
+            a.insert(i);
+        }
+        if (i % 300 == 0) {
+            b.insert(i);
+        }
+        if (i % 5 == 0) {
+            a.insert(65536 + i);
+            b.insert(65536 + i + 1);
+        }
+        if (i % 1000 == 0) {
+            a.insert(2 * 65536 + i);
+            b.insert(2 * 65536 + i + (i % 2000));
+        }
+    }
+    b.insert(10 * 65536);
+
+    MapaBits ma = mapaDe(a);
+    MapaBits mb = mapaDe(b);
+    set<int> interseccion;
+    set<int> diferencia;
+    set<int> diferenciaInversa;
+    set<int> union_;
+    set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                     inserter(interseccion, interseccion.end()));
+    set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                   inserter(diferencia, diferencia.end()));
+    set_difference(b.begin(), b.end(), a.begin(), a.end(),
+                   inserter(diferenciaInversa, diferenciaInversa.end()));
+    set_union(a.begin(), a.end(), b.begin(), b.end(),
+              inserter(union_, union_.end()));
+
+    EXPECT_EQ(MapaBits::intersecar(ma, mb).ids(), idsDe(interseccion));
+    EXPECT_EQ(MapaBits::intersecar(mb, ma).ids(), idsDe(interseccion));
+    EXPECT_EQ(MapaBits::restar(ma, mb).ids(), idsDe(diferencia));
+    EXPECT_EQ(MapaBits::restar(mb, ma).ids(), idsDe(diferenciaInversa));
+    EXPECT_EQ(MapaBits::unir(ma, mb).ids(), idsDe(union_));
+    EXPECT_EQ(MapaBits::unir(ma, mb).cardinal(), union_.size());
+
+    // Los resultados quedan en la misma forma que armados id por id
+    EXPECT_EQ(MapaBits::intersecar(ma, mb), mapaDe(interseccion));
+    EXPECT_EQ(MapaBits::restar(ma, mb), mapaDe(diferencia));
+    EXPECT_EQ(MapaBits::unir(ma, mb), mapaDe(union_));
+    EXPECT_TRUE(MapaBits::restar(ma, ma).vacio());
+}
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "../src/Dato.h"
 #include "../src/Registro.h"
+#include "../src/RegistroCombinado.h"
 
 using namespace std;
 
@@ -28,6 +29,11 @@ TEST(registro_test, dato) {
     EXPECT_EQ(r.dato("Nombre").valorStr(), "March");
 }
 
+TEST(registro_test, dato_campo_inexistente) {
+    Registro r({"LU"}, {datoNat(182)});
+    EXPECT_THROW(r.dato("Carrera"), out_of_range);
+}
+
 TEST(registro_test, ig_obs) {
     Registro r1({"LU", "LU_A"}, {datoNat(1), datoStr("a")});
     Registro r2({"LU", "LU_A"}, {datoNat(1), datoStr("a")});
@@ -58,3 +64,41 @@ TEST(registro_test, copy) {
     auto copy_r(r);
     EXPECT_EQ(copy_r, r);
 }
+
+TEST(registro_test, schema) {
+    shared_ptr<const Schema> s = make_shared<const Schema>(
+            vector<string>({"LU", "Nombre"}));
+    EXPECT_EQ(s->cantCampos(), 2);
+    EXPECT_EQ(s->ordinal("Nombre"), 1);
+    EXPECT_EQ(s->ordinal("Carrera"), -1);
+
+    Registro r1(*s, {datoNat(1), datoStr("March")});
+    Registro r2(*s, {datoNat(2), datoStr("Gerva")});
+    EXPECT_EQ(r1.schema(), r2.schema());
+    EXPECT_EQ(r1.dato("Nombre").valorStr(), "March");
+    EXPECT_EQ(r1, Registro({"Nombre", "LU"}, {datoStr("March"), datoNat(1)}));
+    EXPECT_FALSE(r1 == r2);
+}
+
+TEST(registro_test, campo_repetido) {
+    Registro r({"A", "B", "A"}, {datoNat(1), datoNat(2), datoNat(3)});
+    EXPECT_EQ(r.campos(), linear_set<string>({"A", "B"}));
+    EXPECT_EQ(r.dato("A"), datoNat(3));
+}
+
+TEST(registro_test, combinado) {
+    Registro r1({"X", "Y"}, {datoNat(1), datoNat(2)});
+    Registro r2({"Y", "Z"}, {datoNat(3), datoStr("A")});
+    RegistroCombinado c(r1, r2);
+
+    EXPECT_EQ(c.campos(), linear_set<string>({"X", "Y", "Z"}));
+    // Ante campos repetidos vale el registro prioritario
+    EXPECT_EQ(c.dato("Y"), datoNat(2));
+    EXPECT_EQ(c.dato("Z"), datoStr("A"));
+    EXPECT_EQ(c.dato(r2.schema()->id("Y")), datoNat(2));
+    EXPECT_EQ(c.dato(r2.schema()->id("Z")), datoStr("A"));
+    EXPECT_EQ(c.dato(r1.schema()->id("X")), datoNat(1));
+
+    EXPECT_EQ(c.materializar(),
+              Registro({"X", "Y", "Z"}, {datoNat(1), datoNat(2), datoStr("A")}));
+}
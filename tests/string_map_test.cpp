@@ -113,6 +113,27 @@ TEST(string_map_test, test_eliminar) {
     EXPECT_TRUE(m1.empty());
 }
 
+TEST(string_map_test, test_eliminar_con_prefijo_definido) {
+    // Borrar una clave no borra las que son prefijo suyo
+    string_map<int> m1;
+    m1["K"] = 1;
+    m1["K,C"] = 2;
+    m1["C"] = 3;
+    m1.erase("K,C");
+    EXPECT_TRUE(m1.count("K"));
+    EXPECT_EQ(m1.at("K"), 1);
+    EXPECT_FALSE(m1.count("K,C"));
+    EXPECT_TRUE(m1.count("C"));
+    EXPECT_EQ(m1.size(), 2);
+    m1["K,C"] = 4;
+    EXPECT_EQ(m1.at("K,C"), 4);
+    m1.erase("K");
+    m1.erase("K,C");
+    EXPECT_FALSE(m1.count("K"));
+    EXPECT_EQ(m1.size(), 1);
+    EXPECT_EQ(m1.begin()->first, "C");
+}
+
 TEST(string_map_test, test_vaciar) {
     string_map<int> m1;
     m1["hola"] = 1;
@@ -226,3 +247,32 @@ TEST(string_map_test, no_default) {
   EXPECT_NE(dato_map.find("EvilMarch"), dato_map.end());
 }
 
+
+TEST(string_map_test, lower_bound) {
+  string_map<int> m;
+  const string_map<int> &cm = m;
+  EXPECT_EQ(cm.lower_bound("a"), cm.end());
+
+  m["ab"] = 1;
+  m["abc"] = 2;
+  m["b"] = 3;
+  m["bca"] = 4;
+  m["d"] = 5;
+
+  EXPECT_EQ((*cm.lower_bound("")).first, "ab");
+  EXPECT_EQ((*cm.lower_bound("a")).first, "ab");
+  EXPECT_EQ((*cm.lower_bound("ab")).first, "ab");
+  EXPECT_EQ((*cm.lower_bound("aba")).first, "abc");
+  EXPECT_EQ((*cm.lower_bound("abd")).first, "b");
+  EXPECT_EQ((*cm.lower_bound("bb")).first, "bca");
+  EXPECT_EQ((*cm.lower_bound("bc")).first, "bca");
+  EXPECT_EQ((*cm.lower_bound("c")).first, "d");
+  EXPECT_EQ(cm.lower_bound("da"), cm.end());
+  EXPECT_EQ(cm.lower_bound("e"), cm.end());
+
+  // Desde lower_bound se sigue en orden
+  auto it = cm.lower_bound("abb");
+  EXPECT_EQ((*it).first, "abc");
+  ++it;
+  EXPECT_EQ((*it).first, "b");
+}
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "../src/Tabla.h"
 #include "../src/utils.h"
+#include <algorithm>
 
 using namespace std;
 
@@ -164,3 +165,425 @@ TEST(tabla_test, it_registro) {
   linear_set<Registro> r_set = to_set(t.registros_begin(), t.registros_end());
   EXPECT_EQ(r_set, t.registros());
 }
+
+TEST_F(TablaTests, schema_compartido) {
+  auto rIt1 = t2.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(1), Dato("A")}));
+  auto rIt2 = t2.agregarRegistro(Registro({"Carrera", "Cod"}, {Dato("B"), Dato(2)}));
+  EXPECT_EQ(rIt1->schema(), t2.schema());
+  EXPECT_EQ(rIt2->schema(), t2.schema());
+  EXPECT_EQ(rIt2->dato("Cod"), Dato(2));
+  EXPECT_EQ(rIt2->dato("Carrera"), Dato("B"));
+}
+
+TEST_F(TablaTests, campoId) {
+  FieldId carrera = t2.campoId("Carrera");
+  EXPECT_EQ(carrera.campo(), "Carrera");
+  EXPECT_TRUE(t2.tipoCampo(carrera).esString());
+
+  auto rIt = t2.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(1), Dato("A")}));
+  EXPECT_EQ(rIt->dato(carrera), Dato("A"));
+
+  // Un registro con otro schema resuelve el campo por nombre
+  Registro r({"Carrera", "Cod"}, {Dato("B"), Dato(2)});
+  EXPECT_EQ(r.dato(carrera), Dato("B"));
+  EXPECT_EQ(r.dato(t2.campoId("Cod")), Dato(2));
+}
+
+TEST_F(TablaTests, varios_grupos) {
+  // Más registros que los que entran en un grupo
+  int n = 2 * ArenaRegistros::TAM_GRUPO + 10;
+  auto primero = t2.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(0), Dato("C0")}));
+  const Registro *dirPrimero = &(*primero);
+  for (int i = 1; i < n; i++) {
+    t2.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(i), Dato("C" + to_string(i))}));
+  }
+  EXPECT_EQ(t2.cant_registros(), n);
+  // Las direcciones de los registros no cambian al agregar
+  EXPECT_EQ(&(*t2.registros_begin()), dirPrimero);
+
+  int i = 0;
+  for (auto it = t2.registros_begin(); it != t2.registros_end(); ++it) {
+    EXPECT_EQ(it->dato("Cod"), Dato(i));
+    i++;
+  }
+  EXPECT_EQ(i, n);
+}
+
+TEST(tabla_test, por_columnas) {
+  Tabla filas({"LU"}, {"LU", "Nombre", "Ano"}, {tipoStr, tipoStr, tipoNat});
+  Tabla columnas({"LU"}, {"LU", "Nombre", "Ano"}, {tipoStr, tipoStr, tipoNat},
+                 Tabla::POR_COLUMNAS);
+  EXPECT_EQ(columnas.almacenamiento(), Tabla::POR_COLUMNAS);
+  EXPECT_EQ(columnas.registros_begin(), columnas.registros_end());
+
+  vector<Registro> regs = {
+      Registro({"LU", "Nombre", "Ano"}, {datoStr("1/90"), datoStr("March"), datoNat(90)}),
+      Registro({"Nombre", "LU", "Ano"}, {datoStr("Gerva"), datoStr("2/80"), datoNat(80)}),
+      Registro({"LU", "Nombre", "Ano"}, {datoStr("3/90"), datoStr("March"), datoNat(90)})};
+  for (const Registro &r : regs) {
+    filas.agregarRegistro(r);
+    auto it = columnas.agregarRegistro(r);
+    EXPECT_EQ(*it, r);
+  }
+  EXPECT_EQ(columnas.cant_registros(), 3);
+  EXPECT_EQ(columnas, filas);
+  EXPECT_EQ(columnas.registro(1), regs[1]);
+  EXPECT_EQ(columnas.registro(1).dato(columnas.campoId("Ano")), datoNat(80));
+
+  int i = 0;
+  for (auto it = columnas.registros_begin(); it != columnas.registros_end(); ++it) {
+    EXPECT_EQ(*it, regs[i]);
+    EXPECT_EQ(it->dato("LU"), regs[i].dato("LU"));
+    i++;
+  }
+  EXPECT_EQ(i, 3);
+
+  vector<int> ids = {0, 1, 2};
+  columnas.filtrar(ids, columnas.campoId("Nombre"), datoStr("March"), true);
+  EXPECT_EQ(ids, vector<int>({0, 2}));
+  columnas.filtrar(ids, columnas.campoId("LU"), datoStr("1/90"), false);
+  EXPECT_EQ(ids, vector<int>({2}));
+  ids = {0, 1, 2};
+  columnas.filtrar(ids, columnas.campoId("Nombre"), datoStr("Nadie"), true);
+  EXPECT_TRUE(ids.empty());
+}
+
+TEST(tabla_test, registros_al_agregar) {
+  for (Tabla::Almacenamiento a : {Tabla::POR_FILAS, Tabla::POR_COLUMNAS}) {
+    Tabla t({"LU"}, {"LU", "Ano"}, {tipoNat, tipoNat}, a);
+    // El conjunto armado acompaña a los registros que se agregan
+    for (int i = 0; i < 50; ++i) {
+      Registro r({"LU", "Ano"}, {datoNat(i), datoNat(i % 7)});
+      t.agregarRegistro(r);
+      EXPECT_EQ(t.registros().size(), i + 1);
+      EXPECT_TRUE(pertenece(r, t.registros()));
+    }
+    t.borrarRegistros({3});
+    t.agregarRegistro(Registro({"LU", "Ano"}, {datoNat(50), datoNat(1)}));
+    EXPECT_EQ(t.registros(), to_set(t.registros_begin(), t.registros_end()));
+    EXPECT_FALSE(pertenece(Registro({"LU", "Ano"}, {datoNat(3), datoNat(3)}),
+                           t.registros()));
+  }
+}
+
+TEST_F(TablaTests, existeClave) {
+  Registro r1({"LU", "LU_A", "Nombre", "Carrera"},
+              {Dato(1), Dato(90), Dato("March"), Dato("Comp")});
+  Registro r2({"Carrera", "Nombre", "LU_A", "LU"},
+              {Dato("Mate"), Dato("Gerva"), Dato(90), Dato(1)});
+  Registro r3({"LU", "LU_A", "Nombre", "Carrera"},
+              {Dato(1), Dato(91), Dato("March"), Dato("Comp")});
+  EXPECT_FALSE(t.existeClave(r1));
+  auto it = t.agregarRegistro(r1);
+  EXPECT_TRUE(t.existeClave(r1));
+  // Mismas claves con otros datos y en otro orden de campos
+  EXPECT_TRUE(t.existeClave(r2));
+  EXPECT_FALSE(t.existeClave(r3));
+
+  // Insertar un registro repetido no agrega y devuelve el existente
+  Registro r1bis({"Carrera", "Nombre", "LU_A", "LU"},
+                 {Dato("Comp"), Dato("March"), Dato(90), Dato(1)});
+  EXPECT_EQ(t.agregarRegistro(r1bis), it);
+  EXPECT_EQ(t.cant_registros(), 1);
+
+  // Las claves no definen la igualdad: un registro con las mismas claves y
+  // otros datos no se descarta en silencio
+  Tabla copia = t;
+  copia.agregarRegistro(r2);
+  EXPECT_EQ(copia.cant_registros(), 2);
+  EXPECT_TRUE(pertenece(r2, copia.registros()));
+  copia.agregarRegistro(r3);
+  EXPECT_TRUE(copia.existeClave(r3));
+  EXPECT_FALSE(t.existeClave(r3));
+
+  Tabla columnas({"Cod"}, {"Cod", "Carrera"}, {tipoNat, tipoStr},
+                 Tabla::POR_COLUMNAS);
+  columnas.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(1), Dato("A")}));
+  EXPECT_TRUE(columnas.existeClave(Registro({"Cod", "Carrera"}, {Dato(1), Dato("B")})));
+  EXPECT_FALSE(columnas.existeClave(Registro({"Cod", "Carrera"}, {Dato(2), Dato("A")})));
+
+  // Los registros por fuera de la descripción de la tabla también se
+  // indexan por sus claves
+  Registro extra({"Cod", "Carrera", "Plan"}, {Dato(7), Dato("C"), Dato(2010)});
+  Registro sinClave({"Carrera"}, {Dato("D")});
+  auto itExtra = t2.agregarRegistro(extra);
+  auto itSinClave = t2.agregarRegistro(sinClave);
+  EXPECT_TRUE(t2.existeClave(Registro({"Cod", "Carrera"}, {Dato(7), Dato("X")})));
+  EXPECT_EQ(t2.agregarRegistro(extra), itExtra);
+  EXPECT_EQ(t2.agregarRegistro(sinClave), itSinClave);
+  EXPECT_EQ(t2.cant_registros(), 2);
+  t2.borrarRegistros(t2.ids());
+  EXPECT_FALSE(t2.existeClave(extra));
+  EXPECT_EQ(t2.cant_registros(), 0);
+}
+
+TEST(tabla_test, borrar_actualizar) {
+  for (Tabla::Almacenamiento modo : {Tabla::POR_FILAS, Tabla::POR_COLUMNAS}) {
+    Tabla t({"Cod"}, {"Cod", "Carrera"}, {tipoNat, tipoStr}, modo);
+    int n = ArenaRegistros::TAM_GRUPO + 5;
+    for (int i = 0; i < n; i++) {
+      t.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(i), Dato("C" + to_string(i % 3))}));
+    }
+    // Se borran los pares, incluido el primero y el último
+    vector<int> pares;
+    for (int i = 0; i < n; i += 2) {
+      pares.push_back(i);
+    }
+    const Registro *dirUno = &(*t.iterador(1));
+    t.borrarRegistros(pares);
+    EXPECT_EQ(t.cant_registros(), n / 2);
+    EXPECT_EQ(t.cant_borrados(), n - n / 2);
+    EXPECT_FALSE(t.existeClave(Registro({"Cod", "Carrera"}, {Dato(0), Dato("C0")})));
+    int i = 1;
+    for (auto it = t.registros_begin(); it != t.registros_end(); ++it) {
+      EXPECT_EQ(it->dato("Cod"), Dato(i));
+      i += 2;
+    }
+    EXPECT_EQ(i / 2, n / 2);
+    if (modo == Tabla::POR_FILAS) {
+      // Los registros no borrados no se mueven
+      EXPECT_EQ(&(*t.registros_begin()), dirUno);
+    }
+
+    // Una clave borrada se puede volver a usar
+    t.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(0), Dato("Nueva")}));
+    EXPECT_TRUE(t.existeClave(Registro({"Cod", "Carrera"}, {Dato(0), Dato("")})));
+
+    Registro cambioCarrera({"Carrera"}, {Dato("Otra")});
+    Registro cambioCod({"Cod"}, {Dato(3)});
+    EXPECT_TRUE(t.puedeActualizar({1, 3}, cambioCarrera));
+    EXPECT_FALSE(t.puedeActualizar({1}, cambioCod));
+    EXPECT_FALSE(t.puedeActualizar({1, 5}, cambioCod));
+    // Dos registros no pueden quedar con la misma clave
+    EXPECT_FALSE(t.puedeActualizar({1, 3}, Registro({"Cod"}, {Dato(n + 10)})));
+    // Si el 3 deja su clave, el 1 la puede tomar
+    t.actualizarRegistros({3}, Registro({"Cod"}, {Dato(n + 10)}));
+    EXPECT_TRUE(t.puedeActualizar({1}, cambioCod));
+    t.actualizarRegistros({1}, cambioCod);
+    t.actualizarRegistros({1, 3}, cambioCarrera);
+    EXPECT_EQ(t.registro(1), Registro({"Cod", "Carrera"}, {Dato(3), Dato("Otra")}));
+    EXPECT_EQ(t.registro(3), Registro({"Cod", "Carrera"}, {Dato(n + 10), Dato("Otra")}));
+    EXPECT_TRUE(t.existeClave(cambioCod));
+    EXPECT_FALSE(t.existeClave(Registro({"Cod"}, {Dato(1)})));
+
+    linear_set<Registro> antes = t.registros();
+    t.compactar();
+    EXPECT_EQ(t.cant_borrados(), 0);
+    EXPECT_EQ(t.registros(), antes);
+    EXPECT_EQ(t.ids().size(), t.cant_registros());
+    EXPECT_TRUE(t.existeClave(cambioCod));
+  }
+}
+
+TEST(tabla_test, columnas_comprimidas) {
+  Tabla t({"Cod"}, {"Cod", "Lote", "Estado"}, {tipoNat, tipoNat, tipoStr},
+          Tabla::POR_COLUMNAS);
+  int b = ColumnasRegistros::TAM_BLOQUE;
+  vector<string> estados = {"pendiente", "enviado", "entregado"};
+  for (int i = 0; i < 3 * b + 10; i++) {
+    t.agregarRegistro(Registro({"Cod", "Lote", "Estado"},
+                               {Dato(100000 + i), Dato(i / 100),
+                                Dato(estados[i % 3])}));
+  }
+  EXPECT_EQ(t.cant_registros(), 3 * b + 10);
+  EXPECT_EQ(t.registro(b + 5).dato("Cod"), Dato(100000 + b + 5));
+  EXPECT_EQ(t.registro(2 * b).dato("Estado"), Dato(estados[2 * b % 3]));
+  EXPECT_EQ(t.registro(3 * b + 9).dato("Lote"), Dato((3 * b + 9) / 100));
+
+  // Los filtros se resuelven sobre los bloques comprimidos
+  vector<int> ids = t.ids();
+  t.filtrar(ids, t.campoId("Lote"), Dato(15), true);
+  EXPECT_EQ(ids.size(), 100);
+  EXPECT_EQ(ids.front(), 1500);
+  ids = t.ids();
+  t.filtrar(ids, t.campoId("Estado"), Dato("enviado"), false);
+  EXPECT_EQ(ids.size(), 3 * b + 10 - (3 * b + 10 + 1) / 3);
+  ids = t.ids();
+  t.filtrar(ids, t.campoId("Cod"), Dato(5), true);
+  EXPECT_TRUE(ids.empty());
+
+  // Actualizar un registro de un bloque comprimido lo vuelve a comprimir
+  t.actualizarRegistros({7}, Registro({"Lote", "Estado"},
+                                      {Dato(99), Dato("devuelto")}));
+  EXPECT_EQ(t.registro(7).dato("Lote"), Dato(99));
+  EXPECT_EQ(t.registro(7).dato("Estado"), Dato("devuelto"));
+  EXPECT_EQ(t.registro(8).dato("Lote"), Dato(0));
+  ids = t.ids();
+  t.filtrar(ids, t.campoId("Estado"), Dato("devuelto"), true);
+  EXPECT_EQ(ids, vector<int>({7}));
+
+  // Una actualización de muchos registros, en varios bloques comprimidos y
+  // en el abierto
+  vector<int> lote15;
+  for (int i = 0; i < 3 * b + 10; i += 3) {
+    lote15.push_back(i);
+  }
+  t.actualizarRegistros(lote15, Registro({"Lote"}, {Dato(15)}));
+  for (int i = 0; i < 3 * b + 10; i++) {
+    int lote = i % 3 == 0 ? 15 : (i == 7 ? 99 : i / 100);
+    ASSERT_EQ(t.registro(i).dato("Lote"), Dato(lote));
+    ASSERT_EQ(t.registro(i).dato("Cod"), Dato(100000 + i));
+  }
+  ids = t.ids();
+  t.filtrar(ids, t.campoId("Lote"), Dato(15), true);
+  EXPECT_EQ(ids.size(), lote15.size() + 66);
+}
+
+TEST(tabla_test, zonas) {
+  for (Tabla::Almacenamiento modo : {Tabla::POR_FILAS, Tabla::POR_COLUMNAS}) {
+    Tabla t({"Cod"}, {"Cod", "Grupo"}, {tipoNat, tipoStr}, modo);
+    int g = ArenaRegistros::TAM_GRUPO;
+    for (int i = 0; i < 3 * g; i++) {
+      t.agregarRegistro(Registro({"Cod", "Grupo"}, {Dato(i), Dato("G" + to_string(i / g))}));
+    }
+    const ZonasRegistros &zonas = t.zonas();
+    EXPECT_EQ(zonas.cantGrupos(), 3);
+    int cod = t.campoId("Cod").ordinal();
+    int grupo = t.campoId("Grupo").ordinal();
+    EXPECT_TRUE(zonas.puedeContener(0, cod, Dato(0)));
+    EXPECT_TRUE(zonas.puedeContener(0, cod, Dato(g - 1)));
+    EXPECT_FALSE(zonas.puedeContener(0, cod, Dato(g)));
+    EXPECT_TRUE(zonas.puedeContener(1, cod, Dato(g)));
+    EXPECT_FALSE(zonas.puedeContener(2, cod, Dato(0)));
+    EXPECT_TRUE(zonas.puedeContener(1, grupo, Dato("G1")));
+    EXPECT_FALSE(zonas.puedeContener(1, grupo, Dato("G2")));
+    EXPECT_FALSE(zonas.puedeContener(3, cod, Dato(0)));
+
+    vector<int> ids = t.ids();
+    t.filtrar(ids, t.campoId("Cod"), Dato(g + 7), true);
+    EXPECT_EQ(ids, vector<int>({g + 7}));
+    ids = t.ids();
+    t.filtrar(ids, t.campoId("Grupo"), Dato("G2"), true);
+    EXPECT_EQ(ids.size(), g);
+    EXPECT_EQ(ids.front(), 2 * g);
+
+    // Al modificar un registro su grupo admite el valor nuevo
+    t.actualizarRegistros({5}, Registro({"Grupo"}, {Dato("G2")}));
+    EXPECT_TRUE(zonas.puedeContener(0, grupo, Dato("G2")));
+    ids = t.ids();
+    t.filtrar(ids, t.campoId("Grupo"), Dato("G2"), true);
+    EXPECT_EQ(ids.size(), g + 1);
+    EXPECT_EQ(ids.front(), 5);
+  }
+}
+
+TEST(tabla_test, estadisticas) {
+  Tabla t({"Cod"}, {"Cod", "Carrera", "Ano"}, {tipoNat, tipoStr, tipoNat});
+  int n = 10000;
+  for (int i = 0; i < n; i++) {
+    // Carrera "C0" en la mitad de los registros, el resto repartido en 100
+    string carrera = i % 2 == 0 ? "C0" : "C" + to_string(1 + i % 100);
+    t.agregarRegistro(Registro({"Cod", "Carrera", "Ano"},
+                               {Dato(i), Dato(carrera), Dato(i % 50)}));
+  }
+  const EstadisticasCampo &cod = t.estadisticas("Cod");
+  const EstadisticasCampo &carrera = t.estadisticas(t.campoId("Carrera"));
+  EXPECT_EQ(cod.cantidad(), n);
+  EXPECT_NEAR(cod.distintos(), n, n * 0.1);
+  EXPECT_NEAR(carrera.distintos(), 51, 5);
+  EXPECT_NEAR(t.estadisticas("Ano").distintos(), 50, 5);
+
+  EXPECT_EQ(carrera.frecuentes().front().first, Dato("C0"));
+  EXPECT_NEAR(carrera.selectividadIgual(Dato("C0")), 0.5, 0.05);
+  EXPECT_NEAR(carrera.selectividadIgual(Dato("C1")), 0.01, 0.01);
+
+  // Histograma equi-profundo de un campo uniforme
+  const vector<int> &limites = cod.histograma();
+  EXPECT_EQ(limites.size(), EstadisticasCampo::CANT_BALDES + 1);
+  EXPECT_TRUE(is_sorted(limites.begin(), limites.end()));
+  EXPECT_NEAR(cod.fraccionMenores(n / 4), 0.25, 0.05);
+  EXPECT_EQ(cod.fraccionMenores(-1), 0);
+  EXPECT_EQ(cod.fraccionMenores(n + 1), 1);
+  EXPECT_TRUE(carrera.histograma().empty());
+}
+
+TEST(tabla_test, estadisticas_al_actualizar) {
+  Tabla t({"Cod"}, {"Cod", "Carrera"}, {tipoNat, tipoStr});
+  for (int i = 0; i < 100; i++) {
+    t.agregarRegistro(Registro({"Cod", "Carrera"}, {Dato(i), Dato("C0")}));
+  }
+  // El mismo registro pasa por muchos valores: solo cuenta el último
+  for (int v = 1; v <= 5000; v++) {
+    t.actualizarRegistros({0}, Registro({"Carrera"}, {Dato("C" + to_string(v))}));
+  }
+  const EstadisticasCampo &carrera = t.estadisticas("Carrera");
+  EXPECT_EQ(carrera.cantidad(), 100);
+  // A lo sumo quedan contados los valores quitados desde el último recálculo
+  EXPECT_GE(carrera.distintos(), 1);
+  EXPECT_LE(carrera.distintos(),
+            3 + 100 / EstadisticasCampo::PROPORCION_QUITADOS);
+  EXPECT_NEAR(carrera.selectividadIgual(Dato("C0")), 0.99, 0.01);
+  EXPECT_NEAR(carrera.selectividadIgual(Dato("C5000")), 0.01, 0.01);
+  EXPECT_NEAR(carrera.selectividadIgual(Dato("C17")), 0, 0.01);
+
+  // Borrar también descuenta
+  t.borrarRegistros({1, 2, 3});
+  EXPECT_EQ(t.estadisticas("Cod").cantidad(), 97);
+  EXPECT_NEAR(t.estadisticas("Cod").fraccionMenores(50), 0.5, 0.05);
+}
+
+TEST(tabla_test, estadisticas_al_borrar) {
+  EstadisticasCampo cod(tipoNat);
+  for (int i = 0; i < 10000; i++) {
+    cod.agregar(Dato(i));
+  }
+  // Se borra la mitad más baja y después se agregan valores más altos: la
+  // muestra tiene que seguir a los que quedan, no a los últimos agregados
+  for (int i = 0; i < 5000; i++) {
+    cod.quitar(Dato(i));
+  }
+  EXPECT_NEAR(cod.fraccionMenores(7500), 0.5, 0.05);
+  for (int i = 10000; i < 12000; i++) {
+    cod.agregar(Dato(i));
+  }
+  EXPECT_EQ(cod.cantidad(), 7000);
+  EXPECT_EQ(cod.fraccionMenores(5000), 0);
+  EXPECT_NEAR(cod.fraccionMenores(7500), 2500.0 / 7000, 0.05);
+  EXPECT_NEAR(cod.fraccionMenores(10000), 5000.0 / 7000, 0.05);
+}
+
+TEST(tabla_test, particiones) {
+  Tabla porHash({"Cod"}, {"Cod", "Carrera"}, {tipoNat, tipoStr}, Tabla::POR_FILAS,
+                Particionado::porHash("Carrera", 4));
+  Tabla porRangos({"Cod"}, {"Cod", "Carrera"}, {tipoNat, tipoStr}, Tabla::POR_COLUMNAS,
+                  Particionado::porRangos("Cod", {10, 20}));
+  EXPECT_EQ(porRangos.particionado().cantParticiones(), 3);
+  for (int i = 0; i < 30; i++) {
+    Registro r({"Cod", "Carrera"}, {Dato(i), Dato("C" + to_string(i % 5))});
+    porHash.agregarRegistro(r);
+    porRangos.agregarRegistro(r);
+  }
+  EXPECT_EQ(porRangos.ids(0).size(), 10);
+  EXPECT_EQ(porRangos.ids(1).front(), 10);
+  EXPECT_EQ(porRangos.ids(2).back(), 29);
+
+  // Todos los registros de una carrera quedan en la misma partición
+  int p = porHash.particionado().particion(Dato("C3"));
+  int total = 0;
+  for (int i = 0; i < 4; i++) {
+    for (int id : porHash.ids(i)) {
+      EXPECT_EQ(porHash.particionado().particion(porHash.registro(id).dato("Carrera")), i);
+    }
+    total += porHash.ids(i).size();
+  }
+  EXPECT_EQ(total, 30);
+
+  // Modificar el campo de particionado mueve el registro de partición
+  porRangos.actualizarRegistros({3}, Registro({"Cod"}, {Dato(25)}));
+  EXPECT_EQ(porRangos.ids(0).size(), 9);
+  vector<int> ultima = porRangos.ids(2);
+  EXPECT_TRUE(is_sorted(ultima.begin(), ultima.end()));
+  EXPECT_EQ(ultima.front(), 3);
+
+  porRangos.borrarRegistros(porRangos.ids(1));
+  EXPECT_FALSE(porRangos.hayRegistros(1));
+  porRangos.compactar();
+  EXPECT_FALSE(porRangos.hayRegistros(1));
+  EXPECT_EQ(porRangos.ids(0).size() + porRangos.ids(2).size(), 20);
+  // Los registros de una carrera están entre los de su partición
+  vector<int> c3 = porHash.ids();
+  porHash.filtrar(c3, porHash.campoId("Carrera"), Dato("C3"), true);
+  vector<int> deP = porHash.ids(p);
+  EXPECT_EQ(c3.size(), 6);
+  EXPECT_TRUE(includes(deP.begin(), deP.end(), c3.begin(), c3.end()));
+}